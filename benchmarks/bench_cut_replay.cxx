@@ -0,0 +1,146 @@
+// bench_cut_replay.cxx
+//
+// Throughput of the cut replay over stored topology data: a data file of
+// synthetic 2e records is written, then the 2e channel cut is replayed over
+// it, and once more over the records reduced to their topology data bank.
+//
+// Usage: bench_cut_replay [number of records] [working directory]
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/things.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+// - Bayeux/dpp:
+#include <bayeux/dpp/output_module.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/topology_2e_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/reconstruction/cut_replay_driver.h>
+
+namespace {
+
+  const char * cuts_definitions =
+    "#@key_label   \"name\"\n"
+    "#@meta_label  \"type\"\n"
+    "[name=\"2e::has_classification\" type=\"snemo::cut::topology_data_cut\"]\n"
+    "mode.classification : boolean = true\n"
+    "classification.label : string = \"2e\"\n"
+    "[name=\"2e::good_internal_probability\" type=\"snemo::cut::tof_measurement_cut\"]\n"
+    "mode.range_internal_probability : boolean = true\n"
+    "range_internal_probability.mode : string = \"all\"\n"
+    "range_internal_probability.min : real as fraction = 1 %\n"
+    "[name=\"2e::topology_measurement\" type=\"snemo::cut::channel_cut\"]\n"
+    "cuts : string[1] = \"int_prob\"\n"
+    "int_prob.cut_label : string = \"2e::good_internal_probability\"\n"
+    "int_prob.measurement_label : string = \"tof_e1_e2\"\n"
+    "[name=\"2e::channel_cut\" type=\"cuts::multi_and_cut\"]\n"
+    "cuts : string[2] = \"2e::has_classification\" \"2e::topology_measurement\"\n";
+
+  void write_records(const std::string & filename_, size_t nrecords_)
+  {
+    dpp::output_module writer;
+    datatools::properties writer_config;
+    writer_config.store("logging.priority", "error");
+    writer_config.store("files.mode", "single");
+    writer_config.store("files.single.filename", filename_);
+    writer.initialize_standalone(writer_config);
+
+    for (size_t i = 0; i < nrecords_; i++) {
+      datatools::things a_record;
+      auto& TD = a_record.add<snemo::datamodel::topology_data>("TD");
+      TD.get_auxiliaries().store(snemo::datamodel::pid_utils::classification_label_key(), "2e");
+      snemo::datamodel::topology_data::handle_pattern a_pattern(new snemo::datamodel::topology_2e_pattern);
+      snemo::datamodel::tof_measurement * ptr_tof = new snemo::datamodel::tof_measurement;
+      ptr_tof->get_internal_probabilities().push_back((i % 100) * CLHEP::perCent);
+      ptr_tof->get_external_probabilities().push_back((100 - i % 100) * CLHEP::perCent);
+      a_pattern.grab().get_measurement_dictionary()["tof_e1_e2"].reset(ptr_tof);
+      TD.set_pattern_handle(a_pattern);
+
+      // Stands for the simulated/calibrated banks of a real record
+      auto& padding = a_record.add<datatools::properties>("PAD");
+      for (size_t j = 0; j < 64; j++) {
+        std::ostringstream key;
+        key << "hit_" << j;
+        padding.store_real(key.str(), i * 0.5 + j);
+      }
+      writer.process(a_record);
+    }
+    writer.reset();
+  }
+
+}
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    const size_t nrecords = argc_ > 1 ? std::atol(argv_[1]) : 100000;
+    const std::string workdir = argc_ > 2 ? argv_[2] : "/tmp";
+
+    const std::string cuts_file = workdir + "/bench_cut_replay_cuts.conf";
+    {
+      std::ofstream out(cuts_file.c_str());
+      out << cuts_definitions;
+    }
+    const std::string full_file = workdir + "/bench_cut_replay_full.brio";
+    const std::string reduced_file = workdir + "/bench_cut_replay_reduced.brio";
+    std::clog << "Writing " << nrecords << " records in '" << full_file << "'..." << std::endl;
+    write_records(full_file, nrecords);
+
+    datatools::properties CM_config;
+    CM_config.store("logging.priority", "error");
+    CM_config.store("factory.no_preload", false);
+    CM_config.store_paths("cuts.configuration_files", std::vector<std::string>(1, cuts_file));
+    cuts::cut_manager CM;
+    CM.initialize(CM_config);
+
+    {
+      snemo::reconstruction::cut_replay_driver CRD;
+      CRD.set_cut_manager(CM);
+      datatools::properties CRD_config;
+      CRD_config.store("cuts", std::vector<std::string>(1, "2e::channel_cut"));
+      CRD_config.store_path("output_filename", reduced_file);
+      CRD.initialize(CRD_config);
+      snemo::reconstruction::cut_replay_driver::replay_report report;
+      CRD.process(std::vector<std::string>(1, full_file), report);
+      std::cout << "Full records:" << std::endl;
+      report.print(std::cout, "  ");
+    }
+
+    {
+      snemo::reconstruction::cut_replay_driver CRD;
+      CRD.set_cut_manager(CM);
+      datatools::properties CRD_config;
+      CRD_config.store("cuts", std::vector<std::string>(1, "2e::channel_cut"));
+      CRD.initialize(CRD_config);
+      snemo::reconstruction::cut_replay_driver::replay_report report;
+      CRD.process(std::vector<std::string>(1, reduced_file), report);
+      std::cout << "Topology data only records:" << std::endl;
+      report.print(std::cout, "  ");
+    }
+
+    CM.reset();
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
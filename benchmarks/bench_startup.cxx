@@ -0,0 +1,137 @@
+// bench_startup.cxx
+//
+// Startup time of the topology module with the configuration of the 'ex02'
+// example. The service manager setup, which loads the cut service, the
+// module initialization and the first processed record, where the PID and
+// measurement drivers are set up, are timed separately, then compared with
+// a second record. Records are synthetic '2e1g' events, accepted by the
+// example classifications so that the whole processing runs.
+//
+// Usage: bench_startup [ex02 configuration directory] [working directory]
+
+// Standard library:
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+#include <bayeux/datatools/multi_properties.h>
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/service_manager.h>
+#include <bayeux/datatools/things.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_service.h>
+// - Bayeux/dpp:
+#include <bayeux/dpp/base_module.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/reconstruction/topology_module.h>
+#include <particle_track_fixtures.h>
+
+namespace {
+
+  double elapsed_ms(const std::chrono::steady_clock::time_point & start_)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+  /// Make a record holding a '2e1g' event
+  void make_record(datatools::things & record_)
+  {
+    record_.clear();
+    snemo::datamodel::particle_track_data & ptd = record_.add<snemo::datamodel::particle_track_data>("PTD");
+    ptd.add_particle(snemo::testing::make_handle(snemo::testing::make_electron(10 * CLHEP::cm, 0,
+                                                                               1.6 * CLHEP::ns, 1000 * CLHEP::keV)));
+    ptd.add_particle(snemo::testing::make_handle(snemo::testing::make_electron(-20 * CLHEP::cm, 3 * CLHEP::mm,
+                                                                               1.4 * CLHEP::ns, 500 * CLHEP::keV)));
+    ptd.add_particle(snemo::testing::make_handle(snemo::testing::make_gamma(30 * CLHEP::cm, 0,
+                                                                            2 * CLHEP::ns, 300 * CLHEP::keV)));
+  }
+
+  /// Return the classification of a processed record
+  std::string get_classification(const datatools::things & record_)
+  {
+    if (! record_.has("TD")) return "";
+    const snemo::datamodel::topology_data & td = record_.get<snemo::datamodel::topology_data>("TD");
+    const std::string & a_key = snemo::datamodel::pid_utils::classification_label_key();
+    return td.get_auxiliaries().has_key(a_key) ? td.get_auxiliaries().fetch_string(a_key) : "";
+  }
+
+}
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    const std::string configdir = argc_ > 1 ? argv_[1] : "resources/examples/ex02/config";
+    const std::string workdir = argc_ > 2 ? argv_[2] : "/tmp";
+
+    // The cut manager configuration of the example, without the path resolution of flreconstruct
+    const std::string cut_manager_file = workdir + "/bench_startup_cut_manager.conf";
+    {
+      std::ofstream out(cut_manager_file.c_str());
+      out << "logging.priority : string = \"error\"\n"
+          << "factory.no_preload : boolean = false\n"
+          << "cuts.configuration_files : string[2] as path = "
+          << "\"" << configdir << "/pid_cuts.conf\" "
+          << "\"" << configdir << "/channel_cuts.conf\"\n";
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    datatools::service_manager SM;
+    datatools::properties cut_service_config;
+    cut_service_config.store("logging.priority", "error");
+    cut_service_config.store_path("cut_manager.config", cut_manager_file);
+    SM.load("cuts", "cuts::cut_service", cut_service_config);
+    SM.initialize();
+    const double services_time = elapsed_ms(start);
+
+    datatools::multi_properties modules("name", "type");
+    modules.read(configdir + "/pipeline_modules.conf");
+    const datatools::properties & module_config = modules.get("topology_identifier").get_properties();
+
+    start = std::chrono::steady_clock::now();
+    snemo::reconstruction::topology_module TM;
+    dpp::module_handle_dict_type module_dict;
+    TM.initialize(module_config, SM, module_dict);
+    const double initialization_time = elapsed_ms(start);
+
+    datatools::things a_record;
+    make_record(a_record);
+    start = std::chrono::steady_clock::now();
+    TM.process(a_record);
+    const double first_event_time = elapsed_ms(start);
+    const std::string first_classification = get_classification(a_record);
+    DT_THROW_IF(first_classification != "2e1g", std::logic_error,
+                "Record classified as '" << first_classification << "' instead of '2e1g' !");
+
+    make_record(a_record);
+    start = std::chrono::steady_clock::now();
+    TM.process(a_record);
+    const double next_event_time = elapsed_ms(start);
+
+    std::cout << "Services (cut service) : " << services_time << " ms" << std::endl;
+    std::cout << "Module initialization  : " << initialization_time << " ms" << std::endl;
+    std::cout << "First event            : " << first_event_time << " ms" << std::endl;
+    std::cout << "Next event             : " << next_event_time << " ms" << std::endl;
+
+    TM.reset();
+    SM.reset();
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,188 @@
+// bench_vertex_categories.cxx
+//
+// Cost of the vertex lookups of the TOF, vertex and angle measurements on
+// synthetic 2eNg events. Every event is measured once through the plain
+// driver interfaces, which decode the vertex types of the particles at every
+// call, then through the summary interfaces fed by a single calorimeter and
+// vertex summary pass per event.
+//
+// Usage: bench_vertex_categories [number of events] [number of gammas]
+
+// Standard library:
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+#include <falaise/snemo/reconstruction/vertex_driver.h>
+#include <falaise/snemo/reconstruction/angle_driver.h>
+#include <falaise/snemo/reconstruction/energy_driver.h>
+#include <falaise/snemo/reconstruction/vertex_summary.h>
+#include <particle_track_fixtures.h>
+
+namespace {
+
+  typedef std::vector<snemo::datamodel::particle_track> event_type;
+
+  /// Make an electron emitted from the source foil, with its calorimeter vertex
+  snemo::datamodel::particle_track make_electron(double y_, double z_, double time_, double energy_)
+  {
+    snemo::datamodel::particle_track electron = snemo::testing::make_electron(y_, z_, time_, energy_);
+    snemo::testing::add_vertex(electron, geomtools::vector_3d(45 * CLHEP::cm, y_, z_),
+                               snemo::datamodel::particle_track::vertex_on_main_calorimeter_label());
+    return electron;
+  }
+
+  /// Make a gamma hitting a few calorimeter blocks
+  snemo::datamodel::particle_track make_gamma(double y_, double z_, double time_, double energy_)
+  {
+    snemo::datamodel::particle_track gamma = snemo::testing::make_gamma(y_, z_, time_, energy_);
+    snemo::testing::add_vertex(gamma, geomtools::vector_3d(-45 * CLHEP::cm, y_ + 25 * CLHEP::cm, z_),
+                               snemo::datamodel::particle_track::vertex_on_main_calorimeter_label());
+    snemo::testing::add_vertex(gamma, geomtools::vector_3d(0, y_ + 50 * CLHEP::cm, 150 * CLHEP::cm),
+                               snemo::datamodel::particle_track::vertex_on_gamma_veto_label());
+    snemo::testing::add_calorimeter_hit(gamma, time_ + 0.5 * CLHEP::ns, 0.5 * energy_);
+    snemo::testing::add_calorimeter_hit(gamma, time_ + 1.5 * CLHEP::ns, 0.2 * energy_);
+    return gamma;
+  }
+
+  /// Sum of the valid results, compared between both interfaces
+  void accumulate(double & checksum_, double value_)
+  {
+    if (datatools::is_valid(value_)) checksum_ += value_;
+  }
+
+  /// Measurements of an event through the plain driver interfaces
+  double measure_plain(const snemo::reconstruction::tof_driver & TOFD_,
+                       const snemo::reconstruction::vertex_driver & VD_,
+                       const snemo::reconstruction::angle_driver & AMD_,
+                       const event_type & event_)
+  {
+    double checksum = 0;
+    snemo::datamodel::tof_measurement a_tof;
+    for (size_t ig = 2; ig < event_.size(); ig++) {
+      for (size_t ie = 0; ie < 2; ie++) {
+        a_tof = snemo::datamodel::tof_measurement();
+        TOFD_.process(event_[ie], event_[ig], a_tof);
+        checksum += a_tof.get_internal_probabilities().size();
+      }
+    }
+    snemo::datamodel::vertex_measurement a_vertex;
+    VD_.process(event_[0], event_[1], a_vertex);
+    accumulate(checksum, a_vertex.get_probability());
+    for (const auto& a_particle : event_) {
+      accumulate(checksum, AMD_.get_direction(a_particle).z());
+    }
+    return checksum;
+  }
+
+  /// Measurements of an event through the summary interfaces
+  double measure_summary(const snemo::reconstruction::tof_driver & TOFD_,
+                         const snemo::reconstruction::vertex_driver & VD_,
+                         const snemo::reconstruction::angle_driver & AMD_,
+                         const event_type & event_)
+  {
+    std::vector<const snemo::datamodel::particle_track *> particles;
+    for (const auto& a_particle : event_) {
+      particles.push_back(&a_particle);
+    }
+    snemo::reconstruction::calorimeter_summary calorimeters;
+    calorimeters.fill(particles);
+    snemo::reconstruction::vertex_summary vertices;
+    vertices.fill(particles);
+
+    double checksum = 0;
+    snemo::datamodel::tof_measurement a_tof;
+    for (size_t ig = 2; ig < event_.size(); ig++) {
+      for (size_t ie = 0; ie < 2; ie++) {
+        a_tof = snemo::datamodel::tof_measurement();
+        TOFD_.process(event_[ie], event_[ig], calorimeters, vertices, ie, ig, a_tof);
+        checksum += a_tof.get_internal_probabilities().size();
+      }
+    }
+    snemo::datamodel::vertex_measurement a_vertex;
+    VD_.process(event_[0], event_[1], vertices, 0, 1, a_vertex);
+    accumulate(checksum, a_vertex.get_probability());
+    for (size_t ipt = 0; ipt < event_.size(); ipt++) {
+      accumulate(checksum, AMD_.get_direction(event_[ipt], vertices, ipt).z());
+    }
+    return checksum;
+  }
+
+}
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    const size_t nevents = argc_ > 1 ? std::atol(argv_[1]) : 10000;
+    const size_t ngammas = argc_ > 2 ? std::atol(argv_[2]) : 4;
+
+    std::vector<event_type> events;
+    for (size_t i = 0; i < nevents; i++) {
+      event_type an_event;
+      const double z = (i % 100) * CLHEP::mm;
+      an_event.push_back(make_electron(10 * CLHEP::cm, z, 1.6 * CLHEP::ns, 1000 * CLHEP::keV));
+      an_event.push_back(make_electron(-20 * CLHEP::cm, z + 3 * CLHEP::mm, 1.4 * CLHEP::ns, 500 * CLHEP::keV));
+      for (size_t ig = 0; ig < ngammas; ig++) {
+        an_event.push_back(make_gamma(ig * 30 * CLHEP::cm, z, (2 + 0.1 * ig) * CLHEP::ns, 300 * CLHEP::keV));
+      }
+      events.push_back(an_event);
+    }
+
+    snemo::reconstruction::tof_driver TOFD;
+    TOFD.initialize(datatools::properties());
+    snemo::reconstruction::vertex_driver VD;
+    VD.initialize(datatools::properties());
+    snemo::reconstruction::angle_driver AMD;
+    AMD.initialize(datatools::properties());
+
+    typedef std::chrono::steady_clock clock_type;
+    double checksum_plain = 0;
+    const clock_type::time_point start_plain = clock_type::now();
+    for (const auto& an_event : events) {
+      checksum_plain += measure_plain(TOFD, VD, AMD, an_event);
+    }
+    const double seconds_plain = std::chrono::duration<double>(clock_type::now() - start_plain).count();
+
+    double checksum_summary = 0;
+    const clock_type::time_point start_summary = clock_type::now();
+    for (const auto& an_event : events) {
+      checksum_summary += measure_summary(TOFD, VD, AMD, an_event);
+    }
+    const double seconds_summary = std::chrono::duration<double>(clock_type::now() - start_summary).count();
+
+    std::cout << "Events           : " << nevents << " (2e" << ngammas << "g)" << std::endl;
+    std::cout << "Plain drivers    : " << 1e6 * seconds_plain / nevents << " us/event" << std::endl;
+    std::cout << "Event summaries  : " << 1e6 * seconds_summary / nevents << " us/event" << std::endl;
+    std::cout << "Saving           : "
+              << (seconds_plain > 0 ? 100 * (seconds_plain - seconds_summary) / seconds_plain : 0)
+              << " %" << std::endl;
+    DT_THROW_IF(! (checksum_plain == checksum_summary), std::logic_error,
+                "Measurements differ between the plain and summary interfaces !");
+
+    TOFD.reset();
+    VD.reset();
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
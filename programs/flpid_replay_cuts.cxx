@@ -0,0 +1,109 @@
+// flpid_replay_cuts.cxx
+//
+// Replay channel/measurement cuts over event records written by a
+// previous Falaise pipeline, without running the reconstruction again.
+// Threshold scans of the measurement cuts can be evaluated in the same
+// pass (see the 'scans' property of the cut replay driver).
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Boost:
+#include <boost/program_options.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/utils.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/cut_replay_driver.h>
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    namespace po = boost::program_options;
+    std::string cut_manager_config;
+    std::vector<std::string> cut_names;
+    std::string scan_config;
+    std::vector<std::string> input_files;
+    std::string output_file;
+    std::string td_label = "TD";
+    std::string logging = "warning";
+
+    po::options_description opts("Allowed options");
+    opts.add_options()
+      ("help,h", "print this help message")
+      ("cut-manager-config,c", po::value<std::string>(&cut_manager_config)->required(),
+       "cut manager configuration file (e.g. ex02 'cut_manager.conf')")
+      ("cut,x", po::value<std::vector<std::string> >(&cut_names),
+       "name of a cut to replay (repeatable)")
+      ("scan-config,s", po::value<std::string>(&scan_config),
+       "configuration file of the threshold scans ('scans' list and 'scan.<name>.' properties)")
+      ("input-file,i", po::value<std::vector<std::string> >(&input_files)->required(),
+       "data file to replay (repeatable)")
+      ("output-file,o", po::value<std::string>(&output_file),
+       "data file to store the records reduced to their topology data bank")
+      ("TD-label", po::value<std::string>(&td_label),
+       "label of the topology data bank")
+      ("logging-priority,P", po::value<std::string>(&logging),
+       "logging priority")
+      ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc_, argv_, opts), vm);
+    if (vm.count("help")) {
+      std::cout << "Usage: flpid_replay_cuts [options]" << std::endl << opts << std::endl;
+      return error_code;
+    }
+    po::notify(vm);
+    DT_THROW_IF(cut_names.empty() && scan_config.empty(), std::logic_error,
+                "Missing cuts to replay or threshold scans !");
+
+    // Cut manager :
+    datatools::fetch_path_with_env(cut_manager_config);
+    datatools::properties cut_manager_setup;
+    datatools::properties::read_config(cut_manager_config, cut_manager_setup);
+    cuts::cut_manager CM;
+    CM.initialize(cut_manager_setup);
+
+    // Replay driver :
+    snemo::reconstruction::cut_replay_driver CRD;
+    CRD.set_cut_manager(CM);
+    datatools::properties CRD_config;
+    CRD_config.store("logging.priority", logging);
+    if (! cut_names.empty()) {
+      CRD_config.store("cuts", cut_names);
+    }
+    if (! scan_config.empty()) {
+      datatools::fetch_path_with_env(scan_config);
+      datatools::properties scan_setup;
+      datatools::properties::read_config(scan_config, scan_setup);
+      scan_setup.export_all(CRD_config);
+    }
+    CRD_config.store("TD_label", td_label);
+    if (! output_file.empty()) {
+      CRD_config.store_path("output_filename", output_file);
+    }
+    CRD.initialize(CRD_config);
+
+    snemo::reconstruction::cut_replay_driver::replay_report report;
+    CRD.process(input_files, report);
+    report.print(std::cout);
+
+    CRD.reset();
+    CM.reset();
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,254 @@
+// flpid_replay_topology.cxx
+//
+// Replay the inputs captured by the topology module ('capture.filename')
+// through the particle identification and topology drivers, outside of any
+// pipeline. All the records are loaded first so that the timed loop only
+// runs the drivers, which makes it suitable for perf or valgrind sessions.
+// With several workers, the PID driver runs first over all the records and
+// the topology driver then processes them with the work-stealing scheduler,
+// which reports the utilization of every worker. With a pipeline, the PID
+// of an event overlaps the topology of the previous ones on another thread.
+
+// Standard library:
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/io_factory.h>
+#include <bayeux/datatools/multi_properties.h>
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/utils.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/reconstruction/particle_identification_driver.h>
+#include <falaise/snemo/reconstruction/topology_driver.h>
+#include <falaise/snemo/reconstruction/topology_scheduler.h>
+#include <falaise/snemo/reconstruction/topology_pipeline.h>
+
+namespace {
+
+  /// Processing cost of one classification
+  struct classification_cost {
+    classification_cost() : events(0), seconds(0) {}
+    size_t events;
+    double seconds;
+  };
+
+}
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    namespace po = boost::program_options;
+    std::string capture_file;
+    size_t npasses = 1;
+    size_t nworkers = 1;
+    size_t pipeline_capacity = 0;
+    std::string logging = "warning";
+
+    po::options_description opts("Allowed options");
+    opts.add_options()
+      ("help,h", "print this help message")
+      ("input-file,i", po::value<std::string>(&capture_file)->required(),
+       "capture file written by the topology module")
+      ("passes,n", po::value<size_t>(&npasses),
+       "number of passes over the captured records")
+      ("workers,w", po::value<size_t>(&nworkers),
+       "number of workers processing the topologies (0 for the hardware concurrency)")
+      ("pipeline,p", po::value<size_t>(&pipeline_capacity),
+       "pipeline the PID and topology drivers, with at most this number of events handed off")
+      ("logging-priority,P", po::value<std::string>(&logging),
+       "logging priority of the cut manager")
+      ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc_, argv_, opts), vm);
+    if (vm.count("help")) {
+      std::cout << "Usage: flpid_replay_topology [options]" << std::endl << opts << std::endl;
+      return error_code;
+    }
+    po::notify(vm);
+    DT_THROW_IF(pipeline_capacity > 0 && nworkers != 1, std::logic_error,
+                "The pipeline runs the topology driver on a single worker !");
+    datatools::fetch_path_with_env(capture_file);
+
+    // Captured configuration and records :
+    datatools::properties module_config;
+    datatools::multi_properties cuts_config("name", "type");
+    std::vector<snemo::datamodel::particle_track_data> records;
+    {
+      datatools::data_reader reader(capture_file, datatools::using_multiple_archives);
+      DT_THROW_IF(! reader.has_record_tag() || ! reader.record_tag_is(datatools::properties::SERIAL_TAG),
+                  std::runtime_error, "File '" << capture_file << "' is not a topology capture !");
+      reader.load(module_config);
+      DT_THROW_IF(! reader.has_record_tag() || ! reader.record_tag_is(datatools::multi_properties::SERIAL_TAG),
+                  std::runtime_error, "File '" << capture_file << "' has no cut definitions !");
+      reader.load(cuts_config);
+      while (reader.has_record_tag()) {
+        DT_THROW_IF(! reader.record_tag_is(snemo::datamodel::particle_track_data::SERIAL_TAG),
+                    std::runtime_error, "Unexpected record in '" << capture_file << "' !");
+        records.push_back(snemo::datamodel::particle_track_data());
+        reader.load(records.back());
+      }
+    }
+    std::clog << "Loaded " << records.size() << " records from '" << capture_file << "'" << std::endl;
+
+    // Cut manager from the captured definitions :
+    const boost::filesystem::path cuts_file
+      = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("flpid_cuts_%%%%-%%%%.conf");
+    cuts_config.write(cuts_file.string());
+    datatools::properties cut_manager_setup;
+    cut_manager_setup.store("logging.priority", logging);
+    cut_manager_setup.store("factory.no_preload", false);
+    cut_manager_setup.store_paths("cuts.configuration_files", std::vector<std::string>(1, cuts_file.string()));
+    cuts::cut_manager CM;
+    CM.initialize(cut_manager_setup);
+    boost::filesystem::remove(cuts_file);
+
+    // Drivers :
+    snemo::reconstruction::particle_identification_driver PID;
+    PID.set_cut_manager(CM);
+    datatools::properties PID_config;
+    module_config.export_and_rename_starting_with(PID_config,
+                                                  snemo::reconstruction::particle_identification_driver::get_id() + ".", "");
+    PID.initialize(PID_config);
+    snemo::reconstruction::topology_driver TD;
+    TD.initialize(module_config);
+
+    if (pipeline_capacity > 0) {
+      // Pipelined replay : PID and topology stages overlap on two threads
+      snemo::reconstruction::topology_pipeline pipeline;
+      pipeline.set_capacity(pipeline_capacity);
+      std::vector<snemo::datamodel::particle_track_data> ptds;
+      std::vector<snemo::datamodel::topology_data> tds(records.size());
+      std::vector<snemo::datamodel::particle_track_data *> batch_ptds;
+      std::vector<snemo::datamodel::topology_data *> batch_tds;
+      for (size_t ipass = 0; ipass < npasses; ipass++) {
+        ptds = records;
+        batch_ptds.clear();
+        batch_tds.clear();
+        for (size_t i = 0; i < ptds.size(); i++) {
+          tds[i].reset();
+          batch_ptds.push_back(&ptds[i]);
+          batch_tds.push_back(&tds[i]);
+        }
+        pipeline.process(PID, TD, batch_ptds, batch_tds);
+      }
+      pipeline.get_statistics().print(std::cout);
+      TD.reset();
+      PID.reset();
+      CM.reset();
+      return error_code;
+    }
+
+    if (nworkers != 1) {
+      // Parallel replay : only the topology processing is scheduled over the workers
+      snemo::reconstruction::topology_scheduler scheduler;
+      scheduler.set_number_of_workers(nworkers);
+      std::vector<snemo::datamodel::particle_track_data> ptds;
+      std::vector<snemo::datamodel::topology_data> tds(records.size());
+      std::vector<const snemo::datamodel::particle_track_data *> batch_ptds;
+      std::vector<snemo::datamodel::topology_data *> batch_tds;
+      double pid_seconds = 0;
+      double topology_seconds = 0;
+      for (size_t ipass = 0; ipass < npasses; ipass++) {
+        ptds = records;
+        batch_ptds.clear();
+        batch_tds.clear();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ptds.size(); i++) {
+          PID.process(ptds[i]);
+          tds[i].reset();
+          batch_ptds.push_back(&ptds[i]);
+          batch_tds.push_back(&tds[i]);
+        }
+        pid_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        scheduler.process(TD, batch_ptds, batch_tds);
+        topology_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      }
+      const size_t total_events = npasses * records.size();
+      std::cout << "Events          : " << total_events << std::endl;
+      std::cout << "PID time        : " << pid_seconds << " s" << std::endl;
+      std::cout << "Topology time   : " << topology_seconds << " s" << std::endl;
+      std::cout << "Topology rate   : " << (topology_seconds > 0 ? total_events / topology_seconds : 0)
+                << " events/s" << std::endl;
+      std::cout << "Workers         : " << scheduler.get_reports().size() << std::endl;
+      scheduler.print_report(std::cout);
+      TD.reset();
+      PID.reset();
+      CM.reset();
+      return error_code;
+    }
+
+    // Timed replay, the PID labels being reset from the captured records every time :
+    std::map<std::string, classification_cost> costs;
+    double total_seconds = 0;
+    size_t total_events = 0;
+    snemo::datamodel::particle_track_data a_ptd;
+    snemo::datamodel::topology_data a_td;
+    for (size_t ipass = 0; ipass < npasses; ipass++) {
+      for (const auto& a_record : records) {
+        a_ptd = a_record;
+        a_td.reset();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        PID.process(a_ptd);
+        TD.process(a_ptd, a_td);
+        const double seconds
+          = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string a_classification;
+        const std::string & classification_key = snemo::datamodel::pid_utils::classification_label_key();
+        if (a_td.get_auxiliaries().has_key(classification_key)) {
+          a_classification = a_td.get_auxiliaries().fetch_string(classification_key);
+        }
+        classification_cost & a_cost = costs[a_classification];
+        a_cost.events++;
+        a_cost.seconds += seconds;
+        total_seconds += seconds;
+        total_events++;
+      }
+    }
+
+    std::cout << "Events          : " << total_events << std::endl;
+    std::cout << "Time            : " << total_seconds << " s" << std::endl;
+    std::cout << "Rate            : " << (total_seconds > 0 ? total_events / total_seconds : 0) << " events/s" << std::endl;
+    std::cout << std::setw(16) << std::left << "Classification"
+              << std::setw(12) << std::right << "Events"
+              << std::setw(16) << "Mean cost [us]"
+              << std::setw(12) << "Share [%]" << std::endl;
+    for (const auto& a_cost : costs) {
+      std::cout << std::setw(16) << std::left << (a_cost.first.empty() ? "(none)" : a_cost.first)
+                << std::setw(12) << std::right << a_cost.second.events
+                << std::setw(16) << 1e6 * a_cost.second.seconds / a_cost.second.events
+                << std::setw(12) << (total_seconds > 0 ? 100 * a_cost.second.seconds / total_seconds : 0)
+                << std::endl;
+    }
+
+    TD.reset();
+    PID.reset();
+    CM.reset();
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,90 @@
+// flpid_select.cxx
+//
+// Combine the selection bitmaps written by the topology module with
+// AND/OR/NOT queries and print the selected record numbers. Only the
+// bitmaps are read: the events are never loaded. Several selection files
+// are concatenated, numbering the records of each after the previous ones.
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Boost:
+#include <boost/program_options.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/selection_bitmap.h>
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    namespace po = boost::program_options;
+    std::vector<std::string> input_files;
+    std::string query;
+
+    po::options_description opts("Allowed options");
+    opts.add_options()
+      ("help,h", "print this help message")
+      ("input-file,i", po::value<std::vector<std::string> >(&input_files)->required(),
+       "selection file written by the topology module (repeatable)")
+      ("query,q", po::value<std::string>(&query),
+       "selection query, e.g. '2e & !rejected(e1_energy)' (list the selections if missing)")
+      ("count,c", "only print the number of selected records")
+      ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc_, argv_, opts), vm);
+    if (vm.count("help")) {
+      std::cout << "Usage: flpid_select [options]" << std::endl << opts << std::endl
+                << "Queries combine selection names, standing for the accepted records, with" << std::endl
+                << "the '&', '|' and '!' operators and parentheses. 'rejected(name)' and" << std::endl
+                << "'inapplicable(name)' stand for the other records, 'all' for every record." << std::endl;
+      return error_code;
+    }
+    po::notify(vm);
+
+    snemo::reconstruction::selection_bitmap_set selections;
+    for (auto& an_input_file : input_files) {
+      datatools::fetch_path_with_env(an_input_file);
+      snemo::reconstruction::selection_bitmap_set a_file_selections;
+      a_file_selections.load(an_input_file);
+      selections.append(a_file_selections);
+    }
+
+    if (query.empty()) {
+      std::clog << "Selections over " << selections.get_number_of_records() << " records :" << std::endl;
+      for (const auto& a_name : selections.get_names()) {
+        std::cout << a_name << " : " << selections.get_accepted(a_name).cardinality() << " accepted, "
+                  << selections.get_rejected(a_name).cardinality() << " rejected" << std::endl;
+      }
+      return error_code;
+    }
+
+    snemo::reconstruction::selection_bitmap result;
+    selections.evaluate(query, result);
+    std::clog << "Selected " << result.cardinality() << " records out of "
+              << selections.get_number_of_records() << std::endl;
+    if (vm.count("count")) {
+      std::cout << result.cardinality() << std::endl;
+    } else {
+      std::vector<uint64_t> records;
+      result.get_records(records);
+      for (const auto& a_record : records) {
+        std::cout << a_record << '\n';
+      }
+    }
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,113 @@
+// flpid_skim.cxx
+//
+// Extract the records of given classifications and/or channels from a brio
+// data file, using the classification index written by the topology module.
+// Only the selected records are read from the data file.
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Boost:
+#include <boost/program_options.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/things.h>
+#include <bayeux/datatools/utils.h>
+// - Bayeux/brio:
+#include <bayeux/brio/reader.h>
+// - Bayeux/dpp:
+#include <bayeux/dpp/output_module.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/classification_index.h>
+
+int main(int argc_, char ** argv_)
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    namespace po = boost::program_options;
+    std::string index_file;
+    std::string input_file;
+    std::string output_file;
+    std::vector<std::string> classifications;
+    std::vector<std::string> channels;
+
+    po::options_description opts("Allowed options");
+    opts.add_options()
+      ("help,h", "print this help message")
+      ("index-file,x", po::value<std::string>(&index_file)->required(),
+       "classification index written by the topology module")
+      ("input-file,i", po::value<std::string>(&input_file)->required(),
+       "brio data file the index refers to")
+      ("output-file,o", po::value<std::string>(&output_file),
+       "brio data file to store the selected records (count only if missing)")
+      ("classification,c", po::value<std::vector<std::string> >(&classifications),
+       "classification to select, e.g. '2e' (repeatable)")
+      ("channel,C", po::value<std::vector<std::string> >(&channels),
+       "channel cut to select (repeatable)")
+      ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc_, argv_, opts), vm);
+    if (vm.count("help")) {
+      std::cout << "Usage: flpid_skim [options]" << std::endl << opts << std::endl;
+      return error_code;
+    }
+    po::notify(vm);
+
+    datatools::fetch_path_with_env(index_file);
+    datatools::fetch_path_with_env(input_file);
+
+    // Select the records from the index only
+    snemo::reconstruction::classification_index_reader index;
+    index.open(index_file);
+    std::vector<uint32_t> packed_classifications;
+    for (const auto& a_classification : classifications) {
+      packed_classifications.push_back(snemo::reconstruction::pack_classification(a_classification));
+    }
+    uint32_t channel_mask = 0;
+    for (const auto& a_channel : channels) {
+      channel_mask |= index.get_channel_bit(a_channel);
+    }
+    std::vector<uint64_t> records;
+    index.select(packed_classifications, channel_mask, records);
+    std::clog << "Selected " << records.size() << " records out of " << index.size() << std::endl;
+    index.close();
+
+    if (! output_file.empty()) {
+      dpp::output_module writer;
+      datatools::properties writer_config;
+      writer_config.store("logging.priority", "error");
+      writer_config.store("files.mode", "single");
+      writer_config.store("files.single.filename", output_file);
+      writer.initialize_standalone(writer_config);
+
+      // Event records are stored in the 'ER' store of dpp brio files
+      const std::string event_record_store = "ER";
+      brio::reader reader(input_file);
+      DT_THROW_IF(! reader.has_store(event_record_store), std::runtime_error,
+                  "Data file '" << input_file << "' has no '" << event_record_store << "' store !");
+      const int64_t nentries = reader.get_number_of_entries(event_record_store);
+      datatools::things a_record;
+      for (const auto& a_record_number : records) {
+        DT_THROW_IF(int64_t(a_record_number) >= nentries, std::range_error,
+                    "Record #" << a_record_number << " is not in data file '" << input_file << "' !");
+        a_record.clear();
+        reader.load(a_record, event_record_store, a_record_number);
+        writer.process(a_record);
+      }
+      reader.close();
+      writer.reset();
+    }
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
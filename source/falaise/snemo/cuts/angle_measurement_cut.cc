@@ -6,12 +6,14 @@
 // Standard library:
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/properties.h>
 #include <datatools/things.h>
 #include <datatools/clhep_units.h>
+#include <datatools/utils.h>
 
 // SuperNEMO data models :
 #include <falaise/snemo/datamodels/angle_measurement.h>
@@ -176,6 +178,44 @@ namespace snemo {
       return cut_returned;
     }
 
+    void angle_measurement_cut::select(const double * angles_, size_t n_,
+                                       batch_selection & selection_) const
+    {
+      std::vector<uint8_t> has_angle(n_);
+      flag_valid(angles_, n_, has_angle.data());
+      std::vector<uint8_t> applicable(n_, 1);
+      std::vector<uint8_t> accepted(n_, 1);
+      if (is_mode_has_angle()) {
+        and_flags(has_angle.data(), n_, accepted.data());
+      }
+      if (is_mode_range_angle()) {
+        and_flags(has_angle.data(), n_, applicable.data());
+        and_in_range(angles_, n_, _angle_range_min_, _angle_range_max_, accepted.data());
+      }
+      selection_.reset(n_);
+      selection_.assign(applicable.data(), accepted.data());
+    }
+
+    void angle_measurement_cut::select(const measurement_batch_type & measurements_,
+                                       batch_selection & selection_) const
+    {
+      const size_t n = measurements_.size();
+      std::vector<double> angles(n, datatools::invalid_real());
+      std::vector<size_t> missing;
+      for (size_t i = 0; i < n; i++) {
+        auto a_angle_meas = dynamic_cast<const snemo::datamodel::angle_measurement *>(measurements_[i]);
+        if (a_angle_meas == nullptr) {
+          missing.push_back(i);
+          continue;
+        }
+        angles[i] = a_angle_meas->get_angle();
+      }
+      select(angles.data(), n, selection_);
+      for (auto i : missing) {
+        selection_.set_status(i, cuts::SELECTION_INAPPLICABLE);
+      }
+    }
+
   }  // end of namespace cut
 
 }  // end of namespace snemo
@@ -19,12 +19,15 @@
 // - Bayeux/cuts:
 #include <cuts/i_cut.h>
 
+// This project:
+#include <falaise/snemo/cuts/i_batch_measurement_cut.h>
+
 namespace snemo {
 
   namespace cut {
 
     /// \brief A cut performed on individual 'angle measurement'
-    class angle_measurement_cut : public cuts::i_cut
+    class angle_measurement_cut : public cuts::i_cut, public i_batch_measurement_cut
     {
     public:
 
@@ -63,6 +66,13 @@ namespace snemo {
       /// Reset
       virtual void reset();
 
+      /// Select a batch of angles, invalid when not measured
+      void select(const double * angles_, size_t n_, batch_selection & selection_) const;
+
+      /// Select a batch of angle measurements
+      virtual void select(const measurement_batch_type & measurements_,
+                          batch_selection & selection_) const;
+
     protected:
 
       /// Default values
@@ -0,0 +1,172 @@
+// falaise/snemo/cuts/batch_selection.cc
+
+// Ourselves:
+#include <falaise/snemo/cuts/batch_selection.h>
+
+// Standard library:
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+#include <bayeux/datatools/utils.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/i_cut.h>
+
+namespace snemo {
+
+  namespace cut {
+
+    const size_t batch_selection::WORD_SIZE;
+
+    batch_selection::batch_selection(size_t size_)
+    {
+      reset(size_);
+    }
+
+    void batch_selection::reset(size_t size_)
+    {
+      _size_ = size_;
+      const size_t nwords = (size_ + WORD_SIZE - 1) / WORD_SIZE;
+      _applicable_.assign(nwords, ~word_type(0));
+      _accepted_.assign(nwords, ~word_type(0));
+      if (nwords > 0 && size_ % WORD_SIZE != 0) {
+        // Keep the padding bits cleared so that words can be counted directly
+        const word_type last_mask = (word_type(1) << (size_ % WORD_SIZE)) - 1;
+        _applicable_.back() &= last_mask;
+        _accepted_.back() &= last_mask;
+      }
+    }
+
+    size_t batch_selection::size() const
+    {
+      return _size_;
+    }
+
+    int batch_selection::get_status(size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _size_, std::range_error, "Invalid event index " << index_ << " !");
+      const word_type a_bit = word_type(1) << (index_ % WORD_SIZE);
+      if (! (_applicable_[index_ / WORD_SIZE] & a_bit)) return cuts::SELECTION_INAPPLICABLE;
+      if (! (_accepted_[index_ / WORD_SIZE] & a_bit)) return cuts::SELECTION_REJECTED;
+      return cuts::SELECTION_ACCEPTED;
+    }
+
+    void batch_selection::set_status(size_t index_, int status_)
+    {
+      DT_THROW_IF(index_ >= _size_, std::range_error, "Invalid event index " << index_ << " !");
+      const word_type a_bit = word_type(1) << (index_ % WORD_SIZE);
+      word_type & applicable = _applicable_[index_ / WORD_SIZE];
+      word_type & accepted = _accepted_[index_ / WORD_SIZE];
+      applicable &= ~a_bit;
+      accepted &= ~a_bit;
+      if (status_ == cuts::SELECTION_ACCEPTED) {
+        applicable |= a_bit;
+        accepted |= a_bit;
+      } else if (status_ == cuts::SELECTION_REJECTED) {
+        applicable |= a_bit;
+      }
+    }
+
+    bool batch_selection::is_accepted(size_t index_) const
+    {
+      return get_status(index_) == cuts::SELECTION_ACCEPTED;
+    }
+
+    size_t batch_selection::count(int status_) const
+    {
+      size_t n = 0;
+      for (size_t iw = 0; iw < _accepted_.size(); iw++) {
+        word_type a_word = 0;
+        if (status_ == cuts::SELECTION_ACCEPTED) {
+          a_word = _accepted_[iw];
+        } else if (status_ == cuts::SELECTION_REJECTED) {
+          a_word = _applicable_[iw] & ~_accepted_[iw];
+        } else {
+          a_word = ~_applicable_[iw];
+          if (iw + 1 == _accepted_.size() && _size_ % WORD_SIZE != 0) {
+            a_word &= (word_type(1) << (_size_ % WORD_SIZE)) - 1;
+          }
+        }
+        for (; a_word != 0; n++) a_word &= a_word - 1;
+      }
+      return n;
+    }
+
+    void batch_selection::assign(const uint8_t * applicable_, const uint8_t * accepted_)
+    {
+      for (size_t iw = 0; iw < _accepted_.size(); iw++) {
+        const size_t first = iw * WORD_SIZE;
+        const size_t nbits = std::min(WORD_SIZE, _size_ - first);
+        word_type applicable = 0;
+        word_type accepted = 0;
+        for (size_t ib = 0; ib < nbits; ib++) {
+          const word_type is_applicable = applicable_[first + ib] != 0;
+          applicable |= is_applicable << ib;
+          accepted |= (is_applicable & (accepted_[first + ib] != 0)) << ib;
+        }
+        _applicable_[iw] = applicable;
+        _accepted_[iw] = accepted;
+      }
+    }
+
+    void batch_selection::chain(const batch_selection & next_)
+    {
+      DT_THROW_IF(next_._size_ != _size_, std::logic_error,
+                  "Batch sizes differ (" << _size_ << " != " << next_._size_ << ") !");
+      for (size_t iw = 0; iw < _accepted_.size(); iw++) {
+        const word_type accepted = _accepted_[iw];
+        _applicable_[iw] = (_applicable_[iw] & ~accepted) | (accepted & next_._applicable_[iw]);
+        _accepted_[iw] = accepted & next_._accepted_[iw];
+      }
+    }
+
+    const std::vector<batch_selection::word_type> & batch_selection::get_applicable_words() const
+    {
+      return _applicable_;
+    }
+
+    const std::vector<batch_selection::word_type> & batch_selection::get_accepted_words() const
+    {
+      return _accepted_;
+    }
+
+    // The kernels below are written without branches so that the compiler
+    // can vectorize them with packed comparisons.
+
+    void flag_valid(const double * values_, size_t n_, uint8_t * flags_)
+    {
+      for (size_t i = 0; i < n_; i++) {
+        flags_[i] = values_[i] == values_[i];
+      }
+    }
+
+    void and_in_range(const double * values_, size_t n_, double min_, double max_, uint8_t * flags_)
+    {
+      const double lower = datatools::is_valid(min_) ? min_ : -std::numeric_limits<double>::infinity();
+      const double upper = datatools::is_valid(max_) ? max_ : +std::numeric_limits<double>::infinity();
+      for (size_t i = 0; i < n_; i++) {
+        flags_[i] &= (values_[i] >= lower) & (values_[i] <= upper);
+      }
+    }
+
+    void and_flags(const uint8_t * others_, size_t n_, uint8_t * flags_)
+    {
+      for (size_t i = 0; i < n_; i++) {
+        flags_[i] &= others_[i];
+      }
+    }
+
+  } // end of namespace cut
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
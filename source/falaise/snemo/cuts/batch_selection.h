@@ -0,0 +1,105 @@
+/// \file falaise/snemo/cuts/batch_selection.h
+/*
+ * Description:
+ *
+ *   Selection status of a batch of events, stored as bitmasks, and the
+ *   range check kernels used by the batch measurement cuts
+ */
+
+#ifndef FALAISE_SNEMO_CUT_BATCH_SELECTION_H
+#define FALAISE_SNEMO_CUT_BATCH_SELECTION_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace snemo {
+
+  namespace cut {
+
+    /// \brief Selection status of a batch of events
+    ///
+    /// Every event of the batch holds one of the 'cuts::SELECTION_XXX'
+    /// statuses, stored in two bitmasks: the 'applicable' bit is set for
+    /// accepted and rejected events, the 'accepted' bit for accepted events
+    /// only. A fresh batch has all its events accepted.
+    class batch_selection
+    {
+    public:
+
+      /// Type of the bitmask words
+      typedef uint64_t word_type;
+
+      /// Number of events per word
+      static const size_t WORD_SIZE = 64;
+
+      /// Constructor
+      batch_selection(size_t size_ = 0);
+
+      /// Resize the batch and accept all its events
+      void reset(size_t size_);
+
+      /// Return the number of events
+      size_t size() const;
+
+      /// Return the status of an event
+      int get_status(size_t index_) const;
+
+      /// Set the status of an event
+      void set_status(size_t index_, int status_);
+
+      /// Check if an event is accepted
+      bool is_accepted(size_t index_) const;
+
+      /// Return the number of events with a given status
+      size_t count(int status_) const;
+
+      /// Set the statuses from per-event applicability and acceptance flags
+      ///
+      /// Acceptance flags of inapplicable events are ignored.
+      void assign(const uint8_t * applicable_, const uint8_t * accepted_);
+
+      /// Combine with the statuses of a following cut
+      ///
+      /// Accepted events take their status from 'next_', rejected and
+      /// inapplicable events keep theirs.
+      void chain(const batch_selection & next_);
+
+      /// Return the applicability bitmask
+      const std::vector<word_type> & get_applicable_words() const;
+
+      /// Return the acceptance bitmask
+      const std::vector<word_type> & get_accepted_words() const;
+
+    private:
+
+      size_t _size_;                        //!< Number of events
+      std::vector<word_type> _applicable_;  //!< Applicability bits
+      std::vector<word_type> _accepted_;    //!< Acceptance bits
+    };
+
+    /// Set 'flags_[i]' to 1 if 'values_[i]' is valid, to 0 otherwise
+    void flag_valid(const double * values_, size_t n_, uint8_t * flags_);
+
+    /// Clear 'flags_[i]' if 'values_[i]' lies outside [min_, max_]
+    ///
+    /// Invalid bounds are ignored, invalid values are out of range.
+    void and_in_range(const double * values_, size_t n_, double min_, double max_, uint8_t * flags_);
+
+    /// Clear 'flags_[i]' if 'others_[i]' is not set
+    void and_flags(const uint8_t * others_, size_t n_, uint8_t * flags_);
+
+  } // end of namespace cut
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_CUT_BATCH_SELECTION_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
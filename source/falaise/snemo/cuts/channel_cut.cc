@@ -16,6 +16,9 @@
 #include <falaise/snemo/datamodels/topology_data.h>
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
 
+// This project:
+#include <falaise/snemo/cuts/i_batch_measurement_cut.h>
+
 namespace snemo {
 
   namespace cut {
@@ -94,13 +97,26 @@ namespace snemo {
         return cuts::SELECTION_INAPPLICABLE;
       }
 
-      auto TD = ER.get<snemo::datamodel::topology_data>(_TD_label_);
+      const auto& TD = ER.get<snemo::datamodel::topology_data>(_TD_label_);
       if (! TD.has_pattern()) {
         DT_LOG_WARNING(get_logging_priority(), "Missing topology pattern !");
         return cuts::SELECTION_INAPPLICABLE;
       }
 
-      auto& a_pattern = TD.get_pattern();
+      // Results of the channel and of its measurement cuts are memoized
+      // within the topology data of the event, since channels are tried
+      // several times and share measurement cuts
+      int status = cuts::SELECTION_INAPPLICABLE;
+      if (! TD.find_cut_result(this, &ER, status)) {
+        status = _check_pattern_(TD);
+        TD.store_cut_result(this, &ER, status);
+      }
+      return status;
+    }
+
+    int channel_cut::_check_pattern_(const snemo::datamodel::topology_data & TD_)
+    {
+      auto& a_pattern = TD_.get_pattern();
 
       // Loop over cuts
       for (auto& icut : _cuts_) {
@@ -110,8 +126,13 @@ namespace snemo {
           return cuts::SELECTION_INAPPLICABLE;
         }
         auto& a_cut = icut.second.grab();
-        a_cut.set_user_data(a_pattern.get_measurement(a_meas_label));
-        const int status = a_cut.process();
+        const snemo::datamodel::base_topology_measurement & a_measurement = a_pattern.get_measurement(a_meas_label);
+        int status = cuts::SELECTION_INAPPLICABLE;
+        if (! TD_.find_cut_result(&a_cut, &a_measurement, status)) {
+          a_cut.set_user_data(a_measurement);
+          status = a_cut.process();
+          TD_.store_cut_result(&a_cut, &a_measurement, status);
+        }
         if (status == cuts::SELECTION_REJECTED) {
           return cuts::SELECTION_REJECTED;
         } else if (status == cuts::SELECTION_INAPPLICABLE) {
@@ -124,6 +145,66 @@ namespace snemo {
       return cuts::SELECTION_ACCEPTED;
     }
 
+    void channel_cut::select(const pattern_batch_type & patterns_, batch_selection & selection_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Cut '" << get_name() << "' is not initialized !");
+
+      const size_t n = patterns_.size();
+      selection_.reset(n);
+      for (size_t i = 0; i < n; i++) {
+        if (patterns_[i] == nullptr) {
+          selection_.set_status(i, cuts::SELECTION_INAPPLICABLE);
+        }
+      }
+
+      // Loop over cuts, each one only deciding for the events accepted so far
+      i_batch_measurement_cut::measurement_batch_type measurements(n);
+      batch_selection a_selection;
+      for (auto& icut : _cuts_) {
+        if (selection_.count(cuts::SELECTION_ACCEPTED) == 0) break;
+        const std::string & a_meas_label = icut.first;
+        for (size_t i = 0; i < n; i++) {
+          measurements[i] = nullptr;
+          if (selection_.is_accepted(i)) {
+            measurements[i] = patterns_[i]->find_measurement(a_meas_label);
+          }
+        }
+
+        auto& a_cut = icut.second.grab();
+        const i_batch_measurement_cut * a_batch_cut = dynamic_cast<const i_batch_measurement_cut *>(&a_cut);
+        if (a_batch_cut != nullptr) {
+          a_batch_cut->select(measurements, a_selection);
+        } else {
+          a_selection.reset(n);
+          for (size_t i = 0; i < n; i++) {
+            if (measurements[i] == nullptr) {
+              a_selection.set_status(i, cuts::SELECTION_INAPPLICABLE);
+              continue;
+            }
+            a_cut.set_user_data(*measurements[i]);
+            a_selection.set_status(i, a_cut.process());
+          }
+        }
+        selection_.chain(a_selection);
+      }
+    }
+
+    void channel_cut::select_records(const std::vector<const datatools::things *> & records_,
+                                     batch_selection & selection_)
+    {
+      pattern_batch_type patterns(records_.size(), nullptr);
+      for (size_t i = 0; i < records_.size(); i++) {
+        const datatools::things * ER = records_[i];
+        if (ER == nullptr || ! ER->has(_TD_label_)) continue;
+        const auto& TD = ER->get<snemo::datamodel::topology_data>(_TD_label_);
+        if (TD.has_pattern()) {
+          patterns[i] = &TD.get_pattern();
+        }
+      }
+      select(patterns, selection_);
+    }
+
   }  // end of namespace cut
 
 }  // end of namespace snemo
@@ -145,7 +226,12 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::cut::channel_cut, ocd_)
       .set_traits(datatools::TYPE_STRING,
                   datatools::configuration_property_description::ARRAY)
       .set_mandatory(true)
-      .set_long_description("The list of all cuts' to be combined with a logical AND.")
+      .set_long_description("The list of all cuts' to be combined with a logical AND.         \n"
+                            "Results are memoized within the topology data of each event, so \n"
+                            "a measurement cut shared by several channels, or already applied \n"
+                            "to the same measurement, is processed once per event: its        \n"
+                            "accepted and rejected counters count these evaluations, not the  \n"
+                            "decisions of every channel.                                      \n")
       .add_example("Combine 2 cuts: ::                               \n"
                    "                                                 \n"
                    "    cuts : string[2] = \"int_prob\" \"ext_prob\" \n"
@@ -31,12 +31,28 @@
 #ifndef FALAISE_SNEMO_CUT_CHANNEL_CUT_H
 #define FALAISE_SNEMO_CUT_CHANNEL_CUT_H 1
 
+// Standard library:
+#include <string>
+#include <vector>
+
 // Third party:
 // - Bayeux/cuts
 #include <bayeux/cuts/i_cut.h>
 
+// This project:
+#include <falaise/snemo/cuts/batch_selection.h>
+
+namespace datatools {
+  class things;
+}
+
 namespace snemo {
 
+  namespace datamodel {
+    class base_topology_pattern;
+    class topology_data;
+  }
+
   namespace cut {
 
     /// \brief A channel cut
@@ -57,6 +73,21 @@ namespace snemo {
       /// Reset
       virtual void reset();
 
+      /// Collection of topology patterns, one per event
+      typedef std::vector<const snemo::datamodel::base_topology_pattern *> pattern_batch_type;
+
+      /// Select a batch of topology patterns
+      ///
+      /// Cuts implementing 'i_batch_measurement_cut' select all the events at
+      /// once, other cuts are processed event by event. Events with a null
+      /// pattern are inapplicable. The counters of the channel cut are not
+      /// updated.
+      void select(const pattern_batch_type & patterns_, batch_selection & selection_);
+
+      /// Select a batch of event records from their topology data bank
+      void select_records(const std::vector<const datatools::things *> & records_,
+                          batch_selection & selection_);
+
     protected :
       /// Default values
       void _set_defaults();
@@ -64,6 +95,11 @@ namespace snemo {
       /// Selection
       virtual int _accept();
 
+    private:
+
+      /// Apply the measurement cuts to the topology pattern of an event
+      int _check_pattern_(const snemo::datamodel::topology_data & TD_);
+
     private:
 
       std::string _TD_label_; //!< Topology Data bank label
@@ -6,12 +6,14 @@
 // Standard library:
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/properties.h>
 #include <datatools/things.h>
 #include <datatools/clhep_units.h>
+#include <datatools/utils.h>
 
 // SuperNEMO data models :
 #include <falaise/snemo/datamodels/energy_measurement.h>
@@ -173,6 +175,44 @@ namespace snemo {
       return cut_returned;
     }
 
+    void energy_measurement_cut::select(const double * energies_, size_t n_,
+                                        batch_selection & selection_) const
+    {
+      std::vector<uint8_t> has_energy(n_);
+      flag_valid(energies_, n_, has_energy.data());
+      std::vector<uint8_t> applicable(n_, 1);
+      std::vector<uint8_t> accepted(n_, 1);
+      if (is_mode_has_energy()) {
+        and_flags(has_energy.data(), n_, accepted.data());
+      }
+      if (is_mode_range_energy()) {
+        and_flags(has_energy.data(), n_, applicable.data());
+        and_in_range(energies_, n_, _energy_range_min_, _energy_range_max_, accepted.data());
+      }
+      selection_.reset(n_);
+      selection_.assign(applicable.data(), accepted.data());
+    }
+
+    void energy_measurement_cut::select(const measurement_batch_type & measurements_,
+                                        batch_selection & selection_) const
+    {
+      const size_t n = measurements_.size();
+      std::vector<double> energies(n, datatools::invalid_real());
+      std::vector<size_t> missing;
+      for (size_t i = 0; i < n; i++) {
+        auto a_energy_meas = dynamic_cast<const snemo::datamodel::energy_measurement *>(measurements_[i]);
+        if (a_energy_meas == nullptr) {
+          missing.push_back(i);
+          continue;
+        }
+        energies[i] = a_energy_meas->get_energy();
+      }
+      select(energies.data(), n, selection_);
+      for (auto i : missing) {
+        selection_.set_status(i, cuts::SELECTION_INAPPLICABLE);
+      }
+    }
+
   }  // end of namespace cut
 
 }  // end of namespace snemo
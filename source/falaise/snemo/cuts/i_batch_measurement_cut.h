@@ -0,0 +1,59 @@
+/// \file falaise/snemo/cuts/i_batch_measurement_cut.h
+/*
+ * Description:
+ *
+ *   Interface of the measurement cuts able to select a batch of events
+ */
+
+#ifndef FALAISE_SNEMO_CUT_I_BATCH_MEASUREMENT_CUT_H
+#define FALAISE_SNEMO_CUT_I_BATCH_MEASUREMENT_CUT_H 1
+
+// Standard library:
+#include <vector>
+
+// This project:
+#include <falaise/snemo/cuts/batch_selection.h>
+
+namespace snemo {
+
+  namespace datamodel {
+    class base_topology_measurement;
+  }
+
+  namespace cut {
+
+    /// \brief Interface of the measurement cuts able to select a batch of events
+    ///
+    /// The batch selection gives the same statuses as processing the cut
+    /// event by event, but does not update the counters of the cut.
+    class i_batch_measurement_cut
+    {
+    public:
+
+      /// Collection of measurements, one per event
+      typedef std::vector<const snemo::datamodel::base_topology_measurement *> measurement_batch_type;
+
+      /// Destructor
+      virtual ~i_batch_measurement_cut() {}
+
+      /// Select a batch of measurements
+      ///
+      /// Events with a null measurement or a measurement of another type are
+      /// inapplicable.
+      virtual void select(const measurement_batch_type & measurements_,
+                          batch_selection & selection_) const = 0;
+    };
+
+  } // end of namespace cut
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_CUT_I_BATCH_MEASUREMENT_CUT_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
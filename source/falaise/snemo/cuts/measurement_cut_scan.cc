@@ -0,0 +1,318 @@
+// falaise/snemo/cuts/measurement_cut_scan.cc
+
+// Ourselves:
+#include <falaise/snemo/cuts/measurement_cut_scan.h>
+
+// Standard library:
+#include <limits>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/properties.h>
+#include <datatools/clhep_units.h>
+#include <datatools/utils.h>
+
+// SuperNEMO data models :
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+
+namespace snemo {
+
+  namespace cut {
+
+    namespace {
+
+      /// Return the default unit of a quantity, as used by the measurement cuts
+      double default_unit(measurement_cut_scan::quantity_type quantity_, std::string & symbol_)
+      {
+        switch (quantity_) {
+        case measurement_cut_scan::QUANTITY_ENERGY:
+          symbol_ = "keV";
+          return CLHEP::keV;
+        case measurement_cut_scan::QUANTITY_ANGLE:
+          symbol_ = "degree";
+          return CLHEP::degree;
+        case measurement_cut_scan::QUANTITY_VERTICES_DISTANCE_X:
+        case measurement_cut_scan::QUANTITY_VERTICES_DISTANCE_Y:
+        case measurement_cut_scan::QUANTITY_VERTICES_DISTANCE_Z:
+          symbol_ = "mm";
+          return CLHEP::mm;
+        default:
+          symbol_ = "%";
+          return CLHEP::perCent;
+        }
+      }
+
+      /// Fetch a list of thresholds, either explicit ('key : real[N] = ...')
+      /// or regularly spaced ('key.first', 'key.last' and 'key.points')
+      void fetch_thresholds(const datatools::properties & configuration_, const std::string & key_,
+                            double unit_, std::vector<double> & thresholds_)
+      {
+        thresholds_.clear();
+        if (configuration_.has_key(key_)) {
+          if (configuration_.is_vector(key_)) {
+            configuration_.fetch(key_, thresholds_);
+          } else {
+            thresholds_.push_back(configuration_.fetch_real(key_));
+          }
+          if (! configuration_.has_explicit_unit(key_)) {
+            for (auto& a_threshold : thresholds_) a_threshold *= unit_;
+          }
+        } else if (configuration_.has_key(key_ + ".first")) {
+          DT_THROW_IF(! configuration_.has_key(key_ + ".last") || ! configuration_.has_key(key_ + ".points"),
+                      std::logic_error, "Missing '" << key_ << ".last' or '" << key_ << ".points' property !");
+          double first = configuration_.fetch_real(key_ + ".first");
+          if (! configuration_.has_explicit_unit(key_ + ".first")) first *= unit_;
+          double last = configuration_.fetch_real(key_ + ".last");
+          if (! configuration_.has_explicit_unit(key_ + ".last")) last *= unit_;
+          const int points = configuration_.fetch_integer(key_ + ".points");
+          DT_THROW_IF(points < 1, std::range_error,
+                      "Invalid number of points (" << points << ") for '" << key_ << "' thresholds !");
+          for (int i = 0; i < points; i++) {
+            thresholds_.push_back(points == 1 ? first : first + i * (last - first) / (points - 1));
+          }
+        }
+      }
+
+    }
+
+    // static
+    std::string measurement_cut_scan::get_quantity_label(quantity_type quantity_)
+    {
+      switch (quantity_) {
+      case QUANTITY_ENERGY:               return "energy";
+      case QUANTITY_ANGLE:                return "angle";
+      case QUANTITY_VERTICES_PROBABILITY: return "vertices_probability";
+      case QUANTITY_VERTICES_DISTANCE_X:  return "vertices_distance_x";
+      case QUANTITY_VERTICES_DISTANCE_Y:  return "vertices_distance_y";
+      case QUANTITY_VERTICES_DISTANCE_Z:  return "vertices_distance_z";
+      case QUANTITY_INTERNAL_PROBABILITY: return "internal_probability";
+      case QUANTITY_EXTERNAL_PROBABILITY: return "external_probability";
+      default:                            return "";
+      }
+    }
+
+    // static
+    measurement_cut_scan::quantity_type measurement_cut_scan::get_quantity(const std::string & label_)
+    {
+      for (int i = QUANTITY_ENERGY; i <= QUANTITY_EXTERNAL_PROBABILITY; i++) {
+        const quantity_type a_quantity = static_cast<quantity_type>(i);
+        if (label_ == get_quantity_label(a_quantity)) return a_quantity;
+      }
+      return QUANTITY_UNDEFINED;
+    }
+
+    measurement_cut_scan::grid_point::grid_point()
+    {
+      datatools::invalidate(min);
+      datatools::invalidate(max);
+      accepted = 0;
+      rejected = 0;
+      inapplicable = 0;
+    }
+
+    measurement_cut_scan::measurement_cut_scan()
+    {
+      reset();
+    }
+
+    bool measurement_cut_scan::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void measurement_cut_scan::initialize(const datatools::properties & configuration_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Scan is already initialized !");
+
+      DT_THROW_IF(! configuration_.has_key("measurement_label"), std::logic_error,
+                  "Missing 'measurement_label' property !");
+      _measurement_label_ = configuration_.fetch_string("measurement_label");
+
+      DT_THROW_IF(! configuration_.has_key("quantity"), std::logic_error, "Missing 'quantity' property !");
+      const std::string a_label = configuration_.fetch_string("quantity");
+      _quantity_ = get_quantity(a_label);
+      DT_THROW_IF(_quantity_ == QUANTITY_UNDEFINED, std::logic_error, "Unknown '" << a_label << "' quantity !");
+
+      std::string a_symbol;
+      const double unit = default_unit(_quantity_, a_symbol);
+      std::vector<double> mins, maxs;
+      fetch_thresholds(configuration_, "min", unit, mins);
+      fetch_thresholds(configuration_, "max", unit, maxs);
+      DT_THROW_IF(mins.empty() && maxs.empty(), std::logic_error,
+                  "Missing 'min' or 'max' thresholds !");
+      if (mins.empty()) mins.push_back(datatools::invalid_real());
+      if (maxs.empty()) maxs.push_back(datatools::invalid_real());
+
+      // Grid points are ordered by minimal then maximal threshold
+      for (const auto& a_min : mins) {
+        for (const auto& a_max : maxs) {
+          grid_point a_point;
+          a_point.min = a_min;
+          a_point.max = a_max;
+          _grid_.push_back(a_point);
+          _lower_bounds_.push_back(datatools::is_valid(a_min) ? a_min : -std::numeric_limits<double>::infinity());
+          _upper_bounds_.push_back(datatools::is_valid(a_max) ? a_max : +std::numeric_limits<double>::infinity());
+        }
+      }
+      _initialized_ = true;
+    }
+
+    void measurement_cut_scan::reset()
+    {
+      _initialized_ = false;
+      _measurement_label_.clear();
+      _quantity_ = QUANTITY_UNDEFINED;
+      _grid_.clear();
+      _lower_bounds_.clear();
+      _upper_bounds_.clear();
+      _number_of_events_ = 0;
+    }
+
+    const std::string & measurement_cut_scan::get_measurement_label() const
+    {
+      return _measurement_label_;
+    }
+
+    measurement_cut_scan::quantity_type measurement_cut_scan::get_quantity() const
+    {
+      return _quantity_;
+    }
+
+    const std::vector<measurement_cut_scan::grid_point> & measurement_cut_scan::get_grid() const
+    {
+      return _grid_;
+    }
+
+    size_t measurement_cut_scan::get_number_of_events() const
+    {
+      return _number_of_events_;
+    }
+
+    void measurement_cut_scan::clear_counters()
+    {
+      _number_of_events_ = 0;
+      for (auto& a_point : _grid_) {
+        a_point.accepted = 0;
+        a_point.rejected = 0;
+        a_point.inapplicable = 0;
+      }
+    }
+
+    void measurement_cut_scan::fill(const snemo::datamodel::base_topology_pattern * pattern_)
+    {
+      fill_measurement(pattern_ == nullptr ? nullptr : pattern_->find_measurement(_measurement_label_));
+    }
+
+    void measurement_cut_scan::fill_measurement(const snemo::datamodel::base_topology_measurement * measurement_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Scan is not initialized !");
+      _number_of_events_++;
+
+      // The quantity is reduced to the lowest and highest values that must
+      // lie within the thresholds
+      bool has_quantity = false;
+      double low;
+      double high;
+      datatools::invalidate(low);
+      datatools::invalidate(high);
+      switch (_quantity_) {
+      case QUANTITY_ENERGY:
+        if (auto a_energy_meas = dynamic_cast<const snemo::datamodel::energy_measurement *>(measurement_)) {
+          low = high = a_energy_meas->get_energy();
+          has_quantity = a_energy_meas->has_energy();
+        }
+        break;
+      case QUANTITY_ANGLE:
+        if (auto a_angle_meas = dynamic_cast<const snemo::datamodel::angle_measurement *>(measurement_)) {
+          low = high = a_angle_meas->get_angle();
+          has_quantity = a_angle_meas->is_valid();
+        }
+        break;
+      case QUANTITY_VERTICES_PROBABILITY:
+      case QUANTITY_VERTICES_DISTANCE_X:
+      case QUANTITY_VERTICES_DISTANCE_Y:
+      case QUANTITY_VERTICES_DISTANCE_Z:
+        if (auto a_vertices_meas = dynamic_cast<const snemo::datamodel::vertex_measurement *>(measurement_)) {
+          if (_quantity_ == QUANTITY_VERTICES_PROBABILITY) {
+            low = high = a_vertices_meas->get_probability();
+            has_quantity = a_vertices_meas->has_probability();
+          } else {
+            if (_quantity_ == QUANTITY_VERTICES_DISTANCE_X) low = a_vertices_meas->get_vertices_distance_x();
+            if (_quantity_ == QUANTITY_VERTICES_DISTANCE_Y) low = a_vertices_meas->get_vertices_distance_y();
+            if (_quantity_ == QUANTITY_VERTICES_DISTANCE_Z) low = a_vertices_meas->get_vertices_distance_z();
+            high = low;
+            has_quantity = a_vertices_meas->has_vertices_distance();
+          }
+        }
+        break;
+      case QUANTITY_INTERNAL_PROBABILITY:
+      case QUANTITY_EXTERNAL_PROBABILITY:
+        if (auto a_tof_meas = dynamic_cast<const snemo::datamodel::tof_measurement *>(measurement_)) {
+          // Every probability lies within the thresholds if and only if the
+          // extrema do; invalid probabilities never fail the cut
+          const auto& probabilities = _quantity_ == QUANTITY_INTERNAL_PROBABILITY
+            ? a_tof_meas->get_internal_probabilities()
+            : a_tof_meas->get_external_probabilities();
+          has_quantity = ! probabilities.empty();
+          low = +std::numeric_limits<double>::infinity();
+          high = -std::numeric_limits<double>::infinity();
+          for (const auto& a_probability : probabilities) {
+            low = a_probability < low ? a_probability : low;
+            high = a_probability > high ? a_probability : high;
+          }
+        }
+        break;
+      default:
+        break;
+      }
+
+      const size_t npoints = _grid_.size();
+      if (! has_quantity) {
+        for (size_t ip = 0; ip < npoints; ip++) _grid_[ip].inapplicable++;
+        return;
+      }
+      for (size_t ip = 0; ip < npoints; ip++) {
+        const size_t in_range = (low >= _lower_bounds_[ip]) & (high <= _upper_bounds_[ip]);
+        _grid_[ip].accepted += in_range;
+        _grid_[ip].rejected += 1 - in_range;
+      }
+    }
+
+    void measurement_cut_scan::print(std::ostream & out_, const std::string & indent_) const
+    {
+      std::string a_symbol;
+      const double unit = default_unit(_quantity_, a_symbol);
+      out_ << indent_ << "Scan of the " << get_quantity_label(_quantity_) << " of '"
+           << _measurement_label_ << "' over " << _number_of_events_ << " events :" << std::endl;
+      for (const auto& a_point : _grid_) {
+        out_ << indent_ << "  [";
+        if (datatools::is_valid(a_point.min)) out_ << a_point.min / unit;
+        out_ << ", ";
+        if (datatools::is_valid(a_point.max)) out_ << a_point.max / unit;
+        out_ << "] " << a_symbol << " : "
+             << a_point.accepted << " accepted, "
+             << a_point.rejected << " rejected, "
+             << a_point.inapplicable << " inapplicable";
+        if (_number_of_events_ > 0) {
+          out_ << ", efficiency = " << double(a_point.accepted) / _number_of_events_;
+        }
+        out_ << std::endl;
+      }
+    }
+
+  } // end of namespace cut
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,131 @@
+/// \file falaise/snemo/cuts/measurement_cut_scan.h
+/*
+ * Description:
+ *
+ *   Scan of the range thresholds of a measurement cut: every point of a
+ *   grid of thresholds is evaluated in a single pass over the events
+ */
+
+#ifndef FALAISE_SNEMO_CUT_MEASUREMENT_CUT_SCAN_H
+#define FALAISE_SNEMO_CUT_MEASUREMENT_CUT_SCAN_H 1
+
+// Standard library:
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace datatools {
+  class properties;
+}
+
+namespace snemo {
+
+  namespace datamodel {
+    class base_topology_measurement;
+    class base_topology_pattern;
+  }
+
+  namespace cut {
+
+    /// \brief Scan of the range thresholds of a measurement cut
+    ///
+    /// The scanned quantity is the one checked by the 'mode.range_XXX' mode
+    /// of the energy, angle, vertices and TOF measurement cuts. For every
+    /// point of a grid of [min, max] thresholds, the scan counts the events
+    /// the cut would accept, reject or find inapplicable, giving the full
+    /// efficiency curve of the cut in a single pass over the data.
+    class measurement_cut_scan
+    {
+    public:
+
+      /// Quantity checked against the thresholds
+      enum quantity_type {
+        QUANTITY_UNDEFINED            = 0,
+        QUANTITY_ENERGY               = 1, //!< 'energy' of an energy measurement
+        QUANTITY_ANGLE                = 2, //!< 'angle' of an angle measurement
+        QUANTITY_VERTICES_PROBABILITY = 3, //!< 'vertices_probability' of a vertex measurement
+        QUANTITY_VERTICES_DISTANCE_X  = 4, //!< 'vertices_distance_x' of a vertex measurement
+        QUANTITY_VERTICES_DISTANCE_Y  = 5, //!< 'vertices_distance_y' of a vertex measurement
+        QUANTITY_VERTICES_DISTANCE_Z  = 6, //!< 'vertices_distance_z' of a vertex measurement
+        QUANTITY_INTERNAL_PROBABILITY = 7, //!< 'internal_probability', all of them, of a TOF measurement
+        QUANTITY_EXTERNAL_PROBABILITY = 8  //!< 'external_probability', all of them, of a TOF measurement
+      };
+
+      /// Return the label of a quantity
+      static std::string get_quantity_label(quantity_type quantity_);
+
+      /// Return the quantity associated to a label
+      static quantity_type get_quantity(const std::string & label_);
+
+      /// Thresholds and selection counters of a grid point
+      struct grid_point {
+        grid_point();
+        double min;          //!< Minimal threshold (invalid if not checked)
+        double max;          //!< Maximal threshold (invalid if not checked)
+        size_t accepted;     //!< Number of accepted events
+        size_t rejected;     //!< Number of rejected events
+        size_t inapplicable; //!< Number of events the cut does not apply to
+      };
+
+    public:
+
+      /// Constructor
+      measurement_cut_scan();
+
+      /// Check initialization
+      bool is_initialized() const;
+
+      /// Initialization
+      void initialize(const datatools::properties & configuration_);
+
+      /// Reset
+      void reset();
+
+      /// Return the label of the scanned measurement
+      const std::string & get_measurement_label() const;
+
+      /// Return the scanned quantity
+      quantity_type get_quantity() const;
+
+      /// Return the grid points
+      const std::vector<grid_point> & get_grid() const;
+
+      /// Return the number of scanned events
+      size_t get_number_of_events() const;
+
+      /// Clear the selection counters
+      void clear_counters();
+
+      /// Count an event given its topology pattern (null if missing)
+      void fill(const snemo::datamodel::base_topology_pattern * pattern_);
+
+      /// Count an event given its measurement (null if missing)
+      void fill_measurement(const snemo::datamodel::base_topology_measurement * measurement_);
+
+      /// Print the efficiency curve
+      void print(std::ostream & out_ = std::clog, const std::string & indent_ = "") const;
+
+    private:
+
+      bool _initialized_;                 //!< Initialization flag
+      std::string _measurement_label_;    //!< Label of the scanned measurement
+      quantity_type _quantity_;           //!< Scanned quantity
+      std::vector<grid_point> _grid_;     //!< Grid points
+      std::vector<double> _lower_bounds_; //!< Minimal thresholds, infinite if not checked
+      std::vector<double> _upper_bounds_; //!< Maximal thresholds, infinite if not checked
+      size_t _number_of_events_;          //!< Number of scanned events
+    };
+
+  } // end of namespace cut
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_CUT_MEASUREMENT_CUT_SCAN_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -4,14 +4,17 @@
 #include <falaise/snemo/cuts/tof_measurement_cut.h>
 
 // Standard library:
+#include <limits>
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/properties.h>
 #include <datatools/things.h>
 #include <datatools/clhep_units.h>
+#include <datatools/utils.h>
 
 // SuperNEMO data models :
 #include <falaise/snemo/datamodels/tof_measurement.h>
@@ -310,6 +313,97 @@ namespace snemo {
       return cut_returned;
     }
 
+    namespace {
+
+      /// Reduce the probabilities of every event to their availability and extrema
+      ///
+      /// Invalid probabilities never fail a range check event by event, hence
+      /// they are left out of the extrema.
+      void reduce_probabilities(const double * values_, const size_t * offsets_, size_t n_,
+                                std::vector<uint8_t> & has_, std::vector<double> & minima_,
+                                std::vector<double> & maxima_)
+      {
+        has_.assign(n_, 0);
+        minima_.assign(n_, +std::numeric_limits<double>::infinity());
+        maxima_.assign(n_, -std::numeric_limits<double>::infinity());
+        for (size_t i = 0; i < n_; i++) {
+          has_[i] = offsets_[i + 1] > offsets_[i];
+          double a_min = minima_[i];
+          double a_max = maxima_[i];
+          for (size_t j = offsets_[i]; j < offsets_[i + 1]; j++) {
+            a_min = values_[j] < a_min ? values_[j] : a_min;
+            a_max = values_[j] > a_max ? values_[j] : a_max;
+          }
+          minima_[i] = a_min;
+          maxima_[i] = a_max;
+        }
+      }
+
+    }
+
+    void tof_measurement_cut::select(const double * internal_, const size_t * internal_offsets_,
+                                     const double * external_, const size_t * external_offsets_,
+                                     size_t n_, batch_selection & selection_) const
+    {
+      // Every probability lies within the range if and only if the extrema
+      // do, whatever the range mode
+      std::vector<uint8_t> has_internal, has_external;
+      std::vector<double> internal_min, internal_max, external_min, external_max;
+      reduce_probabilities(internal_, internal_offsets_, n_, has_internal, internal_min, internal_max);
+      reduce_probabilities(external_, external_offsets_, n_, has_external, external_min, external_max);
+
+      std::vector<uint8_t> applicable(n_, 1);
+      std::vector<uint8_t> accepted(n_, 1);
+      if (is_mode_has_internal_probability()) {
+        and_flags(has_internal.data(), n_, accepted.data());
+      }
+      if (is_mode_range_internal_probability()) {
+        and_flags(has_internal.data(), n_, applicable.data());
+        and_in_range(internal_min.data(), n_, _int_prob_range_min_, datatools::invalid_real(), accepted.data());
+        and_in_range(internal_max.data(), n_, datatools::invalid_real(), _int_prob_range_max_, accepted.data());
+      }
+      if (is_mode_has_external_probability()) {
+        and_flags(has_external.data(), n_, accepted.data());
+      }
+      if (is_mode_range_external_probability()) {
+        and_flags(has_external.data(), n_, applicable.data());
+        and_in_range(external_min.data(), n_, _ext_prob_range_min_, datatools::invalid_real(), accepted.data());
+        and_in_range(external_max.data(), n_, datatools::invalid_real(), _ext_prob_range_max_, accepted.data());
+      }
+      selection_.reset(n_);
+      selection_.assign(applicable.data(), accepted.data());
+    }
+
+    void tof_measurement_cut::select(const measurement_batch_type & measurements_,
+                                     batch_selection & selection_) const
+    {
+      const size_t n = measurements_.size();
+      std::vector<double> internal, external;
+      std::vector<size_t> internal_offsets(1, 0), external_offsets(1, 0);
+      internal_offsets.reserve(n + 1);
+      external_offsets.reserve(n + 1);
+      std::vector<size_t> missing;
+      for (size_t i = 0; i < n; i++) {
+        auto a_tof_meas = dynamic_cast<const snemo::datamodel::tof_measurement *>(measurements_[i]);
+        if (a_tof_meas == nullptr) {
+          missing.push_back(i);
+        } else {
+          internal.insert(internal.end(),
+                          a_tof_meas->get_internal_probabilities().begin(),
+                          a_tof_meas->get_internal_probabilities().end());
+          external.insert(external.end(),
+                          a_tof_meas->get_external_probabilities().begin(),
+                          a_tof_meas->get_external_probabilities().end());
+        }
+        internal_offsets.push_back(internal.size());
+        external_offsets.push_back(external.size());
+      }
+      select(internal.data(), internal_offsets.data(), external.data(), external_offsets.data(), n, selection_);
+      for (auto i : missing) {
+        selection_.set_status(i, cuts::SELECTION_INAPPLICABLE);
+      }
+    }
+
   }  // end of namespace cut
 
 }  // end of namespace snemo
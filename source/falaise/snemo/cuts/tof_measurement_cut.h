@@ -19,12 +19,15 @@
 // - Bayeux/cuts:
 #include <cuts/i_cut.h>
 
+// This project:
+#include <falaise/snemo/cuts/i_batch_measurement_cut.h>
+
 namespace snemo {
 
   namespace cut {
 
     /// \brief A cut performed on individual 'tof measurement'
-    class tof_measurement_cut : public cuts::i_cut
+    class tof_measurement_cut : public cuts::i_cut, public i_batch_measurement_cut
     {
     public:
 
@@ -76,6 +79,18 @@ namespace snemo {
       /// Reset
       virtual void reset();
 
+      /// Select a batch of TOF probabilities
+      ///
+      /// The probabilities of the event 'i' are stored in the range
+      /// [offsets_[i], offsets_[i + 1]) of the probability arrays.
+      void select(const double * internal_, const size_t * internal_offsets_,
+                  const double * external_, const size_t * external_offsets_,
+                  size_t n_, batch_selection & selection_) const;
+
+      /// Select a batch of TOF measurements
+      virtual void select(const measurement_batch_type & measurements_,
+                          batch_selection & selection_) const;
+
     protected:
 
       /// Default values
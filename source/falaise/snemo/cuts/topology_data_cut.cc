@@ -113,7 +113,7 @@ namespace snemo {
 
     int topology_data_cut::_accept()
     {
-      uint32_t cut_returned = cuts::SELECTION_INAPPLICABLE;
+      int cut_returned = cuts::SELECTION_INAPPLICABLE;
 
       // Get event record
       auto& ER = get_user_data<datatools::things>();
@@ -123,18 +123,31 @@ namespace snemo {
         return cut_returned;
       }
 
-     auto TD = ER.get<snemo::datamodel::topology_data>(_TD_label_);
+      const auto& TD = ER.get<snemo::datamodel::topology_data>(_TD_label_);
+
+      // The same cut is usually shared by several channels: its result is
+      // memoized within the topology data of the event
+      if (! TD.find_cut_result(this, &ER, cut_returned)) {
+        cut_returned = _check_topology_data_(TD);
+        TD.store_cut_result(this, &ER, cut_returned);
+      }
+      return cut_returned;
+    }
+
+    int topology_data_cut::_check_topology_data_(const snemo::datamodel::topology_data & TD_) const
+    {
+      int cut_returned = cuts::SELECTION_INAPPLICABLE;
 
       // Check if event has pattern
       bool check_has_pattern = true;
       if (is_mode_has_pattern()) {
-        if (! TD.has_pattern()) check_has_pattern = false;
+        if (! TD_.has_pattern()) check_has_pattern = false;
       }
 
       // Check if event has a classification
       bool check_has_classification = true;
       if (is_mode_has_classification()) {
-        auto td_aux = TD.get_auxiliaries();
+        const auto& td_aux = TD_.get_auxiliaries();
         if (! td_aux.has_key(snemo::datamodel::pid_utils::classification_label_key()))
           check_has_classification = false;
       }
@@ -142,7 +155,7 @@ namespace snemo {
       // Check if event has the correct classification label
       bool check_classification = true;
       if (is_mode_classification()) {
-        auto td_aux = TD.get_auxiliaries();
+        const auto& td_aux = TD_.get_auxiliaries();
         if (! td_aux.has_key(snemo::datamodel::pid_utils::classification_label_key())) {
           return cuts::SELECTION_INAPPLICABLE;
         }
@@ -156,7 +169,7 @@ namespace snemo {
       bool check_no_pile_up = true;
       if (is_mode_no_pile_up()) {
         std::set<geomtools::geom_id> gids;
-        auto a_particle_track_dict = TD.get_pattern_handle().get().get_particle_track_dictionary();
+        auto a_particle_track_dict = TD_.get_pattern_handle().get().get_particle_track_dictionary();
 
         for (auto& it : a_particle_track_dict) {
           if (! (std::regex_match(it.first, std::regex("e[0-9]")) ||
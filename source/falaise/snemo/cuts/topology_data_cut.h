@@ -44,6 +44,10 @@
 
 namespace snemo {
 
+  namespace datamodel {
+    class topology_data;
+  }
+
   namespace cut {
 
     /// \brief A topology_data event cut
@@ -99,6 +103,11 @@ namespace snemo {
       /// Selection
       virtual int _accept();
 
+    private:
+
+      /// Apply the selection to the topology data of an event
+      int _check_topology_data_(const snemo::datamodel::topology_data & TD_) const;
+
     private:
 
       std::string _TD_label_; //!< Name of the "Topology data" bank
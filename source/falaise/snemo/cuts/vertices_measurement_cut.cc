@@ -6,12 +6,14 @@
 // Standard library:
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/properties.h>
 #include <datatools/things.h>
 #include <datatools/clhep_units.h>
+#include <datatools/utils.h>
 
 // SuperNEMO data models :
 #include <falaise/snemo/datamodels/vertex_measurement.h>
@@ -391,6 +393,76 @@ namespace snemo {
       return cut_returned;
     }
 
+    void vertices_measurement_cut::select(const double * probabilities_,
+                                          const double * distances_x_,
+                                          const double * distances_y_,
+                                          const double * distances_z_,
+                                          size_t n_, batch_selection & selection_) const
+    {
+      std::vector<uint8_t> has_probability(n_);
+      flag_valid(probabilities_, n_, has_probability.data());
+      std::vector<uint8_t> has_distance(n_);
+      std::vector<uint8_t> has_distance_yz(n_);
+      flag_valid(distances_x_, n_, has_distance.data());
+      flag_valid(distances_y_, n_, has_distance_yz.data());
+      and_flags(has_distance_yz.data(), n_, has_distance.data());
+      flag_valid(distances_z_, n_, has_distance_yz.data());
+      and_flags(has_distance_yz.data(), n_, has_distance.data());
+
+      std::vector<uint8_t> applicable(n_, 1);
+      std::vector<uint8_t> accepted(n_, 1);
+      if (is_mode_has_vertices_probability()) {
+        and_flags(has_probability.data(), n_, accepted.data());
+      }
+      if (is_mode_range_vertices_probability()) {
+        and_flags(has_probability.data(), n_, applicable.data());
+        and_in_range(probabilities_, n_, _vertices_prob_range_min_, _vertices_prob_range_max_, accepted.data());
+      }
+      if (is_mode_has_vertices_distance()) {
+        and_flags(has_distance.data(), n_, accepted.data());
+      }
+      if (is_mode_range_vertices_distance_x()) {
+        and_flags(has_distance.data(), n_, applicable.data());
+        and_in_range(distances_x_, n_, _vertices_dist_x_range_min_, _vertices_dist_x_range_max_, accepted.data());
+      }
+      if (is_mode_range_vertices_distance_y()) {
+        and_flags(has_distance.data(), n_, applicable.data());
+        and_in_range(distances_y_, n_, _vertices_dist_y_range_min_, _vertices_dist_y_range_max_, accepted.data());
+      }
+      if (is_mode_range_vertices_distance_z()) {
+        and_flags(has_distance.data(), n_, applicable.data());
+        and_in_range(distances_z_, n_, _vertices_dist_z_range_min_, _vertices_dist_z_range_max_, accepted.data());
+      }
+      selection_.reset(n_);
+      selection_.assign(applicable.data(), accepted.data());
+    }
+
+    void vertices_measurement_cut::select(const measurement_batch_type & measurements_,
+                                          batch_selection & selection_) const
+    {
+      const size_t n = measurements_.size();
+      std::vector<double> probabilities(n, datatools::invalid_real());
+      std::vector<double> distances_x(n, datatools::invalid_real());
+      std::vector<double> distances_y(n, datatools::invalid_real());
+      std::vector<double> distances_z(n, datatools::invalid_real());
+      std::vector<size_t> missing;
+      for (size_t i = 0; i < n; i++) {
+        auto a_vertices_meas = dynamic_cast<const snemo::datamodel::vertex_measurement *>(measurements_[i]);
+        if (a_vertices_meas == nullptr) {
+          missing.push_back(i);
+          continue;
+        }
+        probabilities[i] = a_vertices_meas->get_probability();
+        distances_x[i] = a_vertices_meas->get_vertices_distance_x();
+        distances_y[i] = a_vertices_meas->get_vertices_distance_y();
+        distances_z[i] = a_vertices_meas->get_vertices_distance_z();
+      }
+      select(probabilities.data(), distances_x.data(), distances_y.data(), distances_z.data(), n, selection_);
+      for (auto i : missing) {
+        selection_.set_status(i, cuts::SELECTION_INAPPLICABLE);
+      }
+    }
+
   }  // end of namespace cut
 
 }  // end of namespace snemo
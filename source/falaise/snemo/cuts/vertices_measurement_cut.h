@@ -19,12 +19,15 @@
 // - Bayeux/cuts:
 #include <cuts/i_cut.h>
 
+// This project:
+#include <falaise/snemo/cuts/i_batch_measurement_cut.h>
+
 namespace snemo {
 
   namespace cut {
 
     /// \brief A cut performed on individual 'vertices measurement'
-    class vertices_measurement_cut : public cuts::i_cut
+    class vertices_measurement_cut : public cuts::i_cut, public i_batch_measurement_cut
     {
     public:
       /// Mode of the cut
@@ -77,6 +80,17 @@ namespace snemo {
       /// Reset
       virtual void reset();
 
+      /// Select a batch of vertex probabilities and distances, invalid when not measured
+      void select(const double * probabilities_,
+                  const double * distances_x_,
+                  const double * distances_y_,
+                  const double * distances_z_,
+                  size_t n_, batch_selection & selection_) const;
+
+      /// Select a batch of vertex measurements
+      virtual void select(const measurement_batch_type & measurements_,
+                          batch_selection & selection_) const;
+
     protected:
 
       /// Default values
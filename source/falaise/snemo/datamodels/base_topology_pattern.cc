@@ -5,6 +5,7 @@
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
 
 // Standard library:
+#include <algorithm>
 #include <regex>
 
 namespace snemo {
@@ -16,7 +17,35 @@ namespace snemo {
                                                       "snemo::datamodel::base_topology_pattern")
 
     base_topology_pattern::base_topology_pattern()
+      : _has_deferred_meas_(false)
     {
+      _evaluation_depth_ = 0;
+    }
+
+    base_topology_pattern::base_topology_pattern(const base_topology_pattern & pattern_)
+      : datatools::i_serializable(pattern_),
+        datatools::i_tree_dumpable(pattern_),
+        _has_deferred_meas_(false)
+    {
+      _evaluation_depth_ = 0;
+      // Evaluators refer to the source pattern: they are never copied
+      pattern_.evaluate_measurements();
+      _tracks_ = pattern_._tracks_;
+      _meas_ = pattern_._meas_;
+    }
+
+    base_topology_pattern & base_topology_pattern::operator=(const base_topology_pattern & pattern_)
+    {
+      if (this == &pattern_) return *this;
+      pattern_.evaluate_measurements();
+      std::lock_guard<std::recursive_mutex> lock(_meas_mutex_);
+      datatools::i_serializable::operator=(pattern_);
+      datatools::i_tree_dumpable::operator=(pattern_);
+      _tracks_ = pattern_._tracks_;
+      _meas_ = pattern_._meas_;
+      _deferred_meas_.clear();
+      _has_deferred_meas_ = false;
+      return *this;
     }
 
     base_topology_pattern::~base_topology_pattern()
@@ -46,28 +75,129 @@ namespace snemo {
     bool base_topology_pattern::has_measurement(const std::string & key_) const
     {
       // Use key as regular expression and match over it
+      // Deferred measurements are not evaluated to answer
+      const std::regex key_regex(key_);
+      std::unique_lock<std::recursive_mutex> lock(_meas_mutex_, std::defer_lock);
+      if (_has_deferred_meas_) lock.lock();
       auto it = std::find_if(_meas_.begin(), _meas_.end(),
-                             [key_](const std::pair<std::string, handle_measurement> & t) -> bool {
-                               return std::regex_match(t.first, std::regex(key_));
+                             [&key_regex](const std::pair<std::string, handle_measurement> & t) -> bool {
+                               return std::regex_match(t.first, key_regex);
+                             });
+      if (it != _meas_.end()) return true;
+      auto jt = std::find_if(_deferred_meas_.begin(), _deferred_meas_.end(),
+                             [&key_regex](const std::pair<std::string, measurement_evaluator_type> & t) -> bool {
+                               return std::regex_match(t.first, key_regex);
                              });
-      return it != _meas_.end();
+      return jt != _deferred_meas_.end();
     }
 
     const snemo::datamodel::base_topology_measurement & base_topology_pattern::get_measurement(const std::string & key_) const
     {
-      return _meas_.at(key_).get();
+      std::unique_lock<std::recursive_mutex> lock(_meas_mutex_, std::defer_lock);
+      if (_has_deferred_meas_) {
+        lock.lock();
+        if (is_deferred_measurement(key_)) {
+          _evaluate_measurement_(key_);
+        }
+      }
+      auto found = _meas_.find(key_);
+      DT_THROW_IF(found == _meas_.end(), std::logic_error,
+                  "Topology pattern does not hold any '" << key_ << "' measurement !");
+      return found->second.get();
+    }
+
+    const snemo::datamodel::base_topology_measurement * base_topology_pattern::find_measurement(const std::string & key_) const
+    {
+      std::unique_lock<std::recursive_mutex> lock(_meas_mutex_, std::defer_lock);
+      if (_has_deferred_meas_) {
+        lock.lock();
+        if (is_deferred_measurement(key_)) {
+          _evaluate_measurement_(key_);
+        }
+      }
+      auto found = _meas_.find(key_);
+      if (found == _meas_.end() || ! found->second.has_data()) return nullptr;
+      return &found->second.get();
+    }
+
+    void base_topology_pattern::finalize()
+    {
     }
 
     snemo::datamodel::base_topology_pattern::measurement_dict_type & base_topology_pattern::get_measurement_dictionary()
     {
+      evaluate_measurements();
+      _reset_derived_();
       return _meas_;
     }
 
     const snemo::datamodel::base_topology_pattern::measurement_dict_type & base_topology_pattern::get_measurement_dictionary() const
     {
+      evaluate_measurements();
       return _meas_;
     }
 
+    void base_topology_pattern::add_deferred_measurement(const std::string & label_,
+                                                         const measurement_evaluator_type & evaluator_)
+    {
+      DT_THROW_IF(! evaluator_, std::logic_error, "Missing evaluator for measurement '" << label_ << "' !");
+      std::lock_guard<std::recursive_mutex> lock(_meas_mutex_);
+      _meas_.erase(label_);
+      _deferred_meas_[label_] = evaluator_;
+      _has_deferred_meas_ = true;
+      _reset_derived_();
+    }
+
+    bool base_topology_pattern::is_deferred_measurement(const std::string & label_) const
+    {
+      if (! _has_deferred_meas_) return false;
+      std::lock_guard<std::recursive_mutex> lock(_meas_mutex_);
+      return _deferred_meas_.find(label_) != _deferred_meas_.end();
+    }
+
+    void base_topology_pattern::evaluate_measurements() const
+    {
+      if (! _has_deferred_meas_) return;
+      std::lock_guard<std::recursive_mutex> lock(_meas_mutex_);
+      while (! _deferred_meas_.empty()) {
+        // The label is copied as its evaluator is removed before the evaluation
+        const std::string a_label = _deferred_meas_.begin()->first;
+        _evaluate_measurement_(a_label);
+      }
+    }
+
+    void base_topology_pattern::_reset_derived_()
+    {
+    }
+
+    std::recursive_mutex & base_topology_pattern::_get_measurement_mutex_() const
+    {
+      return _meas_mutex_;
+    }
+
+    void base_topology_pattern::_evaluate_measurement_(const std::string & label_) const
+    {
+      // Called with the measurement guard held
+      auto found = _deferred_meas_.find(label_);
+      if (found == _deferred_meas_.end()) return;
+      // Remove the evaluator before calling it so a failing evaluation is not retried
+      const measurement_evaluator_type an_evaluator = found->second;
+      _deferred_meas_.erase(found);
+      handle_measurement a_measurement;
+      _evaluation_depth_++;
+      try {
+        a_measurement = an_evaluator();
+      } catch (...) {
+        _evaluation_depth_--;
+        _has_deferred_meas_ = _evaluation_depth_ > 0 || ! _deferred_meas_.empty();
+        throw;
+      }
+      _evaluation_depth_--;
+      _meas_[label_] = a_measurement;
+      // Readers stop locking once the last measurement, nested ones included, is published
+      _has_deferred_meas_ = _evaluation_depth_ > 0 || ! _deferred_meas_.empty();
+    }
+
     void base_topology_pattern::tree_dump(std::ostream      & out_,
                                           const std::string & title_,
                                           const std::string & indent_,
@@ -110,6 +240,7 @@ namespace snemo {
         }
       }
 
+      evaluate_measurements();
       {
         out_ << indent << datatools::i_tree_dumpable::inherit_tag(inherit_)
              << "Associated measurements : ";
@@ -10,8 +10,11 @@
 #define FALAISE_SNEMO_DATAMODEL_BASE_TOPOLOGY_PATTERN_H 1
 
 // Standard library:
+#include <atomic>
 #include <string>
 #include <map>
+#include <functional>
+#include <mutex>
 
 // Third party:
 // - Bayeux/datatools:
@@ -43,10 +46,22 @@ namespace snemo {
       /// Typedef to measurement dictionary
       typedef std::map<std::string, handle_measurement> measurement_dict_type;
 
+      /// Typedef to the function computing a deferred measurement
+      typedef std::function<handle_measurement()> measurement_evaluator_type;
+
     public:
       /// Constructor
       base_topology_pattern();
 
+      /// Copy constructor
+      ///
+      /// The deferred measurements of the source are evaluated first: the
+      /// copy only holds evaluated measurements.
+      base_topology_pattern(const base_topology_pattern & pattern_);
+
+      /// Assignment operator, with the deferred measurements of the source evaluated first
+      base_topology_pattern & operator=(const base_topology_pattern & pattern_);
+
       /// Destructor
       virtual ~base_topology_pattern();
 
@@ -71,34 +86,68 @@ namespace snemo {
       /// Get a given measurement
       const snemo::datamodel::base_topology_measurement & get_measurement(const std::string &) const;
 
+      /// Return a given measurement, or null if there is none
+      const snemo::datamodel::base_topology_measurement * find_measurement(const std::string &) const;
+
+      /// Return a measurement of a given type, or null if there is none
+      template<class T>
+      const T * find_measurement_as(const std::string & label_) const
+      {
+        return dynamic_cast<const T *>(find_measurement(label_));
+      }
+
       /// Check measurement data type
       template<class T>
       bool has_measurement_as(const std::string & label_) const
       {
-        DT_THROW_IF(! has_measurement(label_),
-                    std::logic_error,
-                    "Topology pattern does not hold any '" << label_ << "' measurement !");
-        const std::type_info & ti = typeid(T);
-        const std::type_info & tf = typeid(decltype(get_measurement(label_)));
-        return ti == tf;
+        return dynamic_cast<const T *>(&get_measurement(label_)) != nullptr;
       }
 
       /// Get a non-mutable measurement of a given type
       template<class T>
       const T & get_measurement_as(const std::string & label_) const
       {
-        DT_THROW_IF(! has_measurement_as<T>(label_),
+        const T * a_measurement = dynamic_cast<const T *>(&get_measurement(label_));
+        DT_THROW_IF(a_measurement == nullptr,
                     std::logic_error,
                     "Invalid request on measurement data type !");
-        return dynamic_cast<const T&>(get_measurement(label_));
+        return *a_measurement;
       }
 
       /// Get a mutable reference to measurement dictionary
+      ///
+      /// All the deferred measurements are evaluated first, and the
+      /// quantities derived from the measurements are reset.
       measurement_dict_type & get_measurement_dictionary();
 
       /// Get a non-mutable reference to measurement dictionary
+      ///
+      /// All the deferred measurements are evaluated first.
       const measurement_dict_type & get_measurement_dictionary() const;
 
+      /// Register a measurement computed on first access
+      ///
+      /// The evaluator is called once, when the measurement is first
+      /// requested by get_measurement, by the measurement dictionary accessors
+      /// or by the serializer. Its result is then cached. Concurrent readers
+      /// evaluate it once. Everything the evaluator refers to must outlive the
+      /// evaluation.
+      void add_deferred_measurement(const std::string & label_,
+                                    const measurement_evaluator_type & evaluator_);
+
+      /// Check if a measurement has been registered but not evaluated yet
+      bool is_deferred_measurement(const std::string & label_) const;
+
+      /// Evaluate all the deferred measurements
+      void evaluate_measurements() const;
+
+      /// Compute the quantities derived from the measurements
+      ///
+      /// Called by the builders once all the measurements are stored, unless
+      /// they are computed on first access. Patterns compute their derived
+      /// quantities on first use when they have not been finalized.
+      virtual void finalize();
+
 
       /// Smart print
       virtual void tree_dump(std::ostream      & out_    = std::clog,
@@ -106,10 +155,33 @@ namespace snemo {
                              const std::string & indent_ = "",
                              bool inherit_               = false) const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      ///
+      /// Called when the measurements may be changed. Patterns caching
+      /// quantities derived from the measurements reset them here.
+      virtual void _reset_derived_();
+
+      /// Return the guard of the measurements
+      ///
+      /// Quantities derived from the measurements on first use are computed
+      /// with this guard held, so that concurrent readers compute them once.
+      std::recursive_mutex & _get_measurement_mutex_() const;
+
+    private:
+
+      /// Evaluate a deferred measurement
+      void _evaluate_measurement_(const std::string & label_) const;
+
     private:
 
-      particle_track_dict_type _tracks_; //!< Particle track dictionary
-      measurement_dict_type _meas_;      //!< Measurement dictionary
+      particle_track_dict_type _tracks_;  //!< Particle track dictionary
+      mutable measurement_dict_type _meas_; //!< Measurement dictionary
+      mutable std::map<std::string, measurement_evaluator_type> _deferred_meas_; //!< Measurements not evaluated yet (transient)
+      mutable std::atomic<bool> _has_deferred_meas_; //!< Flag of pending deferred measurements (transient)
+      mutable std::recursive_mutex _meas_mutex_;     //!< Guard of the deferred evaluation (transient)
+      mutable size_t _evaluation_depth_;             //!< Number of evaluations in progress (transient)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
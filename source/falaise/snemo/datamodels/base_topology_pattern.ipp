@@ -23,6 +23,10 @@ namespace snemo {
     template<class Archive>
     void base_topology_pattern::serialize(Archive & ar_, const unsigned int /* version_ */)
     {
+      if (Archive::is_saving::value) {
+        // Deferred measurements are stored once evaluated
+        evaluate_measurements();
+      }
       ar_ & DATATOOLS_SERIALIZATION_I_SERIALIZABLE_BASE_OBJECT_NVP;
       ar_ & boost::serialization::make_nvp("particle_tracks", _tracks_);
       ar_ & boost::serialization::make_nvp("measurements", _meas_);
@@ -0,0 +1,179 @@
+/** \file falaise/snemo/datamodels/gamma_measurement_views.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/gamma_measurement_views.h>
+
+// Standard library:
+#include <algorithm>
+#include <sstream>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    gamma_measurement_views::gamma_measurement_views()
+    {
+      clear();
+    }
+
+    gamma_measurement_views::gamma_measurement_views(const gamma_measurement_views &)
+    {
+      clear();
+    }
+
+    gamma_measurement_views & gamma_measurement_views::operator=(const gamma_measurement_views &)
+    {
+      clear();
+      return *this;
+    }
+
+    bool gamma_measurement_views::is_built() const
+    {
+      return _built_.load(std::memory_order_acquire);
+    }
+
+    void gamma_measurement_views::clear()
+    {
+      _built_ = false;
+      _charged_labels_.clear();
+      _number_of_gammas_ = 0;
+      _energies_.clear();
+      _has_energies_.clear();
+      _has_tofs_.clear();
+      _internal_.clear();
+      _external_.clear();
+      _internal_offsets_.assign(1, 0);
+      _external_offsets_.assign(1, 0);
+    }
+
+    void gamma_measurement_views::build(const base_topology_pattern & pattern_,
+                                        const std::vector<std::string> & charged_labels_,
+                                        size_t ngammas_)
+    {
+      clear();
+      _charged_labels_ = charged_labels_;
+      _number_of_gammas_ = ngammas_;
+
+      // Deferred measurements are all evaluated here, once
+      const base_topology_pattern::measurement_dict_type & the_measurements
+        = pattern_.get_measurement_dictionary();
+
+      std::vector<std::string> g_labels;
+      for (size_t ig = 1; ig <= ngammas_; ig++) {
+        std::ostringstream oss;
+        oss << "g" << ig;
+        g_labels.push_back(oss.str());
+      }
+
+      _energies_.assign(ngammas_, datatools::invalid_real());
+      _has_energies_.assign(ngammas_, false);
+      for (size_t ig = 0; ig < ngammas_; ig++) {
+        auto found = the_measurements.find("energy_" + g_labels[ig]);
+        if (found == the_measurements.end() || ! found->second.has_data()) continue;
+        const energy_measurement * a_energy = dynamic_cast<const energy_measurement *>(&found->second.get());
+        if (a_energy == nullptr) continue;
+        _energies_[ig] = a_energy->get_energy();
+        _has_energies_[ig] = true;
+      }
+
+      const size_t npairs = charged_labels_.size() * ngammas_;
+      _has_tofs_.assign(npairs, false);
+      _internal_offsets_.reserve(npairs + 1);
+      _external_offsets_.reserve(npairs + 1);
+      for (const auto& a_label : charged_labels_) {
+        for (size_t ig = 0; ig < ngammas_; ig++) {
+          auto found = the_measurements.find("tof_" + a_label + "_" + g_labels[ig]);
+          const tof_measurement * a_tof = nullptr;
+          if (found != the_measurements.end() && found->second.has_data()) {
+            a_tof = dynamic_cast<const tof_measurement *>(&found->second.get());
+          }
+          if (a_tof != nullptr) {
+            _has_tofs_[_internal_offsets_.size() - 1] = true;
+            _internal_.insert(_internal_.end(),
+                              a_tof->get_internal_probabilities().begin(),
+                              a_tof->get_internal_probabilities().end());
+            _external_.insert(_external_.end(),
+                              a_tof->get_external_probabilities().begin(),
+                              a_tof->get_external_probabilities().end());
+          }
+          _internal_offsets_.push_back(_internal_.size());
+          _external_offsets_.push_back(_external_.size());
+        }
+      }
+      _built_.store(true, std::memory_order_release);
+    }
+
+    size_t gamma_measurement_views::get_number_of_gammas() const
+    {
+      return _number_of_gammas_;
+    }
+
+    size_t gamma_measurement_views::get_charged_index(const std::string & label_) const
+    {
+      auto found = std::find(_charged_labels_.begin(), _charged_labels_.end(), label_);
+      DT_THROW_IF(found == _charged_labels_.end(), std::logic_error,
+                  "No particle with label '" << label_ << "' in the gamma views !");
+      return found - _charged_labels_.begin();
+    }
+
+    bool gamma_measurement_views::has_energy(size_t gamma_) const
+    {
+      DT_THROW_IF(gamma_ >= _number_of_gammas_, std::range_error, "Invalid gamma index " << gamma_ << " !");
+      return _has_energies_[gamma_];
+    }
+
+    gamma_measurement_views::range gamma_measurement_views::get_energies() const
+    {
+      range a_range = {_energies_.data(), _energies_.data() + _energies_.size()};
+      return a_range;
+    }
+
+    bool gamma_measurement_views::has_tof(size_t charged_, size_t gamma_) const
+    {
+      return _has_tofs_[_pair_index_(charged_, gamma_)];
+    }
+
+    gamma_measurement_views::range gamma_measurement_views::get_internal_probabilities(size_t charged_, size_t gamma_) const
+    {
+      const size_t ipair = _pair_index_(charged_, gamma_);
+      range a_range = {_internal_.data() + _internal_offsets_[ipair], _internal_.data() + _internal_offsets_[ipair + 1]};
+      return a_range;
+    }
+
+    gamma_measurement_views::range gamma_measurement_views::get_external_probabilities(size_t charged_, size_t gamma_) const
+    {
+      const size_t ipair = _pair_index_(charged_, gamma_);
+      range a_range = {_external_.data() + _external_offsets_[ipair], _external_.data() + _external_offsets_[ipair + 1]};
+      return a_range;
+    }
+
+    size_t gamma_measurement_views::_pair_index_(size_t charged_, size_t gamma_) const
+    {
+      DT_THROW_IF(charged_ >= _charged_labels_.size(), std::range_error,
+                  "Invalid charged particle index " << charged_ << " !");
+      DT_THROW_IF(gamma_ >= _number_of_gammas_, std::range_error, "Invalid gamma index " << gamma_ << " !");
+      return charged_ * _number_of_gammas_ + gamma_;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,117 @@
+/// \file falaise/snemo/datamodels/gamma_measurement_views.h
+/*
+ * Description: Per-gamma measurements of a topology pattern gathered in
+ *              contiguous arrays
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_GAMMA_MEASUREMENT_VIEWS_H
+#define FALAISE_SNEMO_DATAMODEL_GAMMA_MEASUREMENT_VIEWS_H 1
+
+// Standard library:
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    class base_topology_pattern;
+
+    /// \brief Per-gamma measurements of a topology pattern gathered in contiguous arrays
+    ///
+    /// The energies of the gammas 'g1' to 'gN' and the TOF probabilities
+    /// between a set of charged particles and these gammas are copied once
+    /// from the measurement dictionary. Accessors return non-owning views
+    /// valid as long as the views are not rebuilt. Copies are not built, as
+    /// the views belong to the source pattern.
+    class gamma_measurement_views
+    {
+    public:
+
+      /// \brief Non-owning view of a contiguous range of values
+      struct range {
+        const double * first; //!< First value
+        const double * last;  //!< Past the last value
+
+        const double * begin() const { return first; }
+        const double * end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+        const double & operator[](size_t i_) const { return first[i_]; }
+      };
+
+    public:
+      /// Constructor
+      gamma_measurement_views();
+
+      /// Copy constructor, the copy being not built
+      gamma_measurement_views(const gamma_measurement_views &);
+
+      /// Assignment operator, the views being not built anymore
+      gamma_measurement_views & operator=(const gamma_measurement_views &);
+
+      /// Check if the views have been built
+      bool is_built() const;
+
+      /// Gather the measurements of 'ngammas_' gammas and the given charged particles
+      void build(const base_topology_pattern & pattern_,
+                 const std::vector<std::string> & charged_labels_,
+                 size_t ngammas_);
+
+      /// Remove all the views
+      void clear();
+
+      /// Return the number of gammas
+      size_t get_number_of_gammas() const;
+
+      /// Return the index of a charged particle
+      size_t get_charged_index(const std::string & label_) const;
+
+      /// Check if the energy of a gamma (from 0) is available
+      bool has_energy(size_t gamma_) const;
+
+      /// Return the energies of all the gammas (invalid if not measured)
+      range get_energies() const;
+
+      /// Check if the TOF between a charged particle and a gamma is available
+      bool has_tof(size_t charged_, size_t gamma_) const;
+
+      /// Return the internal TOF probabilities between a charged particle and a gamma
+      range get_internal_probabilities(size_t charged_, size_t gamma_) const;
+
+      /// Return the external TOF probabilities between a charged particle and a gamma
+      range get_external_probabilities(size_t charged_, size_t gamma_) const;
+
+    private:
+
+      /// Return the index of a charged particle/gamma pair
+      size_t _pair_index_(size_t charged_, size_t gamma_) const;
+
+    private:
+
+      std::atomic<bool> _built_;                 //!< Build flag
+      std::vector<std::string> _charged_labels_; //!< Labels of the charged particles
+      size_t _number_of_gammas_;                 //!< Number of gammas
+      std::vector<double> _energies_;            //!< Gamma energies
+      std::vector<bool> _has_energies_;          //!< Gamma energy availability
+      std::vector<bool> _has_tofs_;              //!< TOF availability per pair
+      std::vector<double> _internal_;            //!< Internal probabilities of all the pairs
+      std::vector<double> _external_;            //!< External probabilities of all the pairs
+      std::vector<size_t> _internal_offsets_;    //!< Offsets of the pairs within the internal probabilities
+      std::vector<size_t> _external_offsets_;    //!< Offsets of the pairs within the external probabilities
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_GAMMA_MEASUREMENT_VIEWS_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
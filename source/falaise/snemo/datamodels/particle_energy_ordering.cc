@@ -0,0 +1,125 @@
+/** \file falaise/snemo/datamodels/particle_energy_ordering.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/particle_energy_ordering.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    particle_energy_ordering::particle_energy_ordering()
+    {
+      reset();
+    }
+
+    particle_energy_ordering::particle_energy_ordering(const particle_energy_ordering &)
+    {
+      reset();
+    }
+
+    particle_energy_ordering & particle_energy_ordering::operator=(const particle_energy_ordering &)
+    {
+      reset();
+      return *this;
+    }
+
+    bool particle_energy_ordering::is_computed() const
+    {
+      return _computed_.load(std::memory_order_acquire);
+    }
+
+    void particle_energy_ordering::compute(const base_topology_pattern & pattern_,
+                                           const std::string & label1_,
+                                           const std::string & label2_)
+    {
+      reset();
+      const energy_measurement * energy1 = pattern_.find_measurement_as<energy_measurement>("energy_" + label1_);
+      const energy_measurement * energy2 = pattern_.find_measurement_as<energy_measurement>("energy_" + label2_);
+      _has_energies_ = energy1 != nullptr && energy2 != nullptr;
+      if (_has_energies_) {
+        const double e1 = energy1->get_energy();
+        const double e2 = energy2->get_energy();
+        if (e1 < e2) {
+          _minimal_energy_ = e1;
+          _maximal_energy_ = e2;
+          _minimal_energy_label_ = label1_;
+          _maximal_energy_label_ = label2_;
+        } else {
+          _minimal_energy_ = e2;
+          _maximal_energy_ = e1;
+          _minimal_energy_label_ = label2_;
+          _maximal_energy_label_ = label1_;
+        }
+        _energy_sum_ = _minimal_energy_ + _maximal_energy_;
+        _energy_difference_ = _maximal_energy_ - _minimal_energy_;
+      }
+      _computed_.store(true, std::memory_order_release);
+    }
+
+    void particle_energy_ordering::reset()
+    {
+      _computed_ = false;
+      _has_energies_ = false;
+      datatools::invalidate(_minimal_energy_);
+      datatools::invalidate(_maximal_energy_);
+      datatools::invalidate(_energy_sum_);
+      datatools::invalidate(_energy_difference_);
+      _minimal_energy_label_.clear();
+      _maximal_energy_label_.clear();
+    }
+
+    bool particle_energy_ordering::has_energies() const
+    {
+      return _has_energies_;
+    }
+
+    double particle_energy_ordering::get_minimal_energy() const
+    {
+      return _minimal_energy_;
+    }
+
+    double particle_energy_ordering::get_maximal_energy() const
+    {
+      return _maximal_energy_;
+    }
+
+    double particle_energy_ordering::get_energy_sum() const
+    {
+      return _energy_sum_;
+    }
+
+    double particle_energy_ordering::get_energy_difference() const
+    {
+      return _energy_difference_;
+    }
+
+    const std::string & particle_energy_ordering::get_minimal_energy_label() const
+    {
+      return _minimal_energy_label_;
+    }
+
+    const std::string & particle_energy_ordering::get_maximal_energy_label() const
+    {
+      return _maximal_energy_label_;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,93 @@
+/// \file falaise/snemo/datamodels/particle_energy_ordering.h
+/*
+ * Description: Energies of two particles of a topology pattern, ordered once
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_PARTICLE_ENERGY_ORDERING_H
+#define FALAISE_SNEMO_DATAMODEL_PARTICLE_ENERGY_ORDERING_H 1
+
+// Standard library:
+#include <atomic>
+#include <string>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    class base_topology_pattern;
+
+    /// \brief Energies of two particles of a topology pattern, ordered once
+    ///
+    /// The 'energy_<label>' measurements of both particles are read once and
+    /// the derived quantities are kept in plain fields. When energies are
+    /// equal, the second particle is the minimal energy one. Copies are not
+    /// computed, as the ordering belongs to the source pattern.
+    class particle_energy_ordering
+    {
+    public:
+      /// Constructor
+      particle_energy_ordering();
+
+      /// Copy constructor, the copy being not computed
+      particle_energy_ordering(const particle_energy_ordering &);
+
+      /// Assignment operator, the ordering being not computed anymore
+      particle_energy_ordering & operator=(const particle_energy_ordering &);
+
+      /// Check if the ordering has been computed
+      bool is_computed() const;
+
+      /// Read the energies of the particles with the given labels
+      void compute(const base_topology_pattern & pattern_,
+                   const std::string & label1_,
+                   const std::string & label2_);
+
+      /// Forget the ordering
+      void reset();
+
+      /// Check if both energies have been measured
+      bool has_energies() const;
+
+      /// Return the minimal energy
+      double get_minimal_energy() const;
+
+      /// Return the maximal energy
+      double get_maximal_energy() const;
+
+      /// Return the energy sum
+      double get_energy_sum() const;
+
+      /// Return the energy difference
+      double get_energy_difference() const;
+
+      /// Return the label of the minimal energy particle
+      const std::string & get_minimal_energy_label() const;
+
+      /// Return the label of the maximal energy particle
+      const std::string & get_maximal_energy_label() const;
+
+    private:
+
+      std::atomic<bool> _computed_;       //!< Computation flag
+      bool _has_energies_;                //!< Energies availability
+      double _minimal_energy_;            //!< Minimal energy
+      double _maximal_energy_;            //!< Maximal energy
+      double _energy_sum_;                //!< Energy sum
+      double _energy_difference_;         //!< Energy difference
+      std::string _minimal_energy_label_; //!< Label of the minimal energy particle
+      std::string _maximal_energy_label_; //!< Label of the maximal energy particle
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_PARTICLE_ENERGY_ORDERING_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -61,6 +61,10 @@ BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_2p_pattern)
 DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::topology_2eNg_pattern)
 BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_2eNg_pattern)
 
+#include <falaise/snemo/datamodels/topology_generic_pattern.ipp>
+DATATOOLS_SERIALIZATION_CLASS_SERIALIZE_INSTANTIATE_ALL(snemo::datamodel::topology_generic_pattern)
+BOOST_CLASS_EXPORT_IMPLEMENT(snemo::datamodel::topology_generic_pattern)
+
 /***********************************
  * snemo::datamodel::topology_data *
  ***********************************/
@@ -13,6 +13,7 @@
 #include <falaise/snemo/datamodels/topology_1eNg_pattern.ipp>
 #include <falaise/snemo/datamodels/topology_2eNg_pattern.ipp>
 #include <falaise/snemo/datamodels/topology_1e1a_pattern.ipp>
+#include <falaise/snemo/datamodels/topology_generic_pattern.ipp>
 
 #include <falaise/snemo/datamodels/topology_data.ipp>
 
@@ -35,6 +35,29 @@ namespace snemo {
     {
     }
 
+    void topology_1e1a_pattern::finalize()
+    {
+      topology_1e_pattern::finalize();
+      _measurement_slots_.resolve(*this);
+    }
+
+    void topology_1e1a_pattern::_reset_derived_()
+    {
+      topology_1e_pattern::_reset_derived_();
+      _measurement_slots_.reset();
+    }
+
+    const schema::measurement_slots<topology_1e1a_pattern::schema_type> & topology_1e1a_pattern::_get_measurement_slots_() const
+    {
+      if (! _measurement_slots_.is_resolved()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _measurement_slots_.is_resolved()) {
+          _measurement_slots_.resolve(*this);
+        }
+      }
+      return _measurement_slots_;
+    }
+
     bool topology_1e1a_pattern::has_alpha_track() const
     {
       return has_particle_track("a1");
@@ -47,35 +70,35 @@ namespace snemo {
 
     bool topology_1e1a_pattern::has_alpha_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_a1");
+      return _get_measurement_slots_().has<schema::angle<schema::a1> >();
     }
 
     double topology_1e1a_pattern::get_alpha_angle() const
     {
       DT_THROW_IF(! has_alpha_angle(), std::logic_error, "No alpha angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_a1").get_angle();
+      return _get_measurement_slots_().get<schema::angle<schema::a1> >().get_angle();
     }
 
     bool topology_1e1a_pattern::has_electron_alpha_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_a1");
+      return _get_measurement_slots_().has<schema::angle<schema::e1, schema::a1> >();
     }
 
     double topology_1e1a_pattern::get_electron_alpha_angle() const
     {
       DT_THROW_IF(! has_electron_alpha_angle(), std::logic_error, "No electron-alpha angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_a1").get_angle();
+      return _get_measurement_slots_().get<schema::angle<schema::e1, schema::a1> >().get_angle();
     }
 
     bool topology_1e1a_pattern::has_electron_alpha_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_a1");
+      return _get_measurement_slots_().has<schema::vertex<schema::e1, schema::a1> >();
     }
 
     double topology_1e1a_pattern::get_electron_alpha_vertices_probability() const
     {
       DT_THROW_IF(! has_electron_alpha_vertices_probability(), std::logic_error, "No common electron-alpha vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_a1").get_probability();
+      return _get_measurement_slots_().get<schema::vertex<schema::e1, schema::a1> >().get_probability();
     }
 
     double topology_1e1a_pattern::get_alpha_delayed_time() const
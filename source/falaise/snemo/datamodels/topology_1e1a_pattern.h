@@ -14,6 +14,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/topology_1e_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
 
 namespace snemo {
 
@@ -23,6 +24,15 @@ namespace snemo {
     class topology_1e1a_pattern : public topology_1e_pattern
     {
     public:
+      /// Particles and measurements of the topology
+      typedef schema::topology_schema<
+        schema::particle_list<schema::e1, schema::a1>,
+        schema::measurement_list<schema::angle<schema::e1>,
+                                 schema::energy<schema::e1>,
+                                 schema::angle<schema::a1>,
+                                 schema::angle<schema::e1, schema::a1>,
+                                 schema::vertex<schema::e1, schema::a1> > > schema_type;
+
       /// Static function to return pattern identifier of the pattern
       static const std::string & pattern_id();
 
@@ -36,6 +46,9 @@ namespace snemo {
       /// Return pattern identifier of the pattern
       virtual std::string get_pattern_id() const;
 
+      /// Resolve the measurement slots
+      virtual void finalize();
+
       /// Check alpha track availability
       bool has_alpha_track() const;
 
@@ -66,8 +79,20 @@ namespace snemo {
       /// Get alpha track length
       double get_alpha_track_length() const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      virtual void _reset_derived_();
+
     private:
 
+      /// Return the measurements of the schema, resolved on first use if not finalized
+      const schema::measurement_slots<schema_type> & _get_measurement_slots_() const;
+
+    private:
+
+      mutable schema::measurement_slots<schema_type> _measurement_slots_; //!< Measurements of the schema (transient)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
@@ -38,6 +38,42 @@ namespace snemo {
     {
     }
 
+    void topology_1e1p_pattern::finalize()
+    {
+      topology_1e_pattern::finalize();
+      _measurement_slots_.resolve(*this);
+      _electron_positron_energies_.compute(*this, "e1", "p1");
+    }
+
+    void topology_1e1p_pattern::_reset_derived_()
+    {
+      topology_1e_pattern::_reset_derived_();
+      _measurement_slots_.reset();
+      _electron_positron_energies_.reset();
+    }
+
+    const schema::measurement_slots<topology_1e1p_pattern::schema_type> & topology_1e1p_pattern::_get_measurement_slots_() const
+    {
+      if (! _measurement_slots_.is_resolved()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _measurement_slots_.is_resolved()) {
+          _measurement_slots_.resolve(*this);
+        }
+      }
+      return _measurement_slots_;
+    }
+
+    const particle_energy_ordering & topology_1e1p_pattern::_get_electron_positron_energies_() const
+    {
+      if (! _electron_positron_energies_.is_computed()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _electron_positron_energies_.is_computed()) {
+          _electron_positron_energies_.compute(*this, "e1", "p1");
+        }
+      }
+      return _electron_positron_energies_;
+    }
+
     bool topology_1e1p_pattern::has_positron_track() const
     {
       return has_particle_track("p1");
@@ -50,95 +86,90 @@ namespace snemo {
 
     bool topology_1e1p_pattern::has_positron_energy() const
     {
-      return has_measurement_as<snemo::datamodel::energy_measurement>("energy_p1");
+      return _get_measurement_slots_().has<schema::energy<schema::p1> >();
     }
 
     double topology_1e1p_pattern::get_positron_energy() const
     {
       DT_THROW_IF(! has_positron_energy(), std::logic_error, "No positron energy measurement stored !");
-      return get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy();
+      return _get_measurement_slots_().get<schema::energy<schema::p1> >().get_energy();
     }
 
     bool topology_1e1p_pattern::has_positron_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_p1");
+      return _get_measurement_slots_().has<schema::angle<schema::p1> >();
     }
 
     double topology_1e1p_pattern::get_positron_angle() const
     {
       DT_THROW_IF(! has_positron_angle(), std::logic_error, "No positron angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_p1").get_angle();
+      return _get_measurement_slots_().get<schema::angle<schema::p1> >().get_angle();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_p1");
+      return _get_measurement_slots_().has<schema::angle<schema::e1, schema::p1> >();
     }
 
     double topology_1e1p_pattern::get_electron_positron_angle() const
     {
       DT_THROW_IF(! has_electron_positron_angle(), std::logic_error, "No electron-positron angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_p1").get_angle();
+      return _get_measurement_slots_().get<schema::angle<schema::e1, schema::p1> >().get_angle();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_internal_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1");
+      return _get_measurement_slots_().has<schema::tof<schema::e1, schema::p1> >();
     }
 
     double topology_1e1p_pattern::get_electron_positron_internal_probability() const
     {
       DT_THROW_IF(! has_electron_positron_internal_probability(), std::logic_error, "No electron-positron TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1").get_internal_probabilities().front();
+      return _get_measurement_slots_().get<schema::tof<schema::e1, schema::p1> >().get_internal_probabilities().front();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_external_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1");
+      return _get_measurement_slots_().has<schema::tof<schema::e1, schema::p1> >();
     }
 
     double topology_1e1p_pattern::get_electron_positron_external_probability() const
     {
       DT_THROW_IF(! has_electron_positron_external_probability(), std::logic_error, "No electron-positron TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_p1").get_external_probabilities().front();
+      return _get_measurement_slots_().get<schema::tof<schema::e1, schema::p1> >().get_external_probabilities().front();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1");
+      return _get_measurement_slots_().has<schema::vertex<schema::e1, schema::p1> >();
     }
 
     double topology_1e1p_pattern::get_electron_positron_vertices_probability() const
     {
       DT_THROW_IF(! has_electron_positron_vertices_probability(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_p1").get_probability();
+      return _get_measurement_slots_().get<schema::vertex<schema::e1, schema::p1> >().get_probability();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_minimal_energy() const
     {
-      return has_measurement("energy_e1") && has_measurement("energy_p1");
+      return _get_electron_positron_energies_().has_energies();
     }
 
     double topology_1e1p_pattern::get_electron_positron_minimal_energy() const
     {
       DT_THROW_IF(! has_electron_positron_minimal_energy(), std::logic_error, "No electron/positron minimal energy measurement stored !");
-      //bien dégueulasse
-      return std::min(dynamic_cast<const snemo::datamodel::energy_measurement&> (get_measurement("energy_e1")).get_energy(),
-                      dynamic_cast<const snemo::datamodel::energy_measurement&> (get_measurement("energy_p1")).get_energy());
+      return _get_electron_positron_energies_().get_minimal_energy();
     }
 
     bool topology_1e1p_pattern::has_electron_positron_maximal_energy() const
     {
-      return
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_e1") &&
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_p1");
+      return _get_electron_positron_energies_().has_energies();
     }
 
     double topology_1e1p_pattern::get_electron_positron_maximal_energy() const
     {
       DT_THROW_IF(! has_electron_positron_maximal_energy(), std::logic_error, "No electron/positron maximal energy measurement stored !");
-      return std::max(get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy());
+      return _get_electron_positron_energies_().get_maximal_energy();
     }
 
     double topology_1e1p_pattern::get_positron_track_length() const
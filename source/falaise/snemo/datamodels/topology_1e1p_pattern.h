@@ -14,6 +14,8 @@
 
 // This project:
 #include <falaise/snemo/datamodels/topology_1e_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
+#include <falaise/snemo/datamodels/particle_energy_ordering.h>
 
 namespace snemo {
 
@@ -23,6 +25,17 @@ namespace snemo {
     class topology_1e1p_pattern : public topology_1e_pattern
     {
     public:
+      /// Particles and measurements of the topology
+      typedef schema::topology_schema<
+        schema::particle_list<schema::e1, schema::p1>,
+        schema::measurement_list<schema::angle<schema::e1>,
+                                 schema::energy<schema::e1>,
+                                 schema::angle<schema::p1>,
+                                 schema::angle<schema::e1, schema::p1>,
+                                 schema::energy<schema::p1>,
+                                 schema::tof<schema::e1, schema::p1>,
+                                 schema::vertex<schema::e1, schema::p1> > > schema_type;
+
       /// Static function to return pattern identifier of the pattern
       static const std::string & pattern_id();
 
@@ -36,6 +49,9 @@ namespace snemo {
       /// Return pattern identifier of the pattern
       virtual std::string get_pattern_id() const;
 
+      /// Order the particle energies
+      virtual void finalize();
+
       /// Check positron track availability
       bool has_positron_track() const;
 
@@ -93,8 +109,24 @@ namespace snemo {
       /// Get electron track length
       double get_positron_track_length() const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      virtual void _reset_derived_();
+
     private:
 
+      /// Return the measurements of the schema, resolved on first use if not finalized
+      const schema::measurement_slots<schema_type> & _get_measurement_slots_() const;
+
+      /// Return the particle energies, ordered on first use if not finalized
+      const particle_energy_ordering & _get_electron_positron_energies_() const;
+
+    private:
+
+      mutable particle_energy_ordering _electron_positron_energies_; //!< Electron and positron energies (transient)
+      mutable schema::measurement_slots<schema_type> _measurement_slots_; //!< Measurements of the schema (transient)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
@@ -24,6 +24,10 @@ namespace snemo {
     void topology_1e1p_pattern::serialize(Archive & ar_, const unsigned int /* version */)
     {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(topology_1e_pattern);
+      if (Archive::is_loading::value) {
+        _electron_positron_energies_.reset();
+        _measurement_slots_.reset();
+      }
       return;
     }
 
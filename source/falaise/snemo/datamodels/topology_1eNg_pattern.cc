@@ -43,6 +43,7 @@ namespace snemo {
     void topology_1eNg_pattern::set_number_of_gammas(const size_t ngammas_)
     {
       _number_of_gammas_ = ngammas_;
+      _gamma_views_.clear();
     }
 
     size_t topology_1eNg_pattern::get_number_of_gammas() const
@@ -50,6 +51,29 @@ namespace snemo {
       return _number_of_gammas_;
     }
 
+    const gamma_measurement_views & topology_1eNg_pattern::get_gamma_views() const
+    {
+      if (! _gamma_views_.is_built()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _gamma_views_.is_built()) {
+          _gamma_views_.build(*this, {"e1"}, get_number_of_gammas());
+        }
+      }
+      return _gamma_views_;
+    }
+
+    void topology_1eNg_pattern::_reset_derived_()
+    {
+      topology_1e_pattern::_reset_derived_();
+      _gamma_views_.clear();
+    }
+
+    void topology_1eNg_pattern::finalize()
+    {
+      topology_1e_pattern::finalize();
+      _gamma_views_.build(*this, {"e1"}, get_number_of_gammas());
+    }
+
     bool topology_1eNg_pattern::has_gammas_energies() const
     {
       return has_measurement("energy_g[0-9]+");
@@ -59,14 +83,13 @@ namespace snemo {
     {
       DT_THROW_IF(! has_gammas_energies(), std::logic_error,
                   "No gammas energy measurement stored !");
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        std::ostringstream oss;
-        oss << "energy_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' energy measurement !");
-        auto a_energy_meas = get_measurement_as<snemo::datamodel::energy_measurement>(oss.str());
-        energies_.push_back(a_energy_meas.get_energy());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_energy(ig), std::logic_error,
+                    "Missing 'energy_g" << ig + 1 << "' energy measurement !");
       }
+      const gamma_measurement_views::range the_energies = the_views.get_energies();
+      energies_.insert(energies_.end(), the_energies.begin(), the_energies.end());
     }
 
     bool topology_1eNg_pattern::has_electron_gammas_tof_probabilities() const
@@ -78,26 +101,27 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_gammas_tof_probabilities(), std::logic_error,
                   "No electron-gammas TOF measurement stored !");
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        std::ostringstream oss;
-        oss << "tof_e1_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-        auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-        eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      const size_t ie = the_views.get_charged_index("e1");
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                    "Missing 'tof_e1_g" << ig + 1 << "' TOF measurement !");
+        const gamma_measurement_views::range the_probabilities = the_views.get_internal_probabilities(ie, ig);
+        eg_pint_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
       }
     }
 
     void topology_1eNg_pattern::fetch_electron_gammas_external_probabilities(topology_1eNg_pattern::tof_collection_type & eg_pext_) const
     {
-      DT_THROW_IF(! has_electron_gammas_tof_probabilities(), std::logic_error, "No electron-gammas TOF measurement stored !");
-      for(size_t ig = 1; ig <= get_number_of_gammas(); ++ig) {
-        std::ostringstream oss;
-        oss << "tof_e1_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-        auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-        eg_pext_.push_back(a_tof_meas.get_external_probabilities());
+      DT_THROW_IF(! has_electron_gammas_tof_probabilities(), std::logic_error,
+                  "No electron-gammas TOF measurement stored !");
+      const gamma_measurement_views & the_views = get_gamma_views();
+      const size_t ie = the_views.get_charged_index("e1");
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                    "Missing 'tof_e1_g" << ig + 1 << "' TOF measurement !");
+        const gamma_measurement_views::range the_probabilities = the_views.get_external_probabilities(ie, ig);
+        eg_pext_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
       }
     }
 
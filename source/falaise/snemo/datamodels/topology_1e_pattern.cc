@@ -35,6 +35,29 @@ namespace snemo {
     {
     }
 
+    void topology_1e_pattern::finalize()
+    {
+      base_topology_pattern::finalize();
+      _measurement_slots_.resolve(*this);
+    }
+
+    void topology_1e_pattern::_reset_derived_()
+    {
+      base_topology_pattern::_reset_derived_();
+      _measurement_slots_.reset();
+    }
+
+    const schema::measurement_slots<topology_1e_pattern::schema_type> & topology_1e_pattern::_get_measurement_slots_() const
+    {
+      if (! _measurement_slots_.is_resolved()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _measurement_slots_.is_resolved()) {
+          _measurement_slots_.resolve(*this);
+        }
+      }
+      return _measurement_slots_;
+    }
+
     bool topology_1e_pattern::has_electron_track() const
     {
       return has_particle_track("e1");
@@ -47,24 +70,24 @@ namespace snemo {
 
     bool topology_1e_pattern::has_electron_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_e1");
+      return _get_measurement_slots_().has<schema::angle<schema::e1> >();
     }
 
     double topology_1e_pattern::get_electron_angle() const
     {
       DT_THROW_IF(! has_electron_angle(), std::logic_error, "No electron angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_e1").get_angle();
+      return _get_measurement_slots_().get<schema::angle<schema::e1> >().get_angle();
     }
 
     bool topology_1e_pattern::has_electron_energy() const
     {
-      return has_measurement_as<snemo::datamodel::energy_measurement>("energy_e1");
+      return _get_measurement_slots_().has<schema::energy<schema::e1> >();
     }
 
     double topology_1e_pattern::get_electron_energy() const
     {
       DT_THROW_IF(! has_electron_energy(), std::logic_error, "No electron energy measurement stored !");
-      return get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy();
+      return _get_measurement_slots_().get<schema::energy<schema::e1> >().get_energy();
     }
 
     double topology_1e_pattern::get_electron_track_length() const
@@ -11,6 +11,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
 
 namespace snemo {
 
@@ -20,6 +21,12 @@ namespace snemo {
     class topology_1e_pattern : public base_topology_pattern
     {
     public:
+      /// Particles and measurements of the topology
+      typedef schema::topology_schema<
+        schema::particle_list<schema::e1>,
+        schema::measurement_list<schema::angle<schema::e1>,
+                                 schema::energy<schema::e1> > > schema_type;
+
       /// Static function to return pattern identifier of the pattern
       static const std::string & pattern_id();
 
@@ -33,6 +40,9 @@ namespace snemo {
       /// Return pattern identifier of the pattern
       virtual std::string get_pattern_id() const;
 
+      /// Resolve the measurement slots
+      virtual void finalize();
+
       /// Check electron track availability
       bool has_electron_track() const;
 
@@ -54,8 +64,20 @@ namespace snemo {
       /// Get electron track length
       double get_electron_track_length() const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      virtual void _reset_derived_();
+
     private:
 
+      /// Return the measurements of the schema, resolved on first use if not finalized
+      const schema::measurement_slots<schema_type> & _get_measurement_slots_() const;
+
+    private:
+
+      mutable schema::measurement_slots<schema_type> _measurement_slots_; //!< Measurements of the schema (transient)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
@@ -24,6 +24,9 @@ namespace snemo {
     void topology_1e_pattern::serialize(Archive & ar_, const unsigned int /* version */)
     {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_topology_pattern);
+      if (Archive::is_loading::value) {
+        _measurement_slots_.reset();
+      }
       return;
     }
 
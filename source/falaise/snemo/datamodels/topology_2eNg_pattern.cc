@@ -42,6 +42,7 @@ namespace snemo {
     void topology_2eNg_pattern::set_number_of_gammas(const size_t ngammas_)
     {
       _number_of_gammas_ = ngammas_;
+      _gamma_views_.clear();
     }
 
     size_t topology_2eNg_pattern::get_number_of_gammas() const
@@ -49,6 +50,29 @@ namespace snemo {
       return _number_of_gammas_;
     }
 
+    const gamma_measurement_views & topology_2eNg_pattern::get_gamma_views() const
+    {
+      if (! _gamma_views_.is_built()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _gamma_views_.is_built()) {
+          _gamma_views_.build(*this, {"e1", "e2"}, get_number_of_gammas());
+        }
+      }
+      return _gamma_views_;
+    }
+
+    void topology_2eNg_pattern::_reset_derived_()
+    {
+      topology_2e_pattern::_reset_derived_();
+      _gamma_views_.clear();
+    }
+
+    void topology_2eNg_pattern::finalize()
+    {
+      topology_2e_pattern::finalize();
+      _gamma_views_.build(*this, {"e1", "e2"}, get_number_of_gammas());
+    }
+
     bool topology_2eNg_pattern::has_gammas_energies() const
     {
       return has_measurement("energy_g[0-9]+");
@@ -58,14 +82,13 @@ namespace snemo {
     {
       DT_THROW_IF(! has_gammas_energies(), std::logic_error,
                   "No gamma energy measurement stored !");
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        std::ostringstream oss;
-        oss << "energy_g" << ig;
-        DT_THROW_IF(! has_measurement_as<snemo::datamodel::energy_measurement>(oss.str()),
-                    std::logic_error, "Missing '" << oss.str() << "' energy measurement !");
-        auto a_energy_meas = get_measurement_as<snemo::datamodel::energy_measurement>(oss.str());
-        g_energies_.push_back(a_energy_meas.get_energy());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_energy(ig), std::logic_error,
+                    "Missing 'energy_g" << ig + 1 << "' energy measurement !");
       }
+      const gamma_measurement_views::range the_energies = the_views.get_energies();
+      g_energies_.insert(g_energies_.end(), the_energies.begin(), the_energies.end());
     }
 
     bool topology_2eNg_pattern::has_electrons_gammas_tof_probabilities() const
@@ -77,14 +100,13 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electrons_gammas_tof_probabilities(), std::logic_error,
                   "No electrons-gammas TOF measurement stored !");
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        for (size_t ie = 1; ie <= 2; ie++) {
-          std::ostringstream oss;
-          oss << "tof_e" << ie << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-          auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-          eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        for (size_t ie = 0; ie < 2; ie++) {
+          DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                      "Missing 'tof_e" << ie + 1 << "_g" << ig + 1 << "' TOF measurement !");
+          const gamma_measurement_views::range the_probabilities = the_views.get_internal_probabilities(ie, ig);
+          eg_pint_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
         }
       }
     }
@@ -93,14 +115,13 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electrons_gammas_tof_probabilities(), std::logic_error,
                   "No electrons-gammas TOF measurement stored !");
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-        for (size_t ie = 1; ie <= 2; ie++) {
-          std::ostringstream oss;
-          oss << "tof_e" << ie << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-          auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-          eg_pext_.push_back(a_tof_meas.get_external_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        for (size_t ie = 0; ie < 2; ie++) {
+          DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                      "Missing 'tof_e" << ie + 1 << "_g" << ig + 1 << "' TOF measurement !");
+          const gamma_measurement_views::range the_probabilities = the_views.get_external_probabilities(ie, ig);
+          eg_pext_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
         }
       }
     }
@@ -117,14 +138,14 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_min_gammas_tof_probabilities(), std::logic_error,
                   "No electron_min-gammas TOF measurement stored !");
-      std::string e_min = get_minimal_energy_electron_name();
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_min << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-          auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-          eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      const std::string e_min = get_minimal_energy_electron_name();
+      const size_t ie = the_views.get_charged_index(e_min);
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                    "Missing 'tof_" << e_min << "_g" << ig + 1 << "' TOF measurement !");
+        const gamma_measurement_views::range the_probabilities = the_views.get_internal_probabilities(ie, ig);
+        eg_pint_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
       }
     }
 
@@ -132,14 +153,14 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_min_gammas_tof_probabilities(), std::logic_error,
                   "No electron_min-gammas TOF measurement stored !");
-      std::string e_min = get_minimal_energy_electron_name();
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_min << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-          auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-          eg_pext_.push_back(a_tof_meas.get_external_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      const std::string e_min = get_minimal_energy_electron_name();
+      const size_t ie = the_views.get_charged_index(e_min);
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                    "Missing 'tof_" << e_min << "_g" << ig + 1 << "' TOF measurement !");
+        const gamma_measurement_views::range the_probabilities = the_views.get_external_probabilities(ie, ig);
+        eg_pext_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
       }
     }
 
@@ -155,14 +176,14 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_max_gammas_tof_probabilities(), std::logic_error,
                   "No electron_max-gammas TOF measurement stored !");
-      std::string e_max = get_maximal_energy_electron_name();
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_max << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-          auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-          eg_pint_.push_back(a_tof_meas.get_internal_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      const std::string e_max = get_maximal_energy_electron_name();
+      const size_t ie = the_views.get_charged_index(e_max);
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                    "Missing 'tof_" << e_max << "_g" << ig + 1 << "' TOF measurement !");
+        const gamma_measurement_views::range the_probabilities = the_views.get_internal_probabilities(ie, ig);
+        eg_pint_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
       }
     }
 
@@ -170,14 +191,14 @@ namespace snemo {
     {
       DT_THROW_IF(! has_electron_max_gammas_tof_probabilities(), std::logic_error,
                   "No electron_max-gammas TOF measurement stored !");
-      std::string e_max = get_maximal_energy_electron_name();
-      for (size_t ig = 1; ig <= get_number_of_gammas(); ig++) {
-          std::ostringstream oss;
-          oss << "tof_" << e_max << "_g" << ig;
-          DT_THROW_IF(! has_measurement_as<snemo::datamodel::tof_measurement>(oss.str()),
-                      std::logic_error, "Missing '" << oss.str() << "' TOF measurement !");
-          auto a_tof_meas = get_measurement_as<snemo::datamodel::tof_measurement>(oss.str());
-          eg_pext_.push_back(a_tof_meas.get_external_probabilities());
+      const gamma_measurement_views & the_views = get_gamma_views();
+      const std::string e_max = get_maximal_energy_electron_name();
+      const size_t ie = the_views.get_charged_index(e_max);
+      for (size_t ig = 0; ig < the_views.get_number_of_gammas(); ig++) {
+        DT_THROW_IF(! the_views.has_tof(ie, ig), std::logic_error,
+                    "Missing 'tof_" << e_max << "_g" << ig + 1 << "' TOF measurement !");
+        const gamma_measurement_views::range the_probabilities = the_views.get_external_probabilities(ie, ig);
+        eg_pext_.push_back(tof_measurement::probability_type(the_probabilities.begin(), the_probabilities.end()));
       }
     }
 
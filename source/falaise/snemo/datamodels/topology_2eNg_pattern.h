@@ -13,6 +13,7 @@
 #include <falaise/snemo/datamodels/topology_2e_pattern.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
 #include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/gamma_measurement_views.h>
 
 namespace snemo {
 
@@ -50,6 +51,16 @@ namespace snemo {
       /// Return internal probability
       size_t get_number_of_gammas() const;
 
+      /// Return the per-gamma measurements gathered in contiguous arrays
+      ///
+      /// Views are built when the pattern is finalized, or on first call,
+      /// and are built again once the measurements have been handed out for
+      /// changes.
+      const gamma_measurement_views & get_gamma_views() const;
+
+      /// Gather the per-gamma measurements
+      virtual void finalize();
+
       /// Check gammas energies existence
       bool has_gammas_energies() const;
 
@@ -83,9 +94,15 @@ namespace snemo {
       /// Fetch the electron_max-gammas external TOF probability
       void fetch_electron_max_gammas_external_probabilities(tof_collection_type & eg_pext_) const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      virtual void _reset_derived_();
+
     private:
 
       size_t _number_of_gammas_;//!< Number of gamma in the topology
+      mutable gamma_measurement_views _gamma_views_; //!< Per-gamma measurements (transient)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
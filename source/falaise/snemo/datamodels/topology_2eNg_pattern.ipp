@@ -25,6 +25,9 @@ namespace snemo {
     {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(topology_2e_pattern);
       ar_ & boost::serialization::make_nvp("number_of_gammas", _number_of_gammas_);
+      if (Archive::is_loading::value) {
+        _gamma_views_.clear();
+      }
       return;
     }
 
@@ -38,11 +38,45 @@ namespace snemo {
     {
     }
 
+    void topology_2e_pattern::finalize()
+    {
+      base_topology_pattern::finalize();
+      _measurement_slots_.resolve(*this);
+      _electrons_energies_.compute(*this, "e1", "e2");
+    }
+
+    void topology_2e_pattern::_reset_derived_()
+    {
+      base_topology_pattern::_reset_derived_();
+      _measurement_slots_.reset();
+      _electrons_energies_.reset();
+    }
+
+    const schema::measurement_slots<topology_2e_pattern::schema_type> & topology_2e_pattern::_get_measurement_slots_() const
+    {
+      if (! _measurement_slots_.is_resolved()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _measurement_slots_.is_resolved()) {
+          _measurement_slots_.resolve(*this);
+        }
+      }
+      return _measurement_slots_;
+    }
+
+    const particle_energy_ordering & topology_2e_pattern::_get_electrons_energies_() const
+    {
+      if (! _electrons_energies_.is_computed()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _electrons_energies_.is_computed()) {
+          _electrons_energies_.compute(*this, "e1", "e2");
+        }
+      }
+      return _electrons_energies_;
+    }
+
     bool topology_2e_pattern::has_electrons_energy() const
     {
-      return
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_e1") &&
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_e2");
+      return _get_electrons_energies_().has_energies();
     }
 
     bool topology_2e_pattern::has_electron_minimal_energy() const
@@ -53,8 +87,7 @@ namespace snemo {
     double topology_2e_pattern::get_electron_minimal_energy() const
     {
       DT_THROW_IF(! has_electron_minimal_energy(), std::logic_error, "No electron minimal energy measurement stored !");
-      return std::min(get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy());
+      return _get_electrons_energies_().get_minimal_energy();
     }
 
     bool topology_2e_pattern::has_electron_maximal_energy() const
@@ -65,82 +98,75 @@ namespace snemo {
     double topology_2e_pattern::get_electron_maximal_energy() const
     {
       DT_THROW_IF(! has_electron_maximal_energy(), std::logic_error, "No electron maximal energy measurement stored !");
-      return std::max(get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy());
+      return _get_electrons_energies_().get_maximal_energy();
     }
 
     double topology_2e_pattern::get_electrons_energy_sum() const
     {
       DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
-      return get_electron_minimal_energy() + get_electron_maximal_energy();
+      return _get_electrons_energies_().get_energy_sum();
     }
 
     double topology_2e_pattern::get_electrons_energy_difference() const
     {
       DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
-      return get_electron_maximal_energy() - get_electron_minimal_energy();
+      return _get_electrons_energies_().get_energy_difference();
     }
 
     std::string topology_2e_pattern::get_minimal_energy_electron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy())
-        return "e1";
-      else
-        return "e2";
+      DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
+      return _get_electrons_energies_().get_minimal_energy_label();
     }
 
     std::string topology_2e_pattern::get_maximal_energy_electron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_e1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_e2").get_energy())
-        return "e2";
-      else
-        return "e1";
+      DT_THROW_IF(! has_electrons_energy(), std::logic_error, "No electron energy measurement stored !");
+      return _get_electrons_energies_().get_maximal_energy_label();
     }
 
     bool topology_2e_pattern::has_electrons_internal_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2");
+      return _get_measurement_slots_().has<schema::tof<schema::e1, schema::e2> >();
     }
 
     double topology_2e_pattern::get_electrons_internal_probability() const
     {
       DT_THROW_IF(! has_electrons_internal_probability(), std::logic_error, "No electrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2").get_internal_probabilities().front();
+      return _get_measurement_slots_().get<schema::tof<schema::e1, schema::e2> >().get_internal_probabilities().front();
     }
 
     bool topology_2e_pattern::has_electrons_external_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2");
+      return _get_measurement_slots_().has<schema::tof<schema::e1, schema::e2> >();
     }
 
     double topology_2e_pattern::get_electrons_external_probability() const
     {
       DT_THROW_IF(! has_electrons_external_probability(), std::logic_error, "No electrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_e1_e2").get_external_probabilities().front();
+      return _get_measurement_slots_().get<schema::tof<schema::e1, schema::e2> >().get_external_probabilities().front();
     }
 
     bool topology_2e_pattern::has_electrons_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_e2");
+      return _get_measurement_slots_().has<schema::angle<schema::e1, schema::e2> >();
     }
 
     double topology_2e_pattern::get_electrons_angle() const
     {
-      DT_THROW_IF(! has_electrons_external_probability(), std::logic_error, "No electrons angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_e1_e2").get_angle();
+      DT_THROW_IF(! has_electrons_angle(), std::logic_error, "No electrons angle measurement stored !");
+      return _get_measurement_slots_().get<schema::angle<schema::e1, schema::e2> >().get_angle();
     }
 
     bool topology_2e_pattern::has_electrons_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2");
+      return _get_measurement_slots_().has<schema::vertex<schema::e1, schema::e2> >();
     }
 
     double topology_2e_pattern::get_electrons_vertices_probability() const
     {
       DT_THROW_IF(! has_electrons_vertices_probability(), std::logic_error, "No common electrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_e1_e2").get_probability();
+      return _get_measurement_slots_().get<schema::vertex<schema::e1, schema::e2> >().get_probability();
     }
 
     // std::string topology_2e_pattern::get_electrons_vertices_location() const
@@ -11,6 +11,8 @@
 
 // This project:
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
+#include <falaise/snemo/datamodels/particle_energy_ordering.h>
 
 namespace snemo {
 
@@ -20,6 +22,15 @@ namespace snemo {
     class topology_2e_pattern : public base_topology_pattern
     {
     public:
+      /// Particles and measurements of the topology
+      typedef schema::topology_schema<
+        schema::particle_list<schema::e1, schema::e2>,
+        schema::measurement_list<schema::tof<schema::e1, schema::e2>,
+                                 schema::vertex<schema::e1, schema::e2>,
+                                 schema::angle<schema::e1, schema::e2>,
+                                 schema::energy<schema::e1>,
+                                 schema::energy<schema::e2> > > schema_type;
+
       /// Static function to return pattern identifier of the pattern
       static const std::string & pattern_id();
 
@@ -34,6 +45,9 @@ namespace snemo {
       /// Return pattern identifier of the pattern
       virtual std::string get_pattern_id() const;
 
+      /// Order the particle energies
+      virtual void finalize();
+
       /// Check electron minimal energy validity
       bool has_electron_minimal_energy() const;
 
@@ -88,8 +102,24 @@ namespace snemo {
       // /// Get common vertices location between electrons
       // std::string get_electrons_vertices_location() const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      virtual void _reset_derived_();
+
     private:
 
+      /// Return the measurements of the schema, resolved on first use if not finalized
+      const schema::measurement_slots<schema_type> & _get_measurement_slots_() const;
+
+      /// Return the particle energies, ordered on first use if not finalized
+      const particle_energy_ordering & _get_electrons_energies_() const;
+
+    private:
+
+      mutable particle_energy_ordering _electrons_energies_; //!< Electrons energies (transient)
+      mutable schema::measurement_slots<schema_type> _measurement_slots_; //!< Measurements of the schema (transient)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
@@ -38,11 +38,45 @@ namespace snemo {
     {
     }
 
+    void topology_2p_pattern::finalize()
+    {
+      base_topology_pattern::finalize();
+      _measurement_slots_.resolve(*this);
+      _positrons_energies_.compute(*this, "p1", "p2");
+    }
+
+    void topology_2p_pattern::_reset_derived_()
+    {
+      base_topology_pattern::_reset_derived_();
+      _measurement_slots_.reset();
+      _positrons_energies_.reset();
+    }
+
+    const schema::measurement_slots<topology_2p_pattern::schema_type> & topology_2p_pattern::_get_measurement_slots_() const
+    {
+      if (! _measurement_slots_.is_resolved()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _measurement_slots_.is_resolved()) {
+          _measurement_slots_.resolve(*this);
+        }
+      }
+      return _measurement_slots_;
+    }
+
+    const particle_energy_ordering & topology_2p_pattern::_get_positrons_energies_() const
+    {
+      if (! _positrons_energies_.is_computed()) {
+        std::lock_guard<std::recursive_mutex> lock(_get_measurement_mutex_());
+        if (! _positrons_energies_.is_computed()) {
+          _positrons_energies_.compute(*this, "p1", "p2");
+        }
+      }
+      return _positrons_energies_;
+    }
+
     bool topology_2p_pattern::has_positrons_energy() const
     {
-      return
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_p1") &&
-        has_measurement_as<snemo::datamodel::energy_measurement>("energy_p2");
+      return _get_positrons_energies_().has_energies();
     }
 
     bool topology_2p_pattern::has_positron_minimal_energy() const
@@ -53,8 +87,7 @@ namespace snemo {
     double topology_2p_pattern::get_positron_minimal_energy() const
     {
       DT_THROW_IF(! has_positron_minimal_energy(), std::logic_error, "No positron minimal energy measurement stored !");
-      return std::min(get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy());
+      return _get_positrons_energies_().get_minimal_energy();
     }
 
     bool topology_2p_pattern::has_positron_maximal_energy() const
@@ -65,84 +98,75 @@ namespace snemo {
     double topology_2p_pattern::get_positron_maximal_energy() const
     {
       DT_THROW_IF(! has_positron_maximal_energy(), std::logic_error, "No positron maximal energy measurement stored !");
-      return std::max(get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy(),
-                      get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy());
+      return _get_positrons_energies_().get_maximal_energy();
     }
 
     double topology_2p_pattern::get_positrons_energy_sum() const
     {
-      //Only one energy check
-      DT_THROW_IF(! has_positron_maximal_energy(), std::logic_error, "No positron energy measurement stored !");
-      return get_positron_minimal_energy() + get_positron_maximal_energy();
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _get_positrons_energies_().get_energy_sum();
     }
 
     double topology_2p_pattern::get_positrons_energy_difference() const
     {
-      //Only one energy check
-      DT_THROW_IF(! has_positron_maximal_energy(), std::logic_error, "No positron energy measurement stored !");
-      return get_positron_maximal_energy() - get_positron_minimal_energy();
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _get_positrons_energies_().get_energy_difference();
     }
 
     std::string topology_2p_pattern::get_minimal_energy_positron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy())
-        return "p1";
-      else
-        return "p2";
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _get_positrons_energies_().get_minimal_energy_label();
     }
 
     std::string topology_2p_pattern::get_maximal_energy_positron_name() const
     {
-      if (get_measurement_as<snemo::datamodel::energy_measurement>("energy_p1").get_energy() <
-          get_measurement_as<snemo::datamodel::energy_measurement>("energy_p2").get_energy())
-        return "p2";
-      else
-        return "p1";
+      DT_THROW_IF(! has_positrons_energy(), std::logic_error, "No positron energy measurement stored !");
+      return _get_positrons_energies_().get_maximal_energy_label();
     }
 
     bool topology_2p_pattern::has_positrons_internal_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2");
+      return _get_measurement_slots_().has<schema::tof<schema::p1, schema::p2> >();
     }
 
     double topology_2p_pattern::get_positrons_internal_probability() const
     {
       DT_THROW_IF(! has_positrons_internal_probability(), std::logic_error, "No positrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2").get_internal_probabilities().front();
+      return _get_measurement_slots_().get<schema::tof<schema::p1, schema::p2> >().get_internal_probabilities().front();
     }
 
     bool topology_2p_pattern::has_positrons_external_probability() const
     {
-      return has_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2");
+      return _get_measurement_slots_().has<schema::tof<schema::p1, schema::p2> >();
     }
 
     double topology_2p_pattern::get_positrons_external_probability() const
     {
       DT_THROW_IF(! has_positrons_external_probability(), std::logic_error, "No positrons TOF measurement stored !");
-      return get_measurement_as<snemo::datamodel::tof_measurement>("tof_p1_p2").get_external_probabilities().front();
+      return _get_measurement_slots_().get<schema::tof<schema::p1, schema::p2> >().get_external_probabilities().front();
     }
 
     bool topology_2p_pattern::has_positrons_angle() const
     {
-      return has_measurement_as<snemo::datamodel::angle_measurement>("angle_p1_p2");
+      return _get_measurement_slots_().has<schema::angle<schema::p1, schema::p2> >();
     }
 
     double topology_2p_pattern::get_positrons_angle() const
     {
       DT_THROW_IF(! has_positrons_angle(), std::logic_error, "No positrons angle measurement stored !");
-      return get_measurement_as<snemo::datamodel::angle_measurement>("angle_p1_p2").get_angle();
+      return _get_measurement_slots_().get<schema::angle<schema::p1, schema::p2> >().get_angle();
     }
 
     bool topology_2p_pattern::has_positrons_vertices_probability() const
     {
-      return has_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2");
+      return _get_measurement_slots_().has<schema::vertex<schema::p1, schema::p2> >();
     }
 
     double topology_2p_pattern::get_positrons_vertices_probability() const
     {
       DT_THROW_IF(! has_positrons_vertices_probability(), std::logic_error, "No common positrons vertices measurement stored !");
-      return get_measurement_as<snemo::datamodel::vertex_measurement>("vertex_p1_p2").get_probability();
+      return _get_measurement_slots_().get<schema::vertex<schema::p1, schema::p2> >().get_probability();
     }
 
     // std::string topology_2p_pattern::get_positrons_vertices_location() const
@@ -11,6 +11,8 @@
 
 // This project:
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
+#include <falaise/snemo/datamodels/particle_energy_ordering.h>
 
 namespace snemo {
 
@@ -20,6 +22,15 @@ namespace snemo {
     class topology_2p_pattern : public base_topology_pattern
     {
     public:
+      /// Particles and measurements of the topology
+      typedef schema::topology_schema<
+        schema::particle_list<schema::p1, schema::p2>,
+        schema::measurement_list<schema::tof<schema::p1, schema::p2>,
+                                 schema::vertex<schema::p1, schema::p2>,
+                                 schema::angle<schema::p1, schema::p2>,
+                                 schema::energy<schema::p1>,
+                                 schema::energy<schema::p2> > > schema_type;
+
       /// Static function to return pattern identifier of the pattern
       static const std::string & pattern_id();
 
@@ -33,6 +44,9 @@ namespace snemo {
       /// Return pattern identifier of the pattern
       virtual std::string get_pattern_id() const;
 
+      /// Order the particle energies
+      virtual void finalize();
+
       /// Check positron minimal energy validity
       bool has_positron_minimal_energy() const;
 
@@ -87,8 +101,24 @@ namespace snemo {
       // /// Get common vertices location between positrons
       // std::string get_positrons_vertices_location() const;
 
+    protected:
+
+      /// Reset the quantities derived from the measurements
+      virtual void _reset_derived_();
+
     private:
 
+      /// Return the measurements of the schema, resolved on first use if not finalized
+      const schema::measurement_slots<schema_type> & _get_measurement_slots_() const;
+
+      /// Return the particle energies, ordered on first use if not finalized
+      const particle_energy_ordering & _get_positrons_energies_() const;
+
+    private:
+
+      mutable particle_energy_ordering _positrons_energies_; //!< Positrons energies (transient)
+      mutable schema::measurement_slots<schema_type> _measurement_slots_; //!< Measurements of the schema (transient)
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
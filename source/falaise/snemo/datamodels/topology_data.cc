@@ -14,16 +14,19 @@ namespace snemo {
 
     void topology_data::set_pattern_handle(const handle_pattern & pattern_handle_)
     {
+      clear_cut_results();
       _pattern_ = pattern_handle_;
     }
 
     void topology_data::detach_pattern()
     {
+      clear_cut_results();
       _pattern_.reset();
     }
 
     topology_data::handle_pattern & topology_data::get_pattern_handle()
     {
+      clear_cut_results();
       return _pattern_;
     }
 
@@ -34,6 +37,7 @@ namespace snemo {
 
     base_topology_pattern & topology_data::get_pattern()
     {
+      clear_cut_results();
       return _pattern_.grab();
     }
 
@@ -44,6 +48,7 @@ namespace snemo {
 
     datatools::properties & topology_data::get_auxiliaries()
     {
+      clear_cut_results();
       return _auxiliaries_;
     }
 
@@ -52,6 +57,35 @@ namespace snemo {
       return _auxiliaries_;
     }
 
+    bool topology_data::find_cut_result(const void * cut_, const void * data_, int & status_) const
+    {
+      // Only a handful of cuts are applied per event: a linear search is enough
+      for (const auto& a_result : _cut_results_) {
+        if (a_result.cut == cut_ && a_result.data == data_) {
+          status_ = a_result.status;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void topology_data::store_cut_result(const void * cut_, const void * data_, int status_) const
+    {
+      for (auto& a_result : _cut_results_) {
+        if (a_result.cut == cut_ && a_result.data == data_) {
+          a_result.status = status_;
+          return;
+        }
+      }
+      cut_result a_result = {cut_, data_, status_};
+      _cut_results_.push_back(a_result);
+    }
+
+    void topology_data::clear_cut_results() const
+    {
+      _cut_results_.clear();
+    }
+
     topology_data::topology_data()
     {
     }
@@ -13,6 +13,9 @@
 #ifndef FALAISE_SNEMO_DATAMODELS_TOPOLOGY_DATA_H
 #define FALAISE_SNEMO_DATAMODELS_TOPOLOGY_DATA_H 1
 
+// Standard library:
+#include <vector>
+
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/i_serializable.h>
@@ -103,6 +106,22 @@ namespace snemo {
       /// Return a non mutable reference on the container of auxiliary properties
       datatools::properties & get_auxiliaries();
 
+      /// Find the memoized result of a cut applied to this topology data
+      ///
+      /// Results are keyed by the address of the cut and of the data it was
+      /// given (the whole event record, a measurement...), so that a cut
+      /// shared by several channels is evaluated once per event.
+      bool find_cut_result(const void * cut_, const void * data_, int & status_) const;
+
+      /// Memoize the result of a cut applied to this topology data
+      void store_cut_result(const void * cut_, const void * data_, int status_) const;
+
+      /// Forget the memoized cut results
+      ///
+      /// Results are also forgotten when the topology data is modified
+      /// through its non-const accessors.
+      void clear_cut_results() const;
+
       /// Reset the internals
       void reset();
 
@@ -117,8 +136,16 @@ namespace snemo {
 
     private :
 
+      /// Memoized result of a cut
+      struct cut_result {
+        const void * cut;  //!< Address of the cut
+        const void * data; //!< Address of the data given to the cut
+        int status;        //!< Selection status
+      };
+
       handle_pattern _pattern_;            //!< Handle to a topology pattern
       datatools::properties _auxiliaries_; //!< Auxiliary properties
+      mutable std::vector<cut_result> _cut_results_; //!< Memoized cut results (transient)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
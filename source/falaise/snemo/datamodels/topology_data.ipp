@@ -28,6 +28,9 @@ namespace snemo {
       ar_ & DATATOOLS_SERIALIZATION_I_SERIALIZABLE_BASE_OBJECT_NVP;
       ar_ & boost::serialization::make_nvp("pattern", _pattern_);
       ar_ & boost::serialization::make_nvp("auxiliaries", _auxiliaries_);
+      if (Archive::is_loading::value) {
+        _cut_results_.clear();
+      }
     }
 
   } // end of namespace datamodel
@@ -0,0 +1,105 @@
+/** \file falaise/snemo/datamodels/topology_generic_pattern.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/datamodels/topology_generic_pattern.h>
+
+// Standard library:
+#include <algorithm>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    // Serial tag for datatools::i_serializable interface :
+    DATATOOLS_SERIALIZATION_SERIAL_TAG_IMPLEMENTATION(topology_generic_pattern,
+                                                      "snemo::datamodel::topology_generic_pattern")
+
+    // static
+    const std::string & topology_generic_pattern::pattern_id()
+    {
+      static const std::string _id("generic");
+      return _id;
+    }
+
+    // static
+    int topology_generic_pattern::get_type_rank(const std::string & label_)
+    {
+      static const std::string types("epag");
+      const size_t rank = label_.empty() ? std::string::npos : types.find(label_[0]);
+      return rank == std::string::npos ? static_cast<int>(types.size()) : static_cast<int>(rank);
+    }
+
+    std::string topology_generic_pattern::get_pattern_id() const
+    {
+      return topology_generic_pattern::pattern_id();
+    }
+
+    topology_generic_pattern::topology_generic_pattern()
+      : base_topology_pattern()
+    {
+    }
+
+    topology_generic_pattern::~topology_generic_pattern()
+    {
+    }
+
+    void topology_generic_pattern::set_particle_labels(const std::vector<std::string> & labels_)
+    {
+      for (const auto& a_label : labels_) {
+        DT_THROW_IF(! has_particle_track(a_label), std::logic_error,
+                    "No particle with label '" << a_label << "' has been stored !");
+      }
+      _particle_labels_ = labels_;
+    }
+
+    const std::vector<std::string> & topology_generic_pattern::get_particle_labels() const
+    {
+      return _particle_labels_;
+    }
+
+    size_t topology_generic_pattern::get_number_of_particles(char type_) const
+    {
+      return std::count_if(_particle_labels_.begin(), _particle_labels_.end(),
+                           [type_] (const std::string & a_label) { return ! a_label.empty() && a_label[0] == type_; });
+    }
+
+    const energy_measurement * topology_generic_pattern::find_energy(const std::string & label_) const
+    {
+      return find_measurement_as<energy_measurement>("energy_" + label_);
+    }
+
+    const angle_measurement * topology_generic_pattern::find_angle(const std::string & label_) const
+    {
+      return find_measurement_as<angle_measurement>("angle_" + label_);
+    }
+
+    const angle_measurement * topology_generic_pattern::find_angle(const std::string & label1_,
+                                                                   const std::string & label2_) const
+    {
+      return _find_pair_measurement_<angle_measurement>("angle", label1_, label2_);
+    }
+
+    const tof_measurement * topology_generic_pattern::find_tof(const std::string & label1_,
+                                                               const std::string & label2_) const
+    {
+      return _find_pair_measurement_<tof_measurement>("tof", label1_, label2_);
+    }
+
+    const vertex_measurement * topology_generic_pattern::find_vertex(const std::string & label1_,
+                                                                     const std::string & label2_) const
+    {
+      return _find_pair_measurement_<vertex_measurement>("vertex", label1_, label2_);
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
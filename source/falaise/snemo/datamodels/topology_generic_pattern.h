@@ -0,0 +1,111 @@
+/// \file falaise/snemo/datamodels/topology_generic_pattern.h
+/*
+ * Description: The topology pattern of the classifications without a
+ *              dedicated pattern
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_PATTERN_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_PATTERN_H 1
+
+// Standard library:
+#include <string>
+#include <vector>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief The topology pattern of any set of particles ('3e', '1e1p1g', '2e1a'...)
+    ///
+    /// Measurements follow the labelling of the dedicated patterns
+    /// ('energy_e1', 'tof_e1_g2', 'vertex_e1_a1'...), pair labels being
+    /// ordered electrons first, then positrons, alphas and gammas.
+    class topology_generic_pattern : public base_topology_pattern
+    {
+    public:
+      /// Static function to return pattern identifier of the pattern
+      static const std::string & pattern_id();
+
+      /// Return the rank of a particle type in the label ordering ('e', 'p', 'a', 'g')
+      static int get_type_rank(const std::string & label_);
+
+    public:
+      /// Constructor
+      topology_generic_pattern();
+
+      /// Destructor
+      virtual ~topology_generic_pattern();
+
+      /// Return pattern identifier of the pattern
+      virtual std::string get_pattern_id() const;
+
+      /// Set the ordered labels of the particles
+      void set_particle_labels(const std::vector<std::string> & labels_);
+
+      /// Return the ordered labels of the particles
+      const std::vector<std::string> & get_particle_labels() const;
+
+      /// Return the number of particles of a given type ('e', 'p', 'a' or 'g')
+      size_t get_number_of_particles(char type_) const;
+
+      /// Return the energy of a particle, or null if not measured
+      const energy_measurement * find_energy(const std::string & label_) const;
+
+      /// Return the angle of a particle with the source foil, or null if not measured
+      const angle_measurement * find_angle(const std::string & label_) const;
+
+      /// Return the angle between two particles, or null if not measured
+      const angle_measurement * find_angle(const std::string & label1_, const std::string & label2_) const;
+
+      /// Return the TOF between two particles, or null if not measured
+      const tof_measurement * find_tof(const std::string & label1_, const std::string & label2_) const;
+
+      /// Return the common vertex of two particles, or null if not measured
+      const vertex_measurement * find_vertex(const std::string & label1_, const std::string & label2_) const;
+
+    private:
+
+      /// Return a pair measurement whatever the order of the labels
+      template<class T>
+      const T * _find_pair_measurement_(const std::string & prefix_,
+                                        const std::string & label1_, const std::string & label2_) const
+      {
+        const T * a_measurement = find_measurement_as<T>(prefix_ + "_" + label1_ + "_" + label2_);
+        if (a_measurement == nullptr) {
+          a_measurement = find_measurement_as<T>(prefix_ + "_" + label2_ + "_" + label1_);
+        }
+        return a_measurement;
+      }
+
+    private:
+
+      std::vector<std::string> _particle_labels_; //!< Ordered labels of the particles
+
+      DATATOOLS_SERIALIZATION_DECLARATION()
+
+    };
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#include <boost/serialization/export.hpp>
+BOOST_CLASS_EXPORT_KEY2(snemo::datamodel::topology_generic_pattern,
+                        "snemo::datamodel::topology_generic_pattern")
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_PATTERN_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,37 @@
+// -*- mode: c++ ; -*-
+/// \file falaise/snemo/datamodels/topology_generic_pattern.ipp
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_PATTERN_IPP
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_PATTERN_IPP 1
+
+// Ourselves:
+#include <falaise/snemo/datamodels/topology_generic_pattern.h>
+
+// Third party:
+// - Boost:
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.ipp>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// Serialization method
+    template<class Archive>
+    void topology_generic_pattern::serialize(Archive & ar_, const unsigned int /* version */)
+    {
+      ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_topology_pattern);
+      ar_ & boost::serialization::make_nvp("particle_labels", _particle_labels_);
+      return;
+    }
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_PATTERN_IPP
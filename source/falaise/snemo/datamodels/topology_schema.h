@@ -0,0 +1,285 @@
+/// \file falaise/snemo/datamodels/topology_schema.h
+/*
+ * Description: Compile-time description of the particles and measurements
+ *              of a topology pattern
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_SCHEMA_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_SCHEMA_H 1
+
+// Standard library:
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+
+namespace snemo {
+
+  namespace datamodel {
+
+    /// \brief Compile-time topology schemas
+    ///
+    /// A schema lists the particle slots of a topology and its measurements,
+    /// each one being a kind of measurement applied to a tuple of particles:
+    ///
+    /// \code
+    /// typedef schema::topology_schema<schema::particle_list<schema::e1, schema::e2>,
+    ///                                 schema::measurement_list<schema::tof<schema::e1, schema::e2>,
+    ///                                                          schema::energy<schema::e1> > > my_schema;
+    /// \endcode
+    ///
+    /// Builders store the listed measurements with their usual labels
+    /// ('tof_e1_e2', 'energy_e1'...), and patterns resolve them once into
+    /// measurement_slots, accessed through indexes known at compile time.
+    namespace schema {
+
+      /// Kind of measurement
+      enum measurement_kind {
+        MEASUREMENT_TOF    = 0, //!< Time of flight between two particles
+        MEASUREMENT_VERTEX = 1, //!< Common vertex of two particles
+        MEASUREMENT_ANGLE  = 2, //!< Angle of one particle or between two particles
+        MEASUREMENT_ENERGY = 3  //!< Energy of one particle
+      };
+
+      /// Particle slot, labelled from its type and index ('e1', 'p2'...)
+      template<char Type, unsigned int Index>
+      struct particle
+      {
+        static const std::string & label()
+        {
+          static const std::string _label(std::string(1, Type) + std::to_string(Index));
+          return _label;
+        }
+      };
+
+      typedef particle<'e', 1> e1;
+      typedef particle<'e', 2> e2;
+      typedef particle<'p', 1> p1;
+      typedef particle<'p', 2> p2;
+      typedef particle<'a', 1> a1;
+
+      /// List of particle slots
+      template<class... Particles>
+      struct particle_list
+      {
+        static const size_t size = sizeof...(Particles);
+
+        static const std::vector<std::string> & labels()
+        {
+          static const std::vector<std::string> _labels = {Particles::label()...};
+          return _labels;
+        }
+      };
+
+      /// Measurement of a given kind and data type over a tuple of particles
+      template<measurement_kind Kind, class Type, class... Particles>
+      struct measurement
+      {
+        typedef Type measurement_type;
+        static const measurement_kind kind = Kind;
+
+        static const std::vector<std::string> & particle_labels()
+        {
+          return particle_list<Particles...>::labels();
+        }
+
+        /// Return the label of the measurement within the pattern
+        static const std::string & label()
+        {
+          static const std::string _label(_make_label_());
+          return _label;
+        }
+
+      private:
+
+        static std::string _make_label_()
+        {
+          static const char * prefixes[] = {"tof", "vertex", "angle", "energy"};
+          std::string a_label = prefixes[Kind];
+          for (const auto& a_particle : particle_labels()) {
+            a_label += "_" + a_particle;
+          }
+          return a_label;
+        }
+      };
+
+      template<class P1, class P2>
+      using tof = measurement<MEASUREMENT_TOF, tof_measurement, P1, P2>;
+
+      template<class P1, class P2>
+      using vertex = measurement<MEASUREMENT_VERTEX, vertex_measurement, P1, P2>;
+
+      template<class... Particles>
+      using angle = measurement<MEASUREMENT_ANGLE, angle_measurement, Particles...>;
+
+      template<class P>
+      using energy = measurement<MEASUREMENT_ENERGY, energy_measurement, P>;
+
+      /// Index of a type within a list of types
+      template<class T, class... List>
+      struct index_of;
+
+      template<class T, class... Tail>
+      struct index_of<T, T, Tail...>
+      {
+        static const size_t value = 0;
+      };
+
+      template<class T, class Head, class... Tail>
+      struct index_of<T, Head, Tail...>
+      {
+        static const size_t value = 1 + index_of<T, Tail...>::value;
+      };
+
+      template<class T>
+      struct index_of<T>
+      {
+        static_assert(sizeof(T) == 0, "Measurement is not part of the topology schema");
+      };
+
+      /// List of measurements
+      template<class... Measurements>
+      struct measurement_list
+      {
+        static const size_t size = sizeof...(Measurements);
+
+        /// Return the compile-time index of a measurement
+        template<class M>
+        struct slot
+        {
+          static const size_t index = index_of<M, Measurements...>::value;
+        };
+
+        /// Call 'visitor_.template apply<M>()' for every measurement, in order
+        template<class Visitor>
+        static void for_each(Visitor & visitor_)
+        {
+          const int expand[] = {0, (visitor_.template apply<Measurements>(), 0)...};
+          (void) expand;
+        }
+      };
+
+      /// Particle slots and measurements of a topology
+      template<class Particles, class Measurements>
+      struct topology_schema
+      {
+        typedef Particles particles;
+        typedef Measurements measurements;
+      };
+
+      /// Measurements of a pattern resolved once for a schema
+      ///
+      /// Slots point to the measurements owned by the pattern and are valid
+      /// until its measurements are changed: patterns reset them when their
+      /// measurement dictionary is handed out for changes. Copies are not
+      /// resolved, as the slots belong to the source pattern.
+      template<class Schema>
+      class measurement_slots
+      {
+      public:
+        typedef typename Schema::measurements measurements;
+
+        /// Constructor
+        measurement_slots()
+        {
+          reset();
+        }
+
+        /// Copy constructor, the copy being not resolved
+        measurement_slots(const measurement_slots &)
+        {
+          reset();
+        }
+
+        /// Assignment operator, the slots being not resolved anymore
+        measurement_slots & operator=(const measurement_slots &)
+        {
+          reset();
+          return *this;
+        }
+
+        /// Check if the slots have been resolved
+        bool is_resolved() const
+        {
+          return _resolved_.load(std::memory_order_acquire);
+        }
+
+        /// Resolve the slots from the measurements of a pattern
+        void resolve(const base_topology_pattern & pattern_)
+        {
+          _resolver_ a_resolver = {pattern_, _slots_.data()};
+          measurements::for_each(a_resolver);
+          _resolved_.store(true, std::memory_order_release);
+        }
+
+        /// Forget the slots
+        void reset()
+        {
+          _resolved_ = false;
+          _slots_.fill(nullptr);
+        }
+
+        /// Check if a measurement is available
+        template<class M>
+        bool has() const
+        {
+          return _slots_[measurements::template slot<M>::index] != nullptr;
+        }
+
+        /// Return a measurement
+        template<class M>
+        const typename M::measurement_type & get() const
+        {
+          const base_topology_measurement * a_measurement = _slots_[measurements::template slot<M>::index];
+          DT_THROW_IF(a_measurement == nullptr, std::logic_error,
+                      "Topology pattern does not hold any '" << M::label() << "' measurement !");
+          return static_cast<const typename M::measurement_type &>(*a_measurement);
+        }
+
+      private:
+
+        /// Fill the slots with the measurements of the expected types
+        struct _resolver_
+        {
+          const base_topology_pattern & pattern;
+          const base_topology_measurement ** slot;
+
+          template<class M>
+          void apply()
+          {
+            *slot++ = pattern.find_measurement_as<typename M::measurement_type>(M::label());
+          }
+        };
+
+      private:
+
+        std::atomic<bool> _resolved_;                                             //!< Resolution flag
+        std::array<const base_topology_measurement *, measurements::size> _slots_; //!< Measurements of the schema
+      };
+
+    } // end of namespace schema
+
+  } // end of namespace datamodel
+
+} // end of namespace snemo
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_SCHEMA_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -7,17 +7,24 @@
 #include <stdexcept>
 #include <sstream>
 
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
 // This project:
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/reconstruction/vertex_summary.h>
 
 namespace {
 /// Return direction of particle track at source foil
 /// returned vector is invalid if
 /// - particle has no vertex on foil
 ///
-geomtools::vector_3d direction_at_foil(const snemo::datamodel::particle_track & pt_)
+geomtools::vector_3d direction_at_foil(const snemo::datamodel::particle_track & pt_,
+                                       const snemo::reconstruction::vertex_summary & vertices_,
+                                       size_t index_)
 {
   // Default invalid direction
   geomtools::vector_3d direction_;
@@ -25,16 +32,11 @@ geomtools::vector_3d direction_at_foil(const snemo::datamodel::particle_track &
 
 
   // Find first vertex on foil
-  geomtools::vector_3d foil_vertex;
-  geomtools::invalidate(foil_vertex);
-
-  for (auto& i_vtx : pt_.get_vertices()) {
-    if (snemo::datamodel::particle_track::vertex_is_on_source_foil(i_vtx.get())) {
-      foil_vertex = i_vtx.get().get_position();
-      break;
-    }
+  const int foil_rank = vertices_.find_first(index_, snemo::reconstruction::vertex_summary::SOURCE_FOIL);
+  if (foil_rank < 0) {
+    return direction_;
   }
-
+  const geomtools::vector_3d & foil_vertex = pt_.get_vertices()[foil_rank].get().get_position();
   if (! geomtools::is_valid(foil_vertex)) {
     return direction_;
   }
@@ -42,18 +44,14 @@ geomtools::vector_3d direction_at_foil(const snemo::datamodel::particle_track &
   // Check particle type NB: Couples angle driver to PID and PID impl
   if (snemo::datamodel::pid_utils::particle_is_gamma(pt_)) {
     // Get the first vertex on calorimeter (should be the first associated calorimeter)
-    for (auto& i_vtx : pt_.get_vertices()) {
-      if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(i_vtx.get()) ||
-          snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(i_vtx.get())    ||
-          snemo::datamodel::particle_track::vertex_is_on_gamma_veto(i_vtx.get())) {
-        const geomtools::vector_3d& calo_vertex = i_vtx.get().get_position();
-        direction_ = calo_vertex - foil_vertex;
-        break;
-      }
+    const int calo_rank = vertices_.find_first(index_, snemo::reconstruction::vertex_summary::CALORIMETER);
+    if (calo_rank >= 0) {
+      const geomtools::vector_3d& calo_vertex = pt_.get_vertices()[calo_rank].get().get_position();
+      direction_ = calo_vertex - foil_vertex;
     }
   } else if (pt_.has_trajectory()) {
-    auto a_trajectory = pt_.get_trajectory();
-    auto& a_track_pattern = a_trajectory.get_pattern();
+    const auto& a_trajectory = pt_.get_trajectory();
+    const auto& a_track_pattern = a_trajectory.get_pattern();
     direction_ = a_track_pattern.get_shape().get_direction_on_curve(foil_vertex);
   } else {
     return direction_;
@@ -97,10 +95,23 @@ namespace snemo {
     }
 
 
-    double angle_driver::process(const snemo::datamodel::particle_track& pt_)
+    geomtools::vector_3d angle_driver::get_direction(const snemo::datamodel::particle_track & pt_) const
     {
-      double measuredAngle {datatools::invalid_real_double()};
+      vertex_summary vertices;
+      vertices.fill({&pt_});
+      return direction_at_foil(pt_, vertices, 0);
+    }
+
+    geomtools::vector_3d angle_driver::get_direction(const snemo::datamodel::particle_track & pt_,
+                                                     const vertex_summary & vertices_,
+                                                     size_t index_) const
+    {
+      DT_THROW_IF(index_ >= vertices_.size(), std::range_error, "Invalid particle index '" << index_ << "' !");
+      return direction_at_foil(pt_, vertices_, index_);
+    }
 
+    double angle_driver::process(const snemo::datamodel::particle_track& pt_) const
+    {
       if (snemo::datamodel::pid_utils::particle_is_gamma(pt_)) {
         //DT_LOG_WARNING(get_logging_priority(),
         //             "No angle can be deduced from a single gamma !");
@@ -108,38 +119,80 @@ namespace snemo {
         return datatools::invalid_real_double();
       }
 
-      geomtools::vector_3d particle_dir = direction_at_foil(pt_);
+      return process(get_direction(pt_));
+    }
+
+
+    double
+    angle_driver::process(const snemo::datamodel::particle_track& pt1_,
+                          const snemo::datamodel::particle_track& pt2_) const
+    {
+      if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) &&
+          snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
+        //DT_LOG_WARNING(get_logging_priority(), "The two particles are gammas ! No angle can be measured !");
+        return datatools::invalid_real_double();
+      }
+
+      vertex_summary vertices;
+      vertices.fill({&pt1_, &pt2_});
+      return process(direction_at_foil(pt1_, vertices, 0), direction_at_foil(pt2_, vertices, 1));
+    }
+
 
-      if (geomtools::is_valid(particle_dir)) {
+    double angle_driver::process(const geomtools::vector_3d & direction_) const
+    {
+      double measuredAngle {datatools::invalid_real_double()};
+
+      if (geomtools::is_valid(direction_)) {
         geomtools::vector_3d Ox(1,0,0);
-        measuredAngle = std::acos(particle_dir * Ox) / M_PI * 180 * CLHEP::degree;
+        measuredAngle = std::acos(direction_ * Ox) / M_PI * 180 * CLHEP::degree;
       }
 
       return measuredAngle;
     }
 
 
-    double
-    angle_driver::process(const snemo::datamodel::particle_track& pt1_,
-                          const snemo::datamodel::particle_track& pt2_)
+    double angle_driver::process(const geomtools::vector_3d & direction1_,
+                                 const geomtools::vector_3d & direction2_) const
     {
       // Invalidate angle meas.
       double measuredAngle {datatools::invalid_real_double()};
 
-      if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) &&
-          snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
-        //DT_LOG_WARNING(get_logging_priority(), "The two particles are gammas ! No angle can be measured !");
-        return measuredAngle;
+      if (geomtools::is_valid(direction1_) && geomtools::is_valid(direction2_)) {
+        measuredAngle = std::acos(direction1_ * direction2_) / M_PI * 180 * CLHEP::degree;
       }
 
-      geomtools::vector_3d particle_dir1 = direction_at_foil(pt1_);
-      geomtools::vector_3d particle_dir2 = direction_at_foil(pt2_);
+      return measuredAngle;
+    }
+
 
-      if (geomtools::is_valid(particle_dir1) && geomtools::is_valid(particle_dir2)) {
-        measuredAngle = std::acos(particle_dir1 * particle_dir2) / M_PI * 180 * CLHEP::degree;
+    void angle_driver::process(const std::vector<geomtools::vector_3d> & directions_,
+                               std::vector<double> & angles_) const
+    {
+      const size_t n = directions_.size();
+      angles_.assign(n * n, datatools::invalid_real_double());
+
+      // Unpack the unit vectors once
+      std::vector<double> ux(n), uy(n), uz(n);
+      std::vector<bool> valid(n);
+      for (size_t i = 0; i < n; i++) {
+        ux[i] = directions_[i].x();
+        uy[i] = directions_[i].y();
+        uz[i] = directions_[i].z();
+        valid[i] = geomtools::is_valid(directions_[i]);
       }
 
-      return measuredAngle;
+      for (size_t i = 0; i < n; i++) {
+        if (! valid[i]) continue;
+        angles_[i * n + i] = 0.0;
+        for (size_t j = i + 1; j < n; j++) {
+          if (! valid[j]) continue;
+          const double cos_angle = ux[i]*ux[j] + uy[i]*uy[j] + uz[i]*uz[j];
+          const double an_angle = std::acos(cos_angle) / M_PI * 180 * CLHEP::degree;
+          angles_[i * n + j] = an_angle;
+          angles_[j * n + i] = an_angle;
+        }
+      }
     }
 
 
@@ -54,6 +54,8 @@ namespace snemo {
 
   namespace reconstruction {
 
+    struct vertex_summary;
+
     /// Driver for the angle measurement algorithms
     class angle_driver
     {
@@ -73,11 +75,37 @@ namespace snemo {
       void initialize(const datatools::properties & setup_);
 
       /// Return angle between foil and trajectory at foil vertex
-      double process(const snemo::datamodel::particle_track& pt_);
+      double process(const snemo::datamodel::particle_track& pt_) const;
 
       /// Return angle between trajectories evaluated at foil vertices
       double process(const snemo::datamodel::particle_track & pt1_,
-                     const snemo::datamodel::particle_track & pt2_);
+                     const snemo::datamodel::particle_track & pt2_) const;
+
+      /// Return the normalized direction of a particle track at its foil vertex
+      ///
+      /// The returned vector is invalid if the particle has no vertex on the
+      /// source foil. It can be computed once per event and reused for all
+      /// the angle measurements involving the particle.
+      geomtools::vector_3d get_direction(const snemo::datamodel::particle_track & pt_) const;
+
+      /// Return the normalized direction of a particle track given the event vertex summary
+      geomtools::vector_3d get_direction(const snemo::datamodel::particle_track & pt_,
+                                         const vertex_summary & vertices_,
+                                         size_t index_) const;
+
+      /// Return angle between foil and a direction at foil vertex
+      double process(const geomtools::vector_3d & direction_) const;
+
+      /// Return angle between two directions at foil vertices
+      double process(const geomtools::vector_3d & direction1_,
+                     const geomtools::vector_3d & direction2_) const;
+
+      /// Compute all the pairwise angles between a set of directions
+      ///
+      /// The angle between directions i and j is stored at index i * N + j
+      /// where N is the number of directions.
+      void process(const std::vector<geomtools::vector_3d> & directions_,
+                   std::vector<double> & angles_) const;
 
     };
 
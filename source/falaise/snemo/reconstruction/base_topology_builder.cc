@@ -4,9 +4,19 @@
 // Ourselves:
 #include <falaise/snemo/reconstruction/base_topology_builder.h>
 
+// Standard library:
+#include <algorithm>
+
 // - Falaise:
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/angle_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+#include <falaise/snemo/reconstruction/vertex_driver.h>
+#include <falaise/snemo/reconstruction/angle_driver.h>
 
 namespace snemo {
 
@@ -18,7 +28,9 @@ namespace snemo {
 
     base_topology_builder::base_topology_builder()
     {
-      _drivers = 0;
+      _lazy_measurements_ = false;
+      _parallel_gamma_threshold_ = 0;
+      _task_pool_ = nullptr;
     }
 
     base_topology_builder::~base_topology_builder()
@@ -28,12 +40,12 @@ namespace snemo {
 
     bool base_topology_builder::has_measurement_drivers() const
     {
-      return _drivers != 0;
+      return _drivers != nullptr;
     }
 
-    void base_topology_builder::set_measurement_drivers(const measurement_drivers & drivers_)
+    void base_topology_builder::set_measurement_drivers(const std::shared_ptr<const measurement_drivers> & drivers_)
     {
-      _drivers = &drivers_;
+      _drivers = drivers_;
     }
 
     const measurement_drivers & base_topology_builder::get_measurement_drivers() const
@@ -41,14 +53,290 @@ namespace snemo {
       return *_drivers;
     }
 
+    void base_topology_builder::set_lazy_measurements(bool lazy_)
+    {
+      _lazy_measurements_ = lazy_;
+    }
+
+    bool base_topology_builder::is_lazy_measurements() const
+    {
+      return _lazy_measurements_;
+    }
+
+    void base_topology_builder::set_parallel_gamma_threshold(size_t threshold_)
+    {
+      _parallel_gamma_threshold_ = threshold_;
+    }
+
+    size_t base_topology_builder::get_parallel_gamma_threshold() const
+    {
+      return _parallel_gamma_threshold_;
+    }
+
+    void base_topology_builder::set_task_pool(task_pool * pool_)
+    {
+      _task_pool_ = pool_;
+    }
+
+    task_pool * base_topology_builder::get_task_pool() const
+    {
+      return _task_pool_;
+    }
+
+    void base_topology_builder::add_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                const std::string & label_,
+                                                const snemo::datamodel::base_topology_pattern::measurement_evaluator_type & evaluator_)
+    {
+      if (is_lazy_measurements()) {
+        // The builder holds the per-event caches used by the evaluator
+        std::shared_ptr<base_topology_builder> self = shared_from_this();
+        pattern_.add_deferred_measurement(label_, [self, evaluator_] () { return evaluator_(); });
+      } else {
+        pattern_.get_measurement_dictionary()[label_] = evaluator_();
+      }
+    }
+
+    snemo::datamodel::base_topology_pattern::measurement_evaluator_type
+    base_topology_builder::_make_tof_evaluator_(const snemo::datamodel::base_topology_pattern & pattern_,
+                                                const std::string & label1_, const std::string & label2_)
+    {
+      const snemo::datamodel::base_topology_pattern & pattern = pattern_;
+      return [this, &pattern, label1_, label2_] ()
+        {
+          snemo::datamodel::tof_measurement * ptr_tof = new snemo::datamodel::tof_measurement;
+          snemo::datamodel::base_topology_pattern::handle_measurement h(ptr_tof);
+          const measurement_drivers & drivers = get_measurement_drivers();
+          if (drivers.TOFD) drivers.TOFD->process(pattern.get_particle_track(label1_),
+                                                  pattern.get_particle_track(label2_),
+                                                  get_calorimeter_summary(),
+                                                  get_vertex_summary(),
+                                                  get_particle_index(label1_),
+                                                  get_particle_index(label2_),
+                                                  *ptr_tof);
+          return h;
+        };
+    }
+
+    snemo::datamodel::base_topology_pattern::measurement_evaluator_type
+    base_topology_builder::_make_energy_evaluator_(const std::string & label_)
+    {
+      return [this, label_] ()
+        {
+          snemo::datamodel::energy_measurement * ptr_energy = new snemo::datamodel::energy_measurement;
+          snemo::datamodel::base_topology_pattern::handle_measurement h(ptr_energy);
+          const measurement_drivers & drivers = get_measurement_drivers();
+          if (drivers.EMD) drivers.EMD->process(get_calorimeter_summary(),
+                                                get_particle_index(label_),
+                                                *ptr_energy);
+          return h;
+        };
+    }
+
+    void base_topology_builder::add_tof_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                    const std::string & label1_, const std::string & label2_)
+    {
+      add_measurement(pattern_, "tof_" + label1_ + "_" + label2_, _make_tof_evaluator_(pattern_, label1_, label2_));
+    }
+
+    void base_topology_builder::add_vertex_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                       const std::string & label1_, const std::string & label2_)
+    {
+      const snemo::datamodel::base_topology_pattern & pattern = pattern_;
+      add_measurement(pattern_, "vertex_" + label1_ + "_" + label2_,
+                      [this, &pattern, label1_, label2_] ()
+                      {
+                        snemo::datamodel::vertex_measurement * ptr_vertex = new snemo::datamodel::vertex_measurement;
+                        snemo::datamodel::base_topology_pattern::handle_measurement h(ptr_vertex);
+                        const measurement_drivers & drivers = get_measurement_drivers();
+                        if (drivers.VD) drivers.VD->process(pattern.get_particle_track(label1_),
+                                                            pattern.get_particle_track(label2_),
+                                                            get_vertex_summary(),
+                                                            get_particle_index(label1_),
+                                                            get_particle_index(label2_),
+                                                            *ptr_vertex);
+                        return h;
+                      });
+    }
+
+    void base_topology_builder::add_angle_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                      const std::string & label_)
+    {
+      if (! get_measurement_drivers().AMD) return;
+      const snemo::datamodel::base_topology_pattern & pattern = pattern_;
+      add_measurement(pattern_, "angle_" + label_,
+                      [this, &pattern, label_] ()
+                      {
+                        const double an_angle
+                          = get_measurement_drivers().AMD->process(get_direction_at_foil(pattern, label_));
+                        return snemo::datamodel::base_topology_pattern::handle_measurement(new snemo::datamodel::angle_measurement(an_angle));
+                      });
+    }
+
+    void base_topology_builder::add_angle_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                      const std::string & label1_, const std::string & label2_)
+    {
+      if (! get_measurement_drivers().AMD) return;
+      const snemo::datamodel::base_topology_pattern & pattern = pattern_;
+      add_measurement(pattern_, "angle_" + label1_ + "_" + label2_,
+                      [this, &pattern, label1_, label2_] ()
+                      {
+                        const double an_angle
+                          = get_measurement_drivers().AMD->process(get_direction_at_foil(pattern, label1_),
+                                                                   get_direction_at_foil(pattern, label2_));
+                        return snemo::datamodel::base_topology_pattern::handle_measurement(new snemo::datamodel::angle_measurement(an_angle));
+                      });
+    }
+
+    void base_topology_builder::add_angle_measurements(snemo::datamodel::base_topology_pattern & pattern_,
+                                                       const std::vector<std::string> & labels1_,
+                                                       const std::vector<std::string> & labels2_)
+    {
+      label_pair_collection_type pairs;
+      for (const auto& a_label1 : labels1_) {
+        for (const auto& a_label2 : labels2_) {
+          pairs.push_back(std::make_pair(a_label1, a_label2));
+        }
+      }
+      add_angle_measurements(pattern_, pairs);
+    }
+
+    void base_topology_builder::add_angle_measurements(snemo::datamodel::base_topology_pattern & pattern_,
+                                                       const label_pair_collection_type & pairs_)
+    {
+      if (! get_measurement_drivers().AMD) return;
+      const snemo::datamodel::base_topology_pattern & pattern = pattern_;
+
+      // Directions of the distinct particles, in order of appearance; the
+      // angle matrix is computed once, by the first evaluated measurement
+      std::vector<std::string> labels;
+      std::vector<std::pair<size_t, size_t> > indexes;
+      for (const auto& a_pair : pairs_) {
+        size_t ij[2];
+        const std::string * pair_labels[2] = {&a_pair.first, &a_pair.second};
+        for (size_t k = 0; k < 2; k++) {
+          auto found = std::find(labels.begin(), labels.end(), *pair_labels[k]);
+          ij[k] = found - labels.begin();
+          if (found == labels.end()) labels.push_back(*pair_labels[k]);
+        }
+        indexes.push_back(std::make_pair(ij[0], ij[1]));
+      }
+      const size_t nparticles = labels.size();
+      std::shared_ptr<std::vector<double> > angles = std::make_shared<std::vector<double> >();
+      auto angle_at = [this, &pattern, labels, angles, nparticles] (size_t i_, size_t j_) -> double
+        {
+          if (angles->empty()) {
+            std::vector<geomtools::vector_3d> directions;
+            for (const auto& a_label : labels) {
+              directions.push_back(get_direction_at_foil(pattern, a_label));
+            }
+            get_measurement_drivers().AMD->process(directions, *angles);
+          }
+          return (*angles)[i_ * nparticles + j_];
+        };
+
+      for (size_t ipair = 0; ipair < pairs_.size(); ipair++) {
+        const size_t i = indexes[ipair].first;
+        const size_t j = indexes[ipair].second;
+        add_measurement(pattern_, "angle_" + pairs_[ipair].first + "_" + pairs_[ipair].second,
+                        [angle_at, i, j] ()
+                        {
+                          return snemo::datamodel::base_topology_pattern::handle_measurement(new snemo::datamodel::angle_measurement(angle_at(i, j)));
+                        });
+      }
+    }
+
+    void base_topology_builder::add_energy_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                                       const std::string & label_)
+    {
+      add_measurement(pattern_, "energy_" + label_, _make_energy_evaluator_(label_));
+    }
+
+    void base_topology_builder::_add_schema_measurement_(snemo::datamodel::base_topology_pattern & pattern_,
+                                                         snemo::datamodel::schema::measurement_kind kind_,
+                                                         const std::vector<std::string> & labels_)
+    {
+      switch (kind_) {
+      case snemo::datamodel::schema::MEASUREMENT_TOF:
+        add_tof_measurement(pattern_, labels_.at(0), labels_.at(1));
+        break;
+      case snemo::datamodel::schema::MEASUREMENT_VERTEX:
+        add_vertex_measurement(pattern_, labels_.at(0), labels_.at(1));
+        break;
+      case snemo::datamodel::schema::MEASUREMENT_ANGLE:
+        if (labels_.size() == 1) {
+          add_angle_measurement(pattern_, labels_.front());
+        } else {
+          add_angle_measurement(pattern_, labels_.at(0), labels_.at(1));
+        }
+        break;
+      case snemo::datamodel::schema::MEASUREMENT_ENERGY:
+        add_energy_measurement(pattern_, labels_.at(0));
+        break;
+      }
+    }
+
+    void base_topology_builder::add_gamma_measurements(snemo::datamodel::base_topology_pattern & pattern_,
+                                                       const std::vector<std::string> & charged_labels_,
+                                                       const std::vector<std::string> & gamma_labels_)
+    {
+      const bool parallel = ! is_lazy_measurements()
+        && _task_pool_ != nullptr
+        && _parallel_gamma_threshold_ > 0
+        && gamma_labels_.size() >= _parallel_gamma_threshold_
+        && ! task_pool::in_parallel_section();
+      if (! parallel) {
+        for (const auto& g_label : gamma_labels_) {
+          for (const auto& a_label : charged_labels_) {
+            add_tof_measurement(pattern_, a_label, g_label);
+          }
+          add_energy_measurement(pattern_, g_label);
+        }
+        return;
+      }
+
+      // Measurements are listed in the serial order, each task filling its own slot
+      std::vector<std::string> labels;
+      std::vector<snemo::datamodel::base_topology_pattern::measurement_evaluator_type> evaluators;
+      for (const auto& g_label : gamma_labels_) {
+        for (const auto& a_label : charged_labels_) {
+          labels.push_back("tof_" + a_label + "_" + g_label);
+          evaluators.push_back(_make_tof_evaluator_(pattern_, a_label, g_label));
+        }
+        labels.push_back("energy_" + g_label);
+        evaluators.push_back(_make_energy_evaluator_(g_label));
+      }
+      const size_t ntasks = evaluators.size();
+      std::vector<snemo::datamodel::base_topology_pattern::handle_measurement> results(ntasks);
+      _task_pool_->run(ntasks, [&] (size_t i_) { results[i_] = evaluators[i_](); });
+      for (size_t i = 0; i < ntasks; i++) {
+        pattern_.get_measurement_dictionary()[labels[i]] = results[i];
+      }
+    }
+
 
     snemo::datamodel::base_topology_pattern::handle_type
     base_topology_builder::build(const snemo::datamodel::particle_track_data& tracks)
     {
       DT_THROW_IF(! has_measurement_drivers(), std::logic_error, "Missing measurement drivers !");
+      _directions_.clear();
       auto builtPattern = this->create_pattern();
       this->make_track_dictionary(tracks, builtPattern.grab());
+
+      // Read the calorimeter hits and decode the vertex categories of all
+      // the particles once for all the measurements
+      _particle_indexes_.clear();
+      std::vector<const snemo::datamodel::particle_track *> particles;
+      for (const auto& i_track : builtPattern.get().get_particle_track_dictionary()) {
+        _particle_indexes_[i_track.first] = particles.size();
+        particles.push_back(&i_track.second.get());
+      }
+      _calorimeters_.fill(particles);
+      _vertices_.fill(particles);
+
       this->make_measurements(builtPattern.grab());
+      if (! is_lazy_measurements()) {
+        builtPattern.grab().finalize();
+      }
       return builtPattern;
     }
 
@@ -83,6 +371,41 @@ namespace snemo {
       }
     }
 
+    const calorimeter_summary & base_topology_builder::get_calorimeter_summary() const
+    {
+      return _calorimeters_;
+    }
+
+    const vertex_summary & base_topology_builder::get_vertex_summary() const
+    {
+      return _vertices_;
+    }
+
+    size_t base_topology_builder::get_particle_index(const std::string & label_) const
+    {
+      auto found = _particle_indexes_.find(label_);
+      DT_THROW_IF(found == _particle_indexes_.end(), std::logic_error,
+                  "No particle with label '" << label_ << "' has been stored !");
+      return found->second;
+    }
+
+    const geomtools::vector_3d &
+    base_topology_builder::get_direction_at_foil(const snemo::datamodel::base_topology_pattern & pattern_,
+                                                 const std::string & label_)
+    {
+      auto found = _directions_.find(label_);
+      if (found == _directions_.end()) {
+        DT_THROW_IF(! get_measurement_drivers().AMD, std::logic_error, "Missing angle measurement driver !");
+        DT_THROW_IF(! pattern_.has_particle_track(label_), std::logic_error,
+                    "No particle with label '" << label_ << "' has been stored !");
+        const geomtools::vector_3d a_direction
+          = get_measurement_drivers().AMD->get_direction(pattern_.get_particle_track(label_),
+                                                         get_vertex_summary(), get_particle_index(label_));
+        found = _directions_.insert(std::make_pair(label_, a_direction)).first;
+      }
+      return found->second;
+    }
+
   } // end of namespace reconstruction
 
 } // end of namespace snemo
@@ -9,14 +9,26 @@
 #ifndef FALAISE_SNEMO_DATAMODEL_BASE_TOPOLOGY_BUILDER_H
 #define FALAISE_SNEMO_DATAMODEL_BASE_TOPOLOGY_BUILDER_H 1
 
+// Standard library:
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/factory_macros.h>
 #include <bayeux/datatools/handle.h>
+// - Bayeux/geomtools:
+#include <bayeux/geomtools/clhep.h>
 
 // This project:
 #include <falaise/snemo/reconstruction/topology_driver.h>
+#include <falaise/snemo/reconstruction/energy_driver.h>
+#include <falaise/snemo/reconstruction/vertex_summary.h>
+#include <falaise/snemo/reconstruction/task_pool.h>
 #include <falaise/snemo/datamodels/base_topology_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
 
 namespace snemo {
 
@@ -28,24 +40,48 @@ namespace snemo {
   namespace reconstruction {
 
     /// \brief The base class to build topology pattern
-    class base_topology_builder
+    ///
+    /// Builders computing lazy measurements must be owned by a std::shared_ptr.
+    class base_topology_builder : public std::enable_shared_from_this<base_topology_builder>
     {
     public:
       /// Constructor
       base_topology_builder();
 
       /// Destructor
-      ~base_topology_builder();
+      virtual ~base_topology_builder();
 
       /// Check if measurement drivers are available
       bool has_measurement_drivers() const;
 
       /// Set the measurement drivers
-      void set_measurement_drivers(const measurement_drivers &);
+      ///
+      /// The builder, and the lazy measurements it registers, share the
+      /// ownership of the drivers so they outlive a reset of the topology driver.
+      void set_measurement_drivers(const std::shared_ptr<const measurement_drivers> &);
 
       /// Get a non-mutable reference to measurement drivers
       const measurement_drivers & get_measurement_drivers() const;
 
+      /// Set the flag to compute measurements on first access
+      void set_lazy_measurements(bool);
+
+      /// Check if measurements are computed on first access
+      bool is_lazy_measurements() const;
+
+      /// Set the number of gammas from which per-gamma measurements are
+      /// computed concurrently (0 to always compute them serially)
+      void set_parallel_gamma_threshold(size_t);
+
+      /// Return the number of gammas from which per-gamma measurements are computed concurrently
+      size_t get_parallel_gamma_threshold() const;
+
+      /// Set the pool of threads computing per-gamma measurements
+      void set_task_pool(task_pool *);
+
+      /// Return the pool of threads computing per-gamma measurements, if any
+      task_pool * get_task_pool() const;
+
       /// Main function to build topology pattern
       virtual snemo::datamodel::base_topology_pattern::handle_type build(const snemo::datamodel::particle_track_data & source_);
 
@@ -59,9 +95,122 @@ namespace snemo {
 
       virtual void make_measurements(snemo::datamodel::base_topology_pattern & pattern_) = 0;
 
+      /// Store a measurement into the pattern, computed now or on first access
+      void add_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                           const std::string & label_,
+                           const snemo::datamodel::base_topology_pattern::measurement_evaluator_type & evaluator_);
+
+      /// Store the 'tof_<label1>_<label2>' measurement
+      void add_tof_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                               const std::string & label1_, const std::string & label2_);
+
+      /// Store the 'vertex_<label1>_<label2>' measurement
+      void add_vertex_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                  const std::string & label1_, const std::string & label2_);
+
+      /// Store the 'angle_<label>' measurement if an angle driver is available
+      void add_angle_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                 const std::string & label_);
+
+      /// Store the 'angle_<label1>_<label2>' measurement if an angle driver is available
+      void add_angle_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                 const std::string & label1_, const std::string & label2_);
+
+      /// Store the 'angle_<label1>_<label2>' measurements for every pair of
+      /// particles from two sets, computed with a single batch of directions
+      void add_angle_measurements(snemo::datamodel::base_topology_pattern & pattern_,
+                                  const std::vector<std::string> & labels1_,
+                                  const std::vector<std::string> & labels2_);
+
+      /// Typedef to a list of particle label pairs
+      typedef std::vector<std::pair<std::string, std::string> > label_pair_collection_type;
+
+      /// Store the 'angle_<label1>_<label2>' measurements of a list of pairs,
+      /// computed with a single batch over the directions of their particles
+      void add_angle_measurements(snemo::datamodel::base_topology_pattern & pattern_,
+                                  const label_pair_collection_type & pairs_);
+
+      /// Store the 'energy_<label>' measurement
+      void add_energy_measurement(snemo::datamodel::base_topology_pattern & pattern_,
+                                  const std::string & label_);
+
+      /// Store the measurements listed by a topology schema, in order
+      template<class Schema>
+      void add_schema_measurements(snemo::datamodel::base_topology_pattern & pattern_)
+      {
+        for (const auto& a_label : Schema::particles::labels()) {
+          DT_THROW_IF(! pattern_.has_particle_track(a_label), std::logic_error,
+                      "No particle with label '" << a_label << "' has been stored !");
+        }
+        _schema_adder_ an_adder = {*this, pattern_};
+        Schema::measurements::for_each(an_adder);
+      }
+
+      /// Store the 'tof_<charged>_<gamma>' and 'energy_<gamma>' measurements of a set of gammas
+      ///
+      /// Measurements are computed concurrently by the task pool when the
+      /// number of gammas reaches the parallel threshold, measurements are not
+      /// lazy and the builder does not already run in a parallel section. The
+      /// stored results are the same as with a serial computation.
+      void add_gamma_measurements(snemo::datamodel::base_topology_pattern & pattern_,
+                                  const std::vector<std::string> & charged_labels_,
+                                  const std::vector<std::string> & gamma_labels_);
+
+      /// Return the direction of a particle at the source foil, computed once per built pattern
+      const geomtools::vector_3d & get_direction_at_foil(const snemo::datamodel::base_topology_pattern & pattern_,
+                                                         const std::string & label_);
+
+      /// Return the calorimeter quantities of the particles of the pattern being built
+      const calorimeter_summary & get_calorimeter_summary() const;
+
+      /// Return the vertex categories of the particles of the pattern being built
+      const vertex_summary & get_vertex_summary() const;
+
+      /// Return the index of a particle within the event summaries
+      size_t get_particle_index(const std::string & label_) const;
+
     protected:
 
-      const measurement_drivers * _drivers;//!< Measurement drivers
+      std::shared_ptr<const measurement_drivers> _drivers;//!< Measurement drivers
+
+    private:
+
+      /// Return the evaluator of the TOF measurement between two particles
+      snemo::datamodel::base_topology_pattern::measurement_evaluator_type
+      _make_tof_evaluator_(const snemo::datamodel::base_topology_pattern & pattern_,
+                           const std::string & label1_, const std::string & label2_);
+
+      /// Return the evaluator of the energy measurement of a particle
+      snemo::datamodel::base_topology_pattern::measurement_evaluator_type
+      _make_energy_evaluator_(const std::string & label_);
+
+      /// Store one measurement of a topology schema
+      void _add_schema_measurement_(snemo::datamodel::base_topology_pattern & pattern_,
+                                    snemo::datamodel::schema::measurement_kind kind_,
+                                    const std::vector<std::string> & labels_);
+
+      /// Store the measurements of a topology schema one by one
+      struct _schema_adder_
+      {
+        base_topology_builder & builder;
+        snemo::datamodel::base_topology_pattern & pattern;
+
+        template<class M>
+        void apply()
+        {
+          builder._add_schema_measurement_(pattern, M::kind, M::particle_labels());
+        }
+      };
+
+    private:
+
+      bool _lazy_measurements_;                                 //!< Flag to compute measurements on first access
+      size_t _parallel_gamma_threshold_;                        //!< Number of gammas from which measurements are concurrent
+      task_pool * _task_pool_;                                  //!< Pool of threads for concurrent measurements
+      std::map<std::string, geomtools::vector_3d> _directions_; //!< Particle directions at the source foil
+      calorimeter_summary _calorimeters_;                       //!< Calorimeter quantities of the particles
+      vertex_summary _vertices_;                                //!< Vertex categories of the particles
+      std::map<std::string, size_t> _particle_indexes_;         //!< Particle indexes in the event summaries
 
       // Factory stuff :
       DATATOOLS_FACTORY_SYSTEM_REGISTER_INTERFACE(base_topology_builder)
@@ -0,0 +1,234 @@
+/// \file falaise/snemo/reconstruction/classification_index.cc
+
+// Ourselves:
+#include <snemo/reconstruction/classification_index.h>
+
+// Standard library:
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <sstream>
+
+// Third party:
+// - System:
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+      /// Particle types of a classification, in the classification label order
+      const char particle_types[] = {'e', 'p', 'g', 'a', 'X'};
+      const size_t number_of_particle_types = sizeof(particle_types);
+      const uint32_t bits_per_particle_type = 6;
+      const uint32_t max_count = (1 << bits_per_particle_type) - 1;
+
+      /// File layout: magic, number of channels, header size, then the
+      /// channel names separated by '\n' and padded to the entry size
+      const char index_magic[8] = {'S', 'N', 'P', 'I', 'D', 'X', '0', '1'};
+      const size_t header_prefix_size = sizeof(index_magic) + 2 * sizeof(uint32_t);
+    }
+
+    uint32_t pack_classification(const std::string & classification_)
+    {
+      uint32_t packed = 0;
+      static const std::regex token("([0-9]+)([epgaX])");
+      for (std::sregex_iterator it(classification_.begin(), classification_.end(), token), end;
+           it != end; ++it) {
+        const unsigned long count = std::stoul((*it)[1].str());
+        const char type = (*it)[2].str()[0];
+        const size_t shift = (std::strchr(particle_types, type) - particle_types) * bits_per_particle_type;
+        packed |= std::min<uint32_t>(count, max_count) << shift;
+      }
+      return packed;
+    }
+
+    std::string unpack_classification(uint32_t classification_)
+    {
+      std::ostringstream label;
+      for (size_t i = 0; i < number_of_particle_types; i++) {
+        const uint32_t count = (classification_ >> (i * bits_per_particle_type)) & max_count;
+        if (count > 0) label << count << particle_types[i];
+      }
+      return label.str();
+    }
+
+    classification_index_writer::classification_index_writer()
+    {
+    }
+
+    classification_index_writer::~classification_index_writer()
+    {
+      if (is_open()) close();
+    }
+
+    bool classification_index_writer::is_open() const
+    {
+      return _out_.is_open();
+    }
+
+    void classification_index_writer::open(const std::string & filename_, const std::vector<std::string> & channels_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Classification index is already open !");
+      DT_THROW_IF(channels_.size() > 32, std::range_error, "Too many channel cuts (32 at most) !");
+
+      std::string names;
+      for (const auto& a_channel : channels_) {
+        names += a_channel + "\n";
+      }
+      const size_t entry_size = sizeof(classification_index_entry);
+      const size_t header_size = (header_prefix_size + names.size() + entry_size - 1) / entry_size * entry_size;
+      names.resize(header_size - header_prefix_size, '\0');
+
+      _out_.open(filename_.c_str(), std::ios::binary | std::ios::trunc);
+      DT_THROW_IF(! _out_, std::runtime_error, "Cannot open classification index '" << filename_ << "' !");
+      const uint32_t nchannels = channels_.size();
+      const uint32_t header = header_size;
+      _out_.write(index_magic, sizeof(index_magic));
+      _out_.write(reinterpret_cast<const char *>(&nchannels), sizeof(nchannels));
+      _out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      _out_.write(names.data(), names.size());
+    }
+
+    void classification_index_writer::append(const classification_index_entry & entry_)
+    {
+      DT_THROW_IF(! is_open(), std::logic_error, "Classification index is not open !");
+      _out_.write(reinterpret_cast<const char *>(&entry_), sizeof(entry_));
+    }
+
+    void classification_index_writer::close()
+    {
+      DT_THROW_IF(! is_open(), std::logic_error, "Classification index is not open !");
+      _out_.close();
+    }
+
+    classification_index_reader::classification_index_reader()
+    {
+      _fd_ = -1;
+      _map_ = 0;
+      _map_size_ = 0;
+      _entries_ = 0;
+      _size_ = 0;
+    }
+
+    classification_index_reader::~classification_index_reader()
+    {
+      if (is_open()) close();
+    }
+
+    bool classification_index_reader::is_open() const
+    {
+      return _fd_ >= 0;
+    }
+
+    void classification_index_reader::open(const std::string & filename_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Classification index is already open !");
+
+      _fd_ = ::open(filename_.c_str(), O_RDONLY);
+      DT_THROW_IF(_fd_ < 0, std::runtime_error, "Cannot open classification index '" << filename_ << "' !");
+      struct stat a_stat;
+      ::fstat(_fd_, &a_stat);
+      _map_size_ = a_stat.st_size;
+      if (_map_size_ < header_prefix_size) {
+        close();
+        DT_THROW_IF(true, std::runtime_error, "Invalid classification index '" << filename_ << "' !");
+      }
+      _map_ = ::mmap(0, _map_size_, PROT_READ, MAP_PRIVATE, _fd_, 0);
+      if (_map_ == MAP_FAILED) {
+        _map_ = 0;
+        close();
+        DT_THROW_IF(true, std::runtime_error, "Cannot map classification index '" << filename_ << "' !");
+      }
+
+      const char * data = static_cast<const char *>(_map_);
+      uint32_t nchannels = 0;
+      uint32_t header_size = 0;
+      std::memcpy(&nchannels, data + sizeof(index_magic), sizeof(nchannels));
+      std::memcpy(&header_size, data + sizeof(index_magic) + sizeof(nchannels), sizeof(header_size));
+      if (std::memcmp(data, index_magic, sizeof(index_magic)) != 0 || header_size > _map_size_) {
+        close();
+        DT_THROW_IF(true, std::runtime_error, "Invalid classification index '" << filename_ << "' !");
+      }
+
+      std::istringstream names(std::string(data + header_prefix_size, header_size - header_prefix_size));
+      std::string a_channel;
+      while (_channels_.size() < nchannels && std::getline(names, a_channel)) {
+        _channels_.push_back(a_channel);
+      }
+      _entries_ = reinterpret_cast<const classification_index_entry *>(data + header_size);
+      _size_ = (_map_size_ - header_size) / sizeof(classification_index_entry);
+
+      // Records are read in order by skims
+      ::madvise(_map_, _map_size_, MADV_SEQUENTIAL);
+    }
+
+    void classification_index_reader::close()
+    {
+      DT_THROW_IF(! is_open(), std::logic_error, "Classification index is not open !");
+      if (_map_ != 0) ::munmap(_map_, _map_size_);
+      ::close(_fd_);
+      _fd_ = -1;
+      _map_ = 0;
+      _map_size_ = 0;
+      _channels_.clear();
+      _entries_ = 0;
+      _size_ = 0;
+    }
+
+    const std::vector<std::string> & classification_index_reader::get_channels() const
+    {
+      return _channels_;
+    }
+
+    uint32_t classification_index_reader::get_channel_bit(const std::string & channel_) const
+    {
+      auto found = std::find(_channels_.begin(), _channels_.end(), channel_);
+      DT_THROW_IF(found == _channels_.end(), std::logic_error,
+                  "No channel cut '" << channel_ << "' in classification index !");
+      return uint32_t(1) << (found - _channels_.begin());
+    }
+
+    size_t classification_index_reader::size() const
+    {
+      return _size_;
+    }
+
+    const classification_index_entry & classification_index_reader::at(size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _size_, std::range_error, "Invalid classification index entry #" << index_ << " !");
+      return _entries_[index_];
+    }
+
+    void classification_index_reader::select(const std::vector<uint32_t> & classifications_,
+                                             uint32_t channels_,
+                                             std::vector<uint64_t> & records_) const
+    {
+      records_.clear();
+      for (size_t i = 0; i < _size_; i++) {
+        const classification_index_entry & an_entry = _entries_[i];
+        if (channels_ != 0 && (an_entry.channels & channels_) == 0) continue;
+        if (! classifications_.empty() &&
+            std::find(classifications_.begin(), classifications_.end(), an_entry.classification)
+            == classifications_.end()) continue;
+        records_.push_back(an_entry.record);
+      }
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,126 @@
+/** \file falaise/snemo/reconstruction/classification_index.h
+ *
+ * Description:
+ *
+ *   A compact sidecar index of event classifications. Each processed record
+ *   gets a fixed size entry holding its record number, its packed
+ *   classification and the outcomes of a list of channel cuts. The reader
+ *   maps the index in memory so that skims only touch the selected records.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_CLASSIFICATION_INDEX_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_CLASSIFICATION_INDEX_H 1
+
+// Standard library:
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Entry of the classification index
+    struct classification_index_entry {
+      uint64_t record;         //!< Record number within the processed stream
+      uint32_t classification; //!< Packed classification
+      uint32_t channels;       //!< Bitmask of accepted channel cuts
+    };
+
+    /// Pack a classification label such as '2e1g' (6 bits per particle type, saturated)
+    uint32_t pack_classification(const std::string & classification_);
+
+    /// Unpack a classification into its label
+    std::string unpack_classification(uint32_t classification_);
+
+    /// \brief Writer of a classification index file
+    class classification_index_writer
+    {
+    public:
+      /// Constructor
+      classification_index_writer();
+
+      /// Destructor
+      ~classification_index_writer();
+
+      /// Check if a file is open
+      bool is_open() const;
+
+      /// Open an index file for the given channel cut names (32 at most)
+      void open(const std::string & filename_, const std::vector<std::string> & channels_);
+
+      /// Append an entry
+      void append(const classification_index_entry & entry_);
+
+      /// Close the file
+      void close();
+
+    private:
+
+      std::ofstream _out_; //!< Output stream
+    };
+
+    /// \brief Memory mapped reader of a classification index file
+    class classification_index_reader
+    {
+    public:
+      /// Constructor
+      classification_index_reader();
+
+      /// Destructor
+      ~classification_index_reader();
+
+      /// Check if a file is open
+      bool is_open() const;
+
+      /// Map an index file
+      void open(const std::string & filename_);
+
+      /// Unmap the file
+      void close();
+
+      /// Return the channel cut names
+      const std::vector<std::string> & get_channels() const;
+
+      /// Return the bit of a channel cut
+      uint32_t get_channel_bit(const std::string & channel_) const;
+
+      /// Return the number of entries
+      size_t size() const;
+
+      /// Return an entry
+      const classification_index_entry & at(size_t index_) const;
+
+      /// Select the records matching any of the classifications (all if
+      /// empty) and accepted by any of the channel cuts (all if 0)
+      void select(const std::vector<uint32_t> & classifications_,
+                  uint32_t channels_,
+                  std::vector<uint64_t> & records_) const;
+
+    private:
+
+      int _fd_;                                    //!< File descriptor
+      void * _map_;                                //!< Mapped memory
+      size_t _map_size_;                           //!< Size of the mapped memory
+      std::vector<std::string> _channels_;         //!< Channel cut names
+      const classification_index_entry * _entries_; //!< First entry
+      size_t _size_;                               //!< Number of entries
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_CLASSIFICATION_INDEX_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,496 @@
+/// \file falaise/snemo/reconstruction/cut_replay_driver.cc
+
+// Ourselves:
+#include <snemo/reconstruction/cut_replay_driver.h>
+
+// Standard library:
+#include <chrono>
+#include <fstream>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/things.h>
+#include <bayeux/datatools/utils.h>
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/object_configuration_description.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+#include <bayeux/cuts/i_cut.h>
+// - Bayeux/dpp:
+#include <bayeux/dpp/input_module.h>
+#include <bayeux/dpp/output_module.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/cuts/channel_cut.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    cut_replay_driver::cut_counters::cut_counters()
+    {
+      accepted = 0;
+      rejected = 0;
+      inapplicable = 0;
+    }
+
+    cut_replay_driver::replay_report::replay_report()
+    {
+      reset();
+    }
+
+    void cut_replay_driver::replay_report::reset()
+    {
+      number_of_records = 0;
+      number_of_bytes = 0;
+      elapsed_time = 0.0;
+      cut_names.clear();
+      counters.clear();
+      scans.clear();
+    }
+
+    void cut_replay_driver::replay_report::print(std::ostream & out_, const std::string & indent_) const
+    {
+      const double seconds = elapsed_time / CLHEP::second;
+      out_ << indent_ << "Number of records : " << number_of_records << std::endl;
+      out_ << indent_ << "Number of bytes   : " << number_of_bytes << std::endl;
+      out_ << indent_ << "Elapsed time      : " << seconds << " s" << std::endl;
+      if (seconds > 0.0) {
+        out_ << indent_ << "Throughput        : " << number_of_records / seconds << " records/s, "
+             << number_of_bytes / seconds / 1e6 << " MB/s" << std::endl;
+      }
+      for (size_t i = 0; i < cut_names.size(); i++) {
+        const cut_counters & a_counter = counters.at(i);
+        out_ << indent_ << "Cut '" << cut_names.at(i) << "' : "
+             << a_counter.accepted << " accepted, "
+             << a_counter.rejected << " rejected, "
+             << a_counter.inapplicable << " inapplicable" << std::endl;
+      }
+      for (const auto& a_scan : scans) {
+        a_scan.print(out_, indent_);
+      }
+    }
+
+    const std::string & cut_replay_driver::get_id()
+    {
+      static const std::string _id("CRD");
+      return _id;
+    }
+
+    void cut_replay_driver::set_initialized(const bool initialized_)
+    {
+      _initialized_ = initialized_;
+    }
+
+    bool cut_replay_driver::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void cut_replay_driver::set_logging_priority(const datatools::logger::priority priority_)
+    {
+      _logging_priority_ = priority_;
+    }
+
+    datatools::logger::priority cut_replay_driver::get_logging_priority() const
+    {
+      return _logging_priority_;
+    }
+
+    bool cut_replay_driver::has_cut_manager() const
+    {
+      return _cut_manager_ != 0;
+    }
+
+    void cut_replay_driver::set_cut_manager(cuts::cut_manager & cmgr_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error,
+                  "Driver '" << get_id() << "' is already initialized !");
+      _cut_manager_ = &cmgr_;
+    }
+
+    const cuts::cut_manager & cut_replay_driver::get_cut_manager() const
+    {
+      DT_THROW_IF(! has_cut_manager(), std::logic_error,
+                  "No cut manager is setup !");
+      return *_cut_manager_;
+    }
+
+    cuts::cut_manager & cut_replay_driver::get_cut_manager()
+    {
+      DT_THROW_IF(! has_cut_manager(), std::logic_error,
+                  "No cut manager is setup !");
+      return *_cut_manager_;
+    }
+
+    const std::vector<std::string> & cut_replay_driver::get_cut_names() const
+    {
+      return _cut_names_;
+    }
+
+    const std::vector<snemo::cut::measurement_cut_scan> & cut_replay_driver::get_scans() const
+    {
+      return _scans_;
+    }
+
+    // Constructor
+    cut_replay_driver::cut_replay_driver()
+    {
+      _set_defaults();
+      set_initialized(false);
+    }
+
+    // Destructor
+    cut_replay_driver::~cut_replay_driver()
+    {
+      if (is_initialized()) {
+        reset();
+      }
+    }
+
+    void cut_replay_driver::initialize(const datatools::properties & setup_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
+
+      DT_THROW_IF(! has_cut_manager(), std::logic_error, "Missing cut manager !");
+      DT_THROW_IF(! get_cut_manager().is_initialized(), std::logic_error,
+                  "Cut manager is not initialized !");
+
+      // Logging priority
+      datatools::logger::priority lp = datatools::logger::extract_logging_configuration(setup_);
+      DT_THROW_IF(lp == datatools::logger::PRIO_UNDEFINED, std::logic_error,
+                  "Invalid logging priority level for cut replay driver !");
+      set_logging_priority(lp);
+
+      if (setup_.has_key("TD_label")) {
+        _TD_label_ = setup_.fetch_string("TD_label");
+      }
+
+      if (setup_.has_key("output_filename")) {
+        _output_filename_ = setup_.fetch_path("output_filename");
+      }
+
+      if (setup_.has_key("batch_size")) {
+        const int batch_size = setup_.fetch_integer("batch_size");
+        DT_THROW_IF(batch_size <= 0, std::domain_error, "Invalid batch size (" << batch_size << ") !");
+        _batch_size_ = batch_size;
+      }
+
+      DT_THROW_IF(! setup_.has_key("cuts") && ! setup_.has_key("scans"), std::logic_error,
+                  "Missing 'cuts' or 'scans' list !");
+      if (setup_.has_key("cuts")) {
+        setup_.fetch("cuts", _cut_names_);
+      }
+      for (const auto& a_cut_name : _cut_names_) {
+        DT_THROW_IF(! get_cut_manager().has(a_cut_name), std::logic_error,
+                    "No cut '" << a_cut_name << "' has been registered !");
+        _cuts_.push_back(&get_cut_manager().grab(a_cut_name));
+      }
+
+      if (setup_.has_key("scans")) {
+        std::vector<std::string> scan_names;
+        setup_.fetch("scans", scan_names);
+        for (const auto& a_scan_name : scan_names) {
+          datatools::properties scan_config;
+          setup_.export_and_rename_starting_with(scan_config, "scan." + a_scan_name + ".", "");
+          _scans_.push_back(snemo::cut::measurement_cut_scan());
+          _scans_.back().initialize(scan_config);
+        }
+      }
+
+      set_initialized(true);
+    }
+
+    void cut_replay_driver::reset()
+    {
+      _set_defaults();
+      set_initialized(false);
+    }
+
+    void cut_replay_driver::_set_defaults()
+    {
+      _logging_priority_ = datatools::logger::PRIO_WARNING;
+      _cut_manager_ = 0;
+      _cut_names_.clear();
+      _cuts_.clear();
+      _scans_.clear();
+      _TD_label_ = "TD";
+      _output_filename_.clear();
+      _batch_size_ = snemo::cut::batch_selection::WORD_SIZE;
+    }
+
+    void cut_replay_driver::process(const datatools::things & record_, std::vector<int> & statuses_)
+    {
+      const std::vector<const datatools::things *> records(1, &record_);
+      std::vector<snemo::cut::batch_selection> selections;
+      process(records, selections);
+      statuses_.resize(selections.size());
+      for (size_t i = 0; i < selections.size(); i++) {
+        statuses_[i] = selections[i].get_status(0);
+      }
+    }
+
+    void cut_replay_driver::process(const std::vector<const datatools::things *> & records_,
+                                    std::vector<snemo::cut::batch_selection> & selections_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+
+      // All the grid points of a scan are evaluated from a single lookup of
+      // the measurement
+      if (! _scans_.empty()) {
+        for (const datatools::things * a_record : records_) {
+          const snemo::datamodel::base_topology_pattern * a_pattern = nullptr;
+          if (a_record->has(_TD_label_)) {
+            const auto& TD = a_record->get<snemo::datamodel::topology_data>(_TD_label_);
+            if (TD.has_pattern()) a_pattern = &TD.get_pattern();
+          } else {
+            DT_LOG_DEBUG(get_logging_priority(), "Event record has no '" << _TD_label_ << "' bank !");
+          }
+          for (auto& a_scan : _scans_) a_scan.fill(a_pattern);
+        }
+      }
+
+      const size_t n = records_.size();
+      selections_.resize(_cuts_.size());
+      for (size_t i = 0; i < _cuts_.size(); i++) {
+        cuts::i_cut & a_cut = *_cuts_[i];
+        snemo::cut::batch_selection & a_selection = selections_[i];
+        snemo::cut::channel_cut * a_channel_cut = dynamic_cast<snemo::cut::channel_cut *>(&a_cut);
+        if (a_channel_cut != nullptr) {
+          a_channel_cut->select_records(records_, a_selection);
+          continue;
+        }
+        a_selection.reset(n);
+        for (size_t j = 0; j < n; j++) {
+          a_cut.set_user_data(*records_[j]);
+          a_selection.set_status(j, a_cut.process());
+          a_cut.reset_user_data();
+        }
+      }
+    }
+
+    void cut_replay_driver::process(const std::vector<std::string> & filenames_, replay_report & report_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      DT_THROW_IF(filenames_.empty(), std::logic_error, "Missing data files to replay !");
+
+      report_.reset();
+      report_.cut_names = _cut_names_;
+      report_.counters.assign(_cut_names_.size(), cut_counters());
+      for (auto& a_scan : _scans_) a_scan.clear_counters();
+
+      std::vector<std::string> filenames;
+      for (const auto& a_filename : filenames_) {
+        std::string a_path = a_filename;
+        datatools::fetch_path_with_env(a_path);
+        std::ifstream a_file(a_path.c_str(), std::ios::binary | std::ios::ate);
+        DT_THROW_IF(! a_file, std::runtime_error, "Cannot open data file '" << a_path << "' !");
+        report_.number_of_bytes += a_file.tellg();
+        filenames.push_back(a_path);
+      }
+
+      dpp::input_module reader;
+      datatools::properties reader_config;
+      reader_config.store("logging.priority", datatools::logger::get_priority_label(get_logging_priority()));
+      reader_config.store("files.mode", "list");
+      reader_config.store("files.list.filenames", filenames);
+      reader.initialize_standalone(reader_config);
+
+      // Records are reduced to their topology data bank so that later replays
+      // of the output file only deserialize what the cuts need
+      dpp::output_module writer;
+      if (! _output_filename_.empty()) {
+        datatools::properties writer_config;
+        writer_config.store("logging.priority", datatools::logger::get_priority_label(get_logging_priority()));
+        writer_config.store("files.mode", "single");
+        writer_config.store("files.single.filename", _output_filename_);
+        writer.initialize_standalone(writer_config);
+      }
+
+      // Records are read by blocks so that channel cuts select them together
+      const auto start = std::chrono::steady_clock::now();
+      std::vector<datatools::things> block(_batch_size_);
+      std::vector<const datatools::things *> records;
+      records.reserve(_batch_size_);
+      std::vector<snemo::cut::batch_selection> selections;
+      std::vector<std::string> bank_names;
+      while (! reader.is_terminated()) {
+        records.clear();
+        while (records.size() < _batch_size_ && ! reader.is_terminated()) {
+          datatools::things & a_record = block[records.size()];
+          a_record.clear();
+          const dpp::base_module::process_status status = reader.process(a_record);
+          DT_THROW_IF(status != dpp::base_module::PROCESS_SUCCESS, std::runtime_error,
+                      "Reading event record #" << report_.number_of_records + records.size() << " has failed !");
+          records.push_back(&a_record);
+        }
+
+        process(records, selections);
+        report_.number_of_records += records.size();
+        for (size_t i = 0; i < selections.size(); i++) {
+          cut_counters & a_counter = report_.counters[i];
+          a_counter.accepted += selections[i].count(cuts::SELECTION_ACCEPTED);
+          a_counter.rejected += selections[i].count(cuts::SELECTION_REJECTED);
+          a_counter.inapplicable += selections[i].count(cuts::SELECTION_INAPPLICABLE);
+        }
+
+        if (writer.is_initialized()) {
+          for (size_t j = 0; j < records.size(); j++) {
+            datatools::things & a_record = block[j];
+            a_record.get_names(bank_names);
+            for (const auto& a_bank_name : bank_names) {
+              if (a_bank_name != _TD_label_) a_record.remove(a_bank_name);
+            }
+            writer.process(a_record);
+          }
+        }
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      report_.elapsed_time = elapsed.count() * CLHEP::second;
+      report_.scans = _scans_;
+
+      if (writer.is_initialized()) writer.reset();
+      reader.reset();
+
+      if (get_logging_priority() >= datatools::logger::PRIO_DEBUG) {
+        DT_LOG_DEBUG(get_logging_priority(), "Replay report: ");
+        report_.print(std::clog, "[debug]: ");
+      }
+    }
+
+    // static
+    void cut_replay_driver::init_ocd(datatools::object_configuration_description & ocd_)
+    {
+      datatools::logger::declare_ocd_logging_configuration(ocd_, "warning");
+
+      {
+        // Description of the 'cuts' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("cuts")
+          .set_terse_description("List of the cuts to replay")
+          .set_traits(datatools::TYPE_STRING,
+                      datatools::configuration_property_description::ARRAY)
+          .set_mandatory(false)
+          .set_long_description("Cuts are fetched from the cut manager and get the full   \n"
+                                "event record, as the 'dpp::if_module' does.              \n")
+          .add_example("Replay the 2e channel cut::                            \n"
+                       "                                                       \n"
+                       "  cuts : string[1] = \"2e::channel_cut\"               \n"
+                       "                                                       \n"
+                       );
+      }
+
+      {
+        // Description of the 'scans' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("scans")
+          .set_terse_description("List of the threshold scans")
+          .set_traits(datatools::TYPE_STRING,
+                      datatools::configuration_property_description::ARRAY)
+          .set_mandatory(false)
+          .set_long_description("Each scan evaluates a grid of range thresholds of a       \n"
+                                "measurement cut in the same pass over the records. Scans  \n"
+                                "are configured by the 'scan.<name>.' prefixed properties: \n"
+                                "'measurement_label', 'quantity' (the 'XXX' of the         \n"
+                                "'mode.range_XXX' cut mode) and the 'min' and/or 'max'     \n"
+                                "thresholds, given as arrays or regularly spaced through   \n"
+                                "'first', 'last' and 'points'.                             \n")
+          .add_example("Scan the minimal internal probability of a 2e channel::  \n"
+                       "                                                         \n"
+                       "  scans : string[1] = \"int_prob\"                       \n"
+                       "  scan.int_prob.measurement_label : string = \"tof_e1_e2\" \n"
+                       "  scan.int_prob.quantity : string = \"internal_probability\" \n"
+                       "  scan.int_prob.min.first : real as fraction = 0 %       \n"
+                       "  scan.int_prob.min.last : real as fraction = 10 %       \n"
+                       "  scan.int_prob.min.points : integer = 21                \n"
+                       "                                                         \n"
+                       );
+      }
+
+      {
+        // Description of the 'batch_size' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("batch_size")
+          .set_terse_description("Number of records read and selected at once")
+          .set_traits(datatools::TYPE_INTEGER)
+          .set_mandatory(false)
+          .set_default_value_integer(64)
+          .set_long_description("Channel cuts select a whole block of records through \n"
+                                "their batch measurement cuts.                        \n")
+          .add_example("Select blocks of 256 records::                         \n"
+                       "                                                       \n"
+                       "  batch_size : integer = 256                           \n"
+                       "                                                       \n"
+                       );
+      }
+
+      {
+        // Description of the 'TD_label' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("TD_label")
+          .set_terse_description("The label/name of the topology data bank")
+          .set_traits(datatools::TYPE_STRING)
+          .set_mandatory(false)
+          .set_default_value_string("TD")
+          .add_example("Use an alternative name for the topology data bank:: \n"
+                       "                                                     \n"
+                       "  TD_label : string = \"TD2\"                        \n"
+                       "                                                     \n"
+                       );
+      }
+
+      {
+        // Description of the 'output_filename' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("output_filename")
+          .set_terse_description("Data file to store the replayed records")
+          .set_traits(datatools::TYPE_STRING)
+          .set_path(true)
+          .set_mandatory(false)
+          .set_long_description("Records are stored with their topology data bank only, \n"
+                                "which makes subsequent replays cheaper.                \n")
+          .add_example("Store the reduced records::                            \n"
+                       "                                                       \n"
+                       "  output_filename : string as path = \"td_only.brio\"   \n"
+                       "                                                       \n"
+                       );
+      }
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+/* OCD support */
+#include <datatools/object_configuration_description.h>
+DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::cut_replay_driver, ocd_)
+{
+  ocd_.set_class_name("snemo::reconstruction::cut_replay_driver");
+  ocd_.set_class_description("A driver class to replay cuts over stored topology data");
+  ocd_.set_class_library("Falaise_ParticleIdentification");
+  ocd_.set_class_documentation("The driver reads event records from data files and   \n"
+                               "re-evaluates a list of cuts on each of them.");
+
+  // Invoke specific OCD support :
+  ::snemo::reconstruction::cut_replay_driver::init_ocd(ocd_);
+
+  ocd_.set_validation_support(true);
+  ocd_.lock();
+}
+DOCD_CLASS_IMPLEMENT_LOAD_END() // Closing macro for implementation
+DOCD_CLASS_SYSTEM_REGISTRATION(snemo::reconstruction::cut_replay_driver,
+                               "snemo::reconstruction::cut_replay_driver")
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,171 @@
+/** \file falaise/snemo/reconstruction/cut_replay_driver.h
+ *
+ * Description:
+ *
+ *   A driver class that re-evaluates cuts over topology data banks stored
+ *   in data files, without running the reconstruction pipeline again.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_CUT_REPLAY_DRIVER_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_CUT_REPLAY_DRIVER_H 1
+
+// Standard library:
+#include <iostream>
+#include <string>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/logger.h>
+
+// This project:
+#include <falaise/snemo/cuts/batch_selection.h>
+#include <falaise/snemo/cuts/measurement_cut_scan.h>
+
+namespace datatools {
+  class things;
+}
+
+namespace cuts {
+  class cut_manager;
+  class i_cut;
+}
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Driver to replay cuts over stored topology data
+    class cut_replay_driver
+    {
+    public:
+
+      /// Selection counters of a replayed cut
+      struct cut_counters {
+        cut_counters();
+        size_t accepted;     //!< Number of accepted records
+        size_t rejected;     //!< Number of rejected records
+        size_t inapplicable; //!< Number of records the cut does not apply to
+      };
+
+      /// Statistics of a replay
+      struct replay_report {
+        replay_report();
+
+        /// Reset the statistics
+        void reset();
+
+        /// Print the statistics
+        void print(std::ostream & out_ = std::clog, const std::string & indent_ = "") const;
+
+        size_t number_of_records;          //!< Number of replayed event records
+        size_t number_of_bytes;            //!< Size of the replayed data files
+        double elapsed_time;               //!< Wall clock time spent reading records and evaluating cuts
+        std::vector<std::string> cut_names; //!< Names of the replayed cuts
+        std::vector<cut_counters> counters; //!< Selection counters, one per replayed cut
+        std::vector<snemo::cut::measurement_cut_scan> scans; //!< Threshold scans
+      };
+
+      /// Algorithm id
+      static const std::string & get_id();
+
+    public:
+      /// Constructor
+      cut_replay_driver();
+
+      /// Destructor
+      virtual ~cut_replay_driver();
+
+      /// Initialization flag
+      void set_initialized(const bool initialized_);
+
+      /// Getting initialization flag
+      bool is_initialized() const;
+
+      /// Setting logging priority
+      void set_logging_priority(const datatools::logger::priority priority_);
+
+      /// Getting logging priority
+      datatools::logger::priority get_logging_priority() const;
+
+      /// Check the cut manager
+      bool has_cut_manager() const;
+
+      /// Address the cut manager
+      void set_cut_manager(cuts::cut_manager & cmgr_);
+
+      /// Return a non-mutable reference to the cut manager
+      const cuts::cut_manager & get_cut_manager() const;
+
+      /// Return a mutable reference to the cut manager
+      cuts::cut_manager & get_cut_manager();
+
+      /// Return the names of the replayed cuts
+      const std::vector<std::string> & get_cut_names() const;
+
+      /// Return the threshold scans
+      const std::vector<snemo::cut::measurement_cut_scan> & get_scans() const;
+
+      /// Initialize the driver through configuration properties
+      virtual void initialize(const datatools::properties & setup_);
+
+      /// Reset the driver
+      virtual void reset();
+
+      /// Evaluate the cuts on one event record and return the status of each cut
+      ///
+      /// The record is also counted by the threshold scans.
+      void process(const datatools::things & record_, std::vector<int> & statuses_);
+
+      /// Evaluate the cuts on a block of event records and return the selection of each cut
+      ///
+      /// Channel cuts select the whole block at once, other cuts process
+      /// the records one by one. The records are also counted by the
+      /// threshold scans.
+      void process(const std::vector<const datatools::things *> & records_,
+                   std::vector<snemo::cut::batch_selection> & selections_);
+
+      /// Replay the cuts over a list of data files
+      void process(const std::vector<std::string> & filenames_, replay_report & report_);
+
+      /// OCD support:
+      static void init_ocd(datatools::object_configuration_description & ocd_);
+
+    protected:
+
+      /// Set default values to class members
+      void _set_defaults();
+
+    private:
+
+      bool _initialized_;                             //!< Initialize flag
+      datatools::logger::priority _logging_priority_; //!< Logging priority
+      cuts::cut_manager * _cut_manager_;              //!< The SuperNEMO cut manager
+      std::vector<std::string> _cut_names_;           //!< Names of the replayed cuts
+      std::vector<cuts::i_cut *> _cuts_;              //!< Replayed cuts
+      std::vector<snemo::cut::measurement_cut_scan> _scans_; //!< Threshold scans
+      std::string _TD_label_;                         //!< Label of the topology data bank
+      std::string _output_filename_;                  //!< Data file to store records reduced to the topology data bank
+      size_t _batch_size_;                            //!< Number of records read and selected at once
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+
+// Declare the OCD interface of the module
+#include <datatools/ocd_macros.h>
+DOCD_CLASS_DECLARATION(snemo::reconstruction::cut_replay_driver)
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_CUT_REPLAY_DRIVER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -15,6 +15,47 @@ namespace snemo {
 
   namespace reconstruction {
 
+    void calorimeter_summary::fill(const std::vector<const snemo::datamodel::particle_track *> & particles_)
+    {
+      const size_t nparticles = particles_.size();
+      energies.assign(nparticles, datatools::invalid_real());
+      first_energies.assign(nparticles, datatools::invalid_real());
+      first_times.assign(nparticles, datatools::invalid_real());
+      first_sigma_times.assign(nparticles, datatools::invalid_real());
+
+      for (size_t i = 0; i < nparticles; i++) {
+        const snemo::datamodel::particle_track & a_particle = *particles_[i];
+        if (! a_particle.has_associated_calorimeter_hits()) continue;
+        const auto& the_calos = a_particle.get_associated_calorimeter_hits();
+        if (the_calos.empty()) continue;
+        double energy = 0.0;
+        for (const auto& icalo : the_calos) {
+          energy += icalo.get().get_energy();
+        }
+        energies[i] = energy;
+        // Charged particles can be associated to several calorimeter hits
+        // given the spatial resolution of the track fit: the first one is
+        // the reference for timing
+        const snemo::datamodel::calibrated_calorimeter_hit & first_calo = the_calos.front().get();
+        first_energies[i] = first_calo.get_energy();
+        first_times[i] = first_calo.get_time();
+        first_sigma_times[i] = first_calo.get_sigma_time();
+      }
+    }
+
+    void calorimeter_summary::clear()
+    {
+      energies.clear();
+      first_energies.clear();
+      first_times.clear();
+      first_sigma_times.clear();
+    }
+
+    size_t calorimeter_summary::size() const
+    {
+      return energies.size();
+    }
+
     const std::string & energy_driver::get_id()
     {
       static const std::string _id("ED");
@@ -84,22 +125,31 @@ namespace snemo {
     }
 
     void energy_driver::process(const snemo::datamodel::particle_track & pt_,
-                                snemo::datamodel::energy_measurement & energy_)
+                                snemo::datamodel::energy_measurement & energy_) const
     {
       DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
       this->_process_algo(pt_, energy_.get_energy());
     }
 
+    void energy_driver::process(const calorimeter_summary & calorimeters_, size_t index_,
+                                snemo::datamodel::energy_measurement & energy_) const
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      DT_THROW_IF(index_ >= calorimeters_.size(), std::range_error,
+                  "Invalid particle index '" << index_ << "' !");
+      energy_.get_energy() = calorimeters_.energies[index_];
+    }
+
     void energy_driver::_process_algo(const snemo::datamodel::particle_track & pt_,
-                                      double & energy_)
+                                      double & energy_) const
     {
       // Invalidate result
       datatools::invalidate(energy_);
 
       if (pt_.has_associated_calorimeter_hits()) {
-        auto the_calos = pt_.get_associated_calorimeter_hits();
+        const auto& the_calos = pt_.get_associated_calorimeter_hits();
         for (auto icalo = the_calos.begin(); icalo != the_calos.end(); ++icalo) {
-          auto a_calo = icalo->get();
+          const auto& a_calo = icalo->get();
           icalo == the_calos.begin() ? energy_ = a_calo.get_energy() : energy_ += a_calo.get_energy();
         }
       }
@@ -33,6 +33,7 @@
 
 // Standard library:
 #include <string>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools:
@@ -47,6 +48,28 @@ namespace snemo {
 
   namespace reconstruction {
 
+    /// Calorimeter quantities of the particles of an event
+    ///
+    /// The associated calorimeter hits of every particle are read once and
+    /// the results are stored in contiguous arrays indexed by particle.
+    /// Values are invalid for particles without associated calorimeter hits.
+    struct calorimeter_summary
+    {
+      /// Extract the calorimeter quantities of a set of particles
+      void fill(const std::vector<const snemo::datamodel::particle_track *> & particles_);
+
+      /// Remove all entries
+      void clear();
+
+      /// Return the number of particles
+      size_t size() const;
+
+      std::vector<double> energies;          //!< Sum of the calorimeter hit energies
+      std::vector<double> first_energies;    //!< Energy of the first calorimeter hit
+      std::vector<double> first_times;       //!< Time of the first calorimeter hit
+      std::vector<double> first_sigma_times; //!< Time resolution of the first calorimeter hit
+    };
+
     /// Driver for the gamma clustering algorithms
     class energy_driver
     {
@@ -71,7 +94,11 @@ namespace snemo {
 
       /// Main process
       void process(const snemo::datamodel::particle_track & pt_,
-                   snemo::datamodel::energy_measurement & energy_);
+                   snemo::datamodel::energy_measurement & energy_) const;
+
+      /// Process a particle from the event calorimeter summary
+      void process(const calorimeter_summary & calorimeters_, size_t index_,
+                   snemo::datamodel::energy_measurement & energy_) const;
 
       /// Check if theclusterizer is initialized
       bool is_initialized() const;
@@ -95,7 +122,7 @@ namespace snemo {
 
       /// Special method to process and generate particle track data
       void _process_algo(const snemo::datamodel::particle_track & pt_,
-                         double & energy_);
+                         double & energy_) const;
 
     private:
       bool                        _initialized_;      //!< Initialization status
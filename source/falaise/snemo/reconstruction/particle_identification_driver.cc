@@ -49,8 +49,10 @@ namespace snemo {
 
     void particle_identification_driver::set_cut_manager(cuts::cut_manager & cmgr_)
     {
-      DT_THROW_IF(is_initialized(), std::logic_error,
-                  "Driver is already initialized !");
+      DT_THROW_IF(has_cut_manager(), std::logic_error,
+                  "Driver already has a cut manager !");
+      DT_THROW_IF(! cmgr_.is_initialized(), std::logic_error,
+                  "Cut manager is not initialized !");
       _cut_manager_ = &cmgr_;
     }
 
@@ -103,9 +105,8 @@ namespace snemo {
     {
       DT_THROW_IF(is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
 
-      DT_THROW_IF(! has_cut_manager(), std::logic_error, "Missing cut manager !");
-      DT_THROW_IF(! get_cut_manager().is_initialized(), std::logic_error,
-                  "Cut manager is not initialized !");
+      // The cut manager is only needed to process particles, and may be set
+      // after the configuration has been checked
 
       // Logging priority
       datatools::logger::priority lp = datatools::logger::extract_logging_configuration(setup_);
@@ -163,6 +164,7 @@ namespace snemo {
     {
       int status = 0;
       DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
+      DT_THROW_IF(! has_cut_manager(), std::logic_error, "Missing cut manager !");
 
       status = _process_algo(ptd_);
       if (status != 0) {
@@ -87,7 +87,7 @@ namespace snemo {
       /// Check the cut manager
       bool has_cut_manager() const;
 
-      /// Address the cut manager
+      /// Address the cut manager, before or after initialization but before processing
       void set_cut_manager(cuts::cut_manager & cmgr_);
 
       /// Return a non-mutable reference to the cut manager
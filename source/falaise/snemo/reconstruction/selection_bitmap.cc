@@ -0,0 +1,571 @@
+/// \file falaise/snemo/reconstruction/selection_bitmap.cc
+
+// Ourselves:
+#include <snemo/reconstruction/selection_bitmap.h>
+
+// Standard library:
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/i_cut.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+      /// Chunk of a record and offset of the record in its chunk
+      const uint32_t chunk_bits = 16;
+      const uint64_t offset_mask = (1 << chunk_bits) - 1;
+
+      /// File layout: magic, number of records, number of cuts, then the
+      /// name, accepted and rejected bitmaps of each cut
+      const char selection_magic[8] = {'S', 'N', 'P', 'I', 'D', 'S', '0', '1'};
+
+      uint32_t popcount(uint64_t word_)
+      {
+        return __builtin_popcountll(word_);
+      }
+
+      template<typename T>
+      void write_value(std::ostream & out_, const T & value_)
+      {
+        out_.write(reinterpret_cast<const char *>(&value_), sizeof(T));
+      }
+
+      template<typename T>
+      void read_value(std::istream & in_, T & value_)
+      {
+        in_.read(reinterpret_cast<char *>(&value_), sizeof(T));
+        DT_THROW_IF(! in_, std::runtime_error, "Truncated selection bitmap !");
+      }
+    }
+
+    // Containers:
+
+    bool selection_bitmap::container::contains(uint16_t offset_) const
+    {
+      if (is_bitset()) return (bits[offset_ >> 6] >> (offset_ & 63)) & 1;
+      return std::binary_search(array.begin(), array.end(), offset_);
+    }
+
+    void selection_bitmap::container::to_bitset()
+    {
+      if (is_bitset()) return;
+      bits.assign(BITSET_WORDS, 0);
+      for (const uint16_t an_offset : array) {
+        bits[an_offset >> 6] |= uint64_t(1) << (an_offset & 63);
+      }
+      array.clear();
+      array.shrink_to_fit();
+    }
+
+    void selection_bitmap::container::optimize()
+    {
+      if (! is_bitset()) return;
+      cardinality = 0;
+      for (const uint64_t a_word : bits) cardinality += popcount(a_word);
+      if (cardinality > MAX_ARRAY_SIZE) return;
+      array.clear();
+      array.reserve(cardinality);
+      for (uint32_t i = 0; i < BITSET_WORDS; i++) {
+        for (uint64_t a_word = bits[i]; a_word != 0; a_word &= a_word - 1) {
+          array.push_back((i << 6) + __builtin_ctzll(a_word));
+        }
+      }
+      bits.clear();
+      bits.shrink_to_fit();
+    }
+
+    // Bitmap:
+
+    selection_bitmap::selection_bitmap()
+    {
+    }
+
+    selection_bitmap selection_bitmap::make_range(uint64_t n_)
+    {
+      selection_bitmap range;
+      for (uint64_t a_key = 0; (a_key << chunk_bits) < n_; a_key++) {
+        container a_container;
+        a_container.key = a_key;
+        a_container.bits.assign(BITSET_WORDS, ~uint64_t(0));
+        const uint64_t end = std::min(n_ - (a_key << chunk_bits), offset_mask + 1);
+        for (uint64_t i = end; i <= offset_mask; i++) {
+          a_container.bits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+        }
+        a_container.optimize();
+        range._containers_.push_back(a_container);
+      }
+      return range;
+    }
+
+    bool selection_bitmap::empty() const
+    {
+      return _containers_.empty();
+    }
+
+    void selection_bitmap::clear()
+    {
+      _containers_.clear();
+    }
+
+    const selection_bitmap::container * selection_bitmap::_find_(uint64_t key_) const
+    {
+      auto it = std::lower_bound(_containers_.begin(), _containers_.end(), key_,
+                                 [](const container & c_, uint64_t k_) { return c_.key < k_; });
+      if (it == _containers_.end() || it->key != key_) return nullptr;
+      return &*it;
+    }
+
+    void selection_bitmap::add(uint64_t record_)
+    {
+      const uint64_t a_key = record_ >> chunk_bits;
+      const uint16_t an_offset = record_ & offset_mask;
+      // Records mostly come in increasing order: check the last chunk first
+      std::vector<container>::iterator it;
+      if (! _containers_.empty() && _containers_.back().key == a_key) {
+        it = _containers_.end() - 1;
+      } else {
+        it = std::lower_bound(_containers_.begin(), _containers_.end(), a_key,
+                              [](const container & c_, uint64_t k_) { return c_.key < k_; });
+        if (it == _containers_.end() || it->key != a_key) {
+          container a_container;
+          a_container.key = a_key;
+          a_container.cardinality = 0;
+          it = _containers_.insert(it, a_container);
+        }
+      }
+      if (it->contains(an_offset)) return;
+      if (it->is_bitset()) {
+        it->bits[an_offset >> 6] |= uint64_t(1) << (an_offset & 63);
+      } else if (it->array.empty() || it->array.back() < an_offset) {
+        it->array.push_back(an_offset);
+      } else {
+        it->array.insert(std::lower_bound(it->array.begin(), it->array.end(), an_offset), an_offset);
+      }
+      it->cardinality++;
+      if (! it->is_bitset() && it->cardinality > MAX_ARRAY_SIZE) it->to_bitset();
+    }
+
+    bool selection_bitmap::contains(uint64_t record_) const
+    {
+      const container * a_container = _find_(record_ >> chunk_bits);
+      return a_container != nullptr && a_container->contains(record_ & offset_mask);
+    }
+
+    uint64_t selection_bitmap::cardinality() const
+    {
+      uint64_t n = 0;
+      for (const auto & a_container : _containers_) n += a_container.cardinality;
+      return n;
+    }
+
+    void selection_bitmap::get_records(std::vector<uint64_t> & records_) const
+    {
+      records_.clear();
+      records_.reserve(cardinality());
+      for (const auto & a_container : _containers_) {
+        const uint64_t base = a_container.key << chunk_bits;
+        if (! a_container.is_bitset()) {
+          for (const uint16_t an_offset : a_container.array) records_.push_back(base + an_offset);
+          continue;
+        }
+        for (uint32_t i = 0; i < BITSET_WORDS; i++) {
+          for (uint64_t a_word = a_container.bits[i]; a_word != 0; a_word &= a_word - 1) {
+            records_.push_back(base + (i << 6) + __builtin_ctzll(a_word));
+          }
+        }
+      }
+    }
+
+    void selection_bitmap::intersect_with(const selection_bitmap & other_)
+    {
+      std::vector<container> result;
+      for (auto & a_container : _containers_) {
+        const container * other = other_._find_(a_container.key);
+        if (other == nullptr) continue;
+        if (a_container.is_bitset() && other->is_bitset()) {
+          for (uint32_t i = 0; i < BITSET_WORDS; i++) a_container.bits[i] &= other->bits[i];
+          a_container.optimize();
+        } else {
+          // Sparse result: keep the offsets of the sparse side found in the other one
+          const container & sparse = a_container.is_bitset() ? *other : a_container;
+          const container & dense = a_container.is_bitset() ? a_container : *other;
+          std::vector<uint16_t> offsets;
+          for (const uint16_t an_offset : sparse.array) {
+            if (dense.contains(an_offset)) offsets.push_back(an_offset);
+          }
+          a_container.bits.clear();
+          a_container.array.swap(offsets);
+          a_container.cardinality = a_container.array.size();
+        }
+        if (a_container.cardinality > 0) result.push_back(std::move(a_container));
+      }
+      _containers_.swap(result);
+    }
+
+    void selection_bitmap::unite_with(const selection_bitmap & other_)
+    {
+      std::vector<container> result;
+      result.reserve(_containers_.size() + other_._containers_.size());
+      auto it = _containers_.begin();
+      for (const auto & other : other_._containers_) {
+        while (it != _containers_.end() && it->key < other.key) result.push_back(std::move(*it++));
+        if (it == _containers_.end() || it->key != other.key) {
+          result.push_back(other);
+          continue;
+        }
+        container a_container = std::move(*it++);
+        if (! a_container.is_bitset() && ! other.is_bitset()
+            && a_container.array.size() + other.array.size() <= MAX_ARRAY_SIZE) {
+          std::vector<uint16_t> offsets;
+          std::set_union(a_container.array.begin(), a_container.array.end(),
+                         other.array.begin(), other.array.end(), std::back_inserter(offsets));
+          a_container.array.swap(offsets);
+          a_container.cardinality = a_container.array.size();
+        } else {
+          a_container.to_bitset();
+          if (other.is_bitset()) {
+            for (uint32_t i = 0; i < BITSET_WORDS; i++) a_container.bits[i] |= other.bits[i];
+          } else {
+            for (const uint16_t an_offset : other.array) {
+              a_container.bits[an_offset >> 6] |= uint64_t(1) << (an_offset & 63);
+            }
+          }
+          a_container.optimize();
+        }
+        result.push_back(std::move(a_container));
+      }
+      while (it != _containers_.end()) result.push_back(std::move(*it++));
+      _containers_.swap(result);
+    }
+
+    void selection_bitmap::subtract(const selection_bitmap & other_)
+    {
+      std::vector<container> result;
+      for (auto & a_container : _containers_) {
+        const container * other = other_._find_(a_container.key);
+        if (other != nullptr) {
+          if (a_container.is_bitset()) {
+            if (other->is_bitset()) {
+              for (uint32_t i = 0; i < BITSET_WORDS; i++) a_container.bits[i] &= ~other->bits[i];
+            } else {
+              for (const uint16_t an_offset : other->array) {
+                a_container.bits[an_offset >> 6] &= ~(uint64_t(1) << (an_offset & 63));
+              }
+            }
+            a_container.optimize();
+          } else {
+            std::vector<uint16_t> offsets;
+            for (const uint16_t an_offset : a_container.array) {
+              if (! other->contains(an_offset)) offsets.push_back(an_offset);
+            }
+            a_container.array.swap(offsets);
+            a_container.cardinality = a_container.array.size();
+          }
+        }
+        if (a_container.cardinality > 0) result.push_back(std::move(a_container));
+      }
+      _containers_.swap(result);
+    }
+
+    void selection_bitmap::write(std::ostream & out_) const
+    {
+      write_value(out_, uint64_t(_containers_.size()));
+      for (const auto & a_container : _containers_) {
+        write_value(out_, a_container.key);
+        write_value(out_, a_container.cardinality);
+        if (a_container.is_bitset()) {
+          out_.write(reinterpret_cast<const char *>(a_container.bits.data()),
+                     BITSET_WORDS * sizeof(uint64_t));
+        } else {
+          out_.write(reinterpret_cast<const char *>(a_container.array.data()),
+                     a_container.array.size() * sizeof(uint16_t));
+        }
+      }
+    }
+
+    void selection_bitmap::read(std::istream & in_)
+    {
+      clear();
+      uint64_t n_containers = 0;
+      read_value(in_, n_containers);
+      _containers_.resize(n_containers);
+      for (auto & a_container : _containers_) {
+        read_value(in_, a_container.key);
+        read_value(in_, a_container.cardinality);
+        DT_THROW_IF(a_container.cardinality == 0 || a_container.cardinality > offset_mask + 1,
+                    std::runtime_error, "Invalid selection bitmap chunk !");
+        // The cardinality tells the kind of the container, as for the writer
+        if (a_container.cardinality > MAX_ARRAY_SIZE) {
+          a_container.bits.resize(BITSET_WORDS);
+          in_.read(reinterpret_cast<char *>(a_container.bits.data()), BITSET_WORDS * sizeof(uint64_t));
+        } else {
+          a_container.array.resize(a_container.cardinality);
+          in_.read(reinterpret_cast<char *>(a_container.array.data()),
+                   a_container.cardinality * sizeof(uint16_t));
+        }
+        DT_THROW_IF(! in_, std::runtime_error, "Truncated selection bitmap !");
+      }
+    }
+
+    // Set of selections:
+
+    selection_bitmap_set::selection_bitmap_set()
+    {
+      _number_of_records_ = 0;
+    }
+
+    void selection_bitmap_set::clear()
+    {
+      _number_of_records_ = 0;
+      _names_.clear();
+      _accepted_.clear();
+      _rejected_.clear();
+    }
+
+    void selection_bitmap_set::set_names(const std::vector<std::string> & names_)
+    {
+      clear();
+      _names_ = names_;
+      _accepted_.resize(_names_.size());
+      _rejected_.resize(_names_.size());
+    }
+
+    const std::vector<std::string> & selection_bitmap_set::get_names() const
+    {
+      return _names_;
+    }
+
+    uint64_t selection_bitmap_set::get_number_of_records() const
+    {
+      return _number_of_records_;
+    }
+
+    void selection_bitmap_set::set_number_of_records(uint64_t n_)
+    {
+      _number_of_records_ = n_;
+    }
+
+    void selection_bitmap_set::add(uint64_t record_, size_t cut_, int status_)
+    {
+      DT_THROW_IF(cut_ >= _names_.size(), std::range_error, "Invalid cut index " << cut_ << " !");
+      if (status_ == cuts::SELECTION_ACCEPTED) _accepted_[cut_].add(record_);
+      else if (status_ == cuts::SELECTION_REJECTED) _rejected_[cut_].add(record_);
+      _number_of_records_ = std::max(_number_of_records_, record_ + 1);
+    }
+
+    size_t selection_bitmap_set::_index_(const std::string & name_) const
+    {
+      auto it = std::find(_names_.begin(), _names_.end(), name_);
+      DT_THROW_IF(it == _names_.end(), std::logic_error, "No selection for cut '" << name_ << "' !");
+      return it - _names_.begin();
+    }
+
+    const selection_bitmap & selection_bitmap_set::get_accepted(const std::string & name_) const
+    {
+      return _accepted_[_index_(name_)];
+    }
+
+    const selection_bitmap & selection_bitmap_set::get_rejected(const std::string & name_) const
+    {
+      return _rejected_[_index_(name_)];
+    }
+
+    void selection_bitmap_set::append(const selection_bitmap_set & other_)
+    {
+      if (_names_.empty() && _number_of_records_ == 0) {
+        *this = other_;
+        return;
+      }
+      DT_THROW_IF(other_._names_ != _names_, std::logic_error,
+                  "Cannot append selections of different cuts !");
+      const uint64_t offset = _number_of_records_;
+      std::vector<uint64_t> records;
+      for (size_t i = 0; i < _names_.size(); i++) {
+        other_._accepted_[i].get_records(records);
+        for (const uint64_t a_record : records) _accepted_[i].add(offset + a_record);
+        other_._rejected_[i].get_records(records);
+        for (const uint64_t a_record : records) _rejected_[i].add(offset + a_record);
+      }
+      _number_of_records_ += other_._number_of_records_;
+    }
+
+    namespace {
+
+      /// Recursive descent parser of the selection queries
+      class query_parser
+      {
+      public:
+
+        query_parser(const selection_bitmap_set & set_, const std::string & query_)
+          : _set_(set_), _query_(query_), _pos_(0)
+        {
+        }
+
+        void parse(selection_bitmap & result_)
+        {
+          _expression_(result_);
+          _skip_();
+          DT_THROW_IF(_pos_ != _query_.size(), std::logic_error,
+                      "Unexpected '" << _query_.substr(_pos_) << "' in query '" << _query_ << "' !");
+        }
+
+      private:
+
+        void _skip_()
+        {
+          while (_pos_ < _query_.size() && std::isspace(_query_[_pos_])) _pos_++;
+        }
+
+        bool _accept_(char c_)
+        {
+          _skip_();
+          if (_pos_ < _query_.size() && _query_[_pos_] == c_) {
+            _pos_++;
+            return true;
+          }
+          return false;
+        }
+
+        void _expect_(char c_)
+        {
+          DT_THROW_IF(! _accept_(c_), std::logic_error,
+                      "Missing '" << c_ << "' in query '" << _query_ << "' !");
+        }
+
+        std::string _name_()
+        {
+          _skip_();
+          const size_t start = _pos_;
+          while (_pos_ < _query_.size() && ! std::isspace(_query_[_pos_])
+                 && std::string("&|!()").find(_query_[_pos_]) == std::string::npos) _pos_++;
+          DT_THROW_IF(_pos_ == start, std::logic_error,
+                      "Missing cut name in query '" << _query_ << "' !");
+          return _query_.substr(start, _pos_ - start);
+        }
+
+        void _expression_(selection_bitmap & result_)
+        {
+          _term_(result_);
+          while (_accept_('|')) {
+            selection_bitmap other;
+            _term_(other);
+            result_.unite_with(other);
+          }
+        }
+
+        void _term_(selection_bitmap & result_)
+        {
+          _factor_(result_);
+          while (_accept_('&')) {
+            selection_bitmap other;
+            _factor_(other);
+            result_.intersect_with(other);
+          }
+        }
+
+        void _factor_(selection_bitmap & result_)
+        {
+          if (_accept_('!')) {
+            selection_bitmap other;
+            _factor_(other);
+            result_ = selection_bitmap::make_range(_set_.get_number_of_records());
+            result_.subtract(other);
+            return;
+          }
+          if (_accept_('(')) {
+            _expression_(result_);
+            _expect_(')');
+            return;
+          }
+          const std::string a_name = _name_();
+          if (! _accept_('(')) {
+            if (a_name == "all") result_ = selection_bitmap::make_range(_set_.get_number_of_records());
+            else result_ = _set_.get_accepted(a_name);
+            return;
+          }
+          const std::string a_cut = _name_();
+          _expect_(')');
+          if (a_name == "accepted") {
+            result_ = _set_.get_accepted(a_cut);
+          } else if (a_name == "rejected") {
+            result_ = _set_.get_rejected(a_cut);
+          } else if (a_name == "inapplicable") {
+            result_ = selection_bitmap::make_range(_set_.get_number_of_records());
+            result_.subtract(_set_.get_accepted(a_cut));
+            result_.subtract(_set_.get_rejected(a_cut));
+          } else {
+            DT_THROW(std::logic_error, "Unknown selection '" << a_name << "' in query '" << _query_ << "' !");
+          }
+        }
+
+      private:
+
+        const selection_bitmap_set & _set_;
+        const std::string & _query_;
+        size_t _pos_;
+      };
+
+    }
+
+    void selection_bitmap_set::evaluate(const std::string & query_, selection_bitmap & result_) const
+    {
+      query_parser parser(*this, query_);
+      parser.parse(result_);
+    }
+
+    void selection_bitmap_set::store(const std::string & filename_) const
+    {
+      std::ofstream out(filename_.c_str(), std::ios::binary);
+      DT_THROW_IF(! out, std::runtime_error, "Cannot create selection file '" << filename_ << "' !");
+      out.write(selection_magic, sizeof(selection_magic));
+      write_value(out, _number_of_records_);
+      write_value(out, uint32_t(_names_.size()));
+      for (size_t i = 0; i < _names_.size(); i++) {
+        write_value(out, uint32_t(_names_[i].size()));
+        out.write(_names_[i].data(), _names_[i].size());
+        _accepted_[i].write(out);
+        _rejected_[i].write(out);
+      }
+      DT_THROW_IF(! out, std::runtime_error, "Cannot write selection file '" << filename_ << "' !");
+    }
+
+    void selection_bitmap_set::load(const std::string & filename_)
+    {
+      std::ifstream in(filename_.c_str(), std::ios::binary);
+      DT_THROW_IF(! in, std::runtime_error, "Cannot open selection file '" << filename_ << "' !");
+      char magic[sizeof(selection_magic)];
+      in.read(magic, sizeof(magic));
+      DT_THROW_IF(! in || ! std::equal(magic, magic + sizeof(magic), selection_magic),
+                  std::runtime_error, "File '" << filename_ << "' is not a selection file !");
+      uint64_t n_records = 0;
+      uint32_t n_names = 0;
+      read_value(in, n_records);
+      read_value(in, n_names);
+      std::vector<std::string> names(n_names);
+      std::vector<selection_bitmap> accepted(n_names), rejected(n_names);
+      for (uint32_t i = 0; i < n_names; i++) {
+        uint32_t length = 0;
+        read_value(in, length);
+        names[i].resize(length);
+        in.read(&names[i][0], length);
+        accepted[i].read(in);
+        rejected[i].read(in);
+      }
+      set_names(names);
+      _number_of_records_ = n_records;
+      _accepted_.swap(accepted);
+      _rejected_.swap(rejected);
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
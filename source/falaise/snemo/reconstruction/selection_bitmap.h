@@ -0,0 +1,183 @@
+/** \file falaise/snemo/reconstruction/selection_bitmap.h
+ *
+ * Description:
+ *
+ *   Compressed bitmaps of record numbers, used to store the decisions of
+ *   channel and measurement cuts next to processed data files. Selections
+ *   are combined with AND/OR/NOT queries without reading the events again.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_SELECTION_BITMAP_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_SELECTION_BITMAP_H 1
+
+// Standard library:
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Compressed bitmap of record numbers
+    ///
+    /// Record numbers are split in chunks of 65536 records. Each chunk is
+    /// stored as a sorted array of 16 bits offsets while sparse, and as a
+    /// plain bitset once it holds more than 4096 records, as done by
+    /// 'roaring' bitmaps. Set operations work chunk by chunk, on whole
+    /// 64 bits words for dense chunks.
+    class selection_bitmap
+    {
+    public:
+
+      /// Maximal number of records of a sparse chunk
+      static const uint32_t MAX_ARRAY_SIZE = 4096;
+
+      /// Number of words of a dense chunk
+      static const uint32_t BITSET_WORDS = 1024;
+
+      /// Constructor
+      selection_bitmap();
+
+      /// Return a bitmap holding the records [0, n_)
+      static selection_bitmap make_range(uint64_t n_);
+
+      /// Check if the bitmap is empty
+      bool empty() const;
+
+      /// Remove all the records
+      void clear();
+
+      /// Add a record
+      void add(uint64_t record_);
+
+      /// Check if a record is present
+      bool contains(uint64_t record_) const;
+
+      /// Return the number of records
+      uint64_t cardinality() const;
+
+      /// Return the records in increasing order
+      void get_records(std::vector<uint64_t> & records_) const;
+
+      /// Keep the records also present in another bitmap
+      void intersect_with(const selection_bitmap & other_);
+
+      /// Add the records of another bitmap
+      void unite_with(const selection_bitmap & other_);
+
+      /// Remove the records present in another bitmap
+      void subtract(const selection_bitmap & other_);
+
+      /// Write the bitmap to a binary stream
+      void write(std::ostream & out_) const;
+
+      /// Read the bitmap from a binary stream
+      void read(std::istream & in_);
+
+    private:
+
+      /// \brief Records of a chunk
+      struct container {
+        uint64_t key;                 //!< Chunk number
+        uint32_t cardinality;         //!< Number of records
+        std::vector<uint16_t> array;  //!< Sorted offsets (sparse chunk)
+        std::vector<uint64_t> bits;   //!< Bitset (dense chunk)
+
+        bool is_bitset() const { return ! bits.empty(); }
+        bool contains(uint16_t offset_) const;
+        void to_bitset();
+        void optimize();
+      };
+
+      /// Return the container of a chunk, if any
+      const container * _find_(uint64_t key_) const;
+
+    private:
+
+      std::vector<container> _containers_; //!< Non empty containers sorted by chunk number
+    };
+
+    /// \brief Selection bitmaps of a list of cuts over a stream of records
+    ///
+    /// Each cut gets a bitmap of the accepted records and one of the
+    /// rejected records. The records the cut does not apply to are those
+    /// found in none of them.
+    class selection_bitmap_set
+    {
+    public:
+
+      /// Constructor
+      selection_bitmap_set();
+
+      /// Remove all the selections
+      void clear();
+
+      /// Set the names of the recorded cuts
+      void set_names(const std::vector<std::string> & names_);
+
+      /// Return the names of the recorded cuts
+      const std::vector<std::string> & get_names() const;
+
+      /// Return the number of records
+      uint64_t get_number_of_records() const;
+
+      /// Set the number of records
+      void set_number_of_records(uint64_t n_);
+
+      /// Record the status of a cut (from its index) for a record
+      void add(uint64_t record_, size_t cut_, int status_);
+
+      /// Return the accepted records of a cut
+      const selection_bitmap & get_accepted(const std::string & name_) const;
+
+      /// Return the rejected records of a cut
+      const selection_bitmap & get_rejected(const std::string & name_) const;
+
+      /// Append the selections of another stream, numbering its records after ours
+      void append(const selection_bitmap_set & other_);
+
+      /// Evaluate a query
+      ///
+      /// Queries combine cut names, standing for the accepted records, with
+      /// the '&', '|' and '!' operators and parentheses. 'rejected(name)'
+      /// and 'inapplicable(name)' stand for the other records of a cut, and
+      /// 'all' for every record, e.g. '2e::channel_cut & rejected(vertex_cut)'.
+      void evaluate(const std::string & query_, selection_bitmap & result_) const;
+
+      /// Write the selections to a file
+      void store(const std::string & filename_) const;
+
+      /// Read the selections from a file
+      void load(const std::string & filename_);
+
+    private:
+
+      /// Return the index of a cut
+      size_t _index_(const std::string & name_) const;
+
+    private:
+
+      uint64_t _number_of_records_;             //!< Number of records
+      std::vector<std::string> _names_;         //!< Names of the cuts
+      std::vector<selection_bitmap> _accepted_; //!< Accepted records, one bitmap per cut
+      std::vector<selection_bitmap> _rejected_; //!< Rejected records, one bitmap per cut
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_SELECTION_BITMAP_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
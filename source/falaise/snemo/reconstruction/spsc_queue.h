@@ -0,0 +1,130 @@
+/** \file falaise/snemo/reconstruction/spsc_queue.h
+ *
+ * Description:
+ *
+ *   A bounded, lock-free queue between a single producer thread and a
+ *   single consumer thread, handing records from one processing stage to
+ *   the next in order.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_SPSC_QUEUE_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_SPSC_QUEUE_H 1
+
+// Standard library:
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Bounded lock-free single producer, single consumer queue
+    ///
+    /// Values are stored in a ring buffer whose size is a power of two. The
+    /// producer only writes the tail index and the consumer only writes the
+    /// head index, each published with release semantics, so that a value
+    /// is fully written before the other side can see it. Blocking calls
+    /// spin a little, then yield: a full queue holds the producer back.
+    template<typename T>
+    class spsc_queue
+    {
+    public:
+
+      /// Constructor with the minimal number of queued values
+      explicit spsc_queue(size_t capacity_)
+        : _head_(0), _tail_(0)
+      {
+        DT_THROW_IF(capacity_ == 0, std::domain_error, "Invalid queue capacity !");
+        size_t a_size = 1;
+        while (a_size < capacity_) a_size <<= 1;
+        _slots_.resize(a_size);
+        _mask_ = a_size - 1;
+      }
+
+      /// Return the maximal number of queued values
+      size_t capacity() const
+      {
+        return _slots_.size();
+      }
+
+      /// Add a value unless the queue is full (producer side)
+      bool try_push(T && value_)
+      {
+        const size_t a_tail = _tail_.load(std::memory_order_relaxed);
+        if (a_tail - _head_.load(std::memory_order_acquire) == _slots_.size()) return false;
+        _slots_[a_tail & _mask_] = std::move(value_);
+        _tail_.store(a_tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      /// Remove the oldest value unless the queue is empty (consumer side)
+      bool try_pop(T & value_)
+      {
+        const size_t a_head = _head_.load(std::memory_order_relaxed);
+        if (a_head == _tail_.load(std::memory_order_acquire)) return false;
+        value_ = std::move(_slots_[a_head & _mask_]);
+        _head_.store(a_head + 1, std::memory_order_release);
+        return true;
+      }
+
+      /// Add a value, waiting while the queue is full (producer side)
+      ///
+      /// Return true if the producer had to wait.
+      bool push(T value_)
+      {
+        size_t nwaits = 0;
+        while (! try_push(std::move(value_))) {
+          _wait_(nwaits++);
+        }
+        return nwaits > 0;
+      }
+
+      /// Remove the oldest value, waiting while the queue is empty (consumer side)
+      ///
+      /// Return true if the consumer had to wait.
+      bool pop(T & value_)
+      {
+        size_t nwaits = 0;
+        while (! try_pop(value_)) {
+          _wait_(nwaits++);
+        }
+        return nwaits > 0;
+      }
+
+    private:
+
+      /// Back off while the other side catches up
+      static void _wait_(size_t attempt_)
+      {
+        if (attempt_ >= 64) std::this_thread::yield();
+      }
+
+    private:
+
+      std::vector<T> _slots_;                 //!< Ring buffer
+      size_t _mask_;                          //!< Mask of the slot indexes
+      alignas(64) std::atomic<size_t> _head_; //!< Number of popped values, written by the consumer
+      alignas(64) std::atomic<size_t> _tail_; //!< Number of pushed values, written by the producer
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_SPSC_QUEUE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
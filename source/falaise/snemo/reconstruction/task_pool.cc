@@ -0,0 +1,135 @@
+/// \file falaise/snemo/reconstruction/task_pool.cc
+
+// Ourselves:
+#include <snemo/reconstruction/task_pool.h>
+
+// Standard library:
+#include <algorithm>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+      /// Flag of the threads running in a parallel section
+      thread_local bool parallel_thread = false;
+    }
+
+    task_pool::parallel_section::parallel_section()
+    {
+      _previous_ = parallel_thread;
+      parallel_thread = true;
+    }
+
+    task_pool::parallel_section::~parallel_section()
+    {
+      parallel_thread = _previous_;
+    }
+
+    // static
+    bool task_pool::in_parallel_section()
+    {
+      return parallel_thread;
+    }
+
+    task_pool::task_pool(size_t nthreads_)
+      : _next_(0)
+    {
+      _task_ = nullptr;
+      _ntasks_ = 0;
+      _active_ = 0;
+      _generation_ = 0;
+      _stop_ = false;
+      size_t nthreads = nthreads_;
+      if (nthreads == 0) nthreads = std::max(1u, std::thread::hardware_concurrency());
+      for (size_t i = 1; i < nthreads; i++) {
+        _threads_.push_back(std::thread(&task_pool::_loop_, this));
+      }
+    }
+
+    task_pool::~task_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _stop_ = true;
+      }
+      _wake_.notify_all();
+      for (auto& a_thread : _threads_) {
+        a_thread.join();
+      }
+    }
+
+    size_t task_pool::get_number_of_threads() const
+    {
+      return _threads_.size() + 1;
+    }
+
+    void task_pool::_work_()
+    {
+      for (size_t i = _next_++; i < _ntasks_; i = _next_++) {
+        try {
+          (*_task_)(i);
+        } catch (...) {
+          _errors_[i] = std::current_exception();
+        }
+      }
+    }
+
+    void task_pool::_loop_()
+    {
+      parallel_section a_section;
+      uint64_t a_generation = 0;
+      for (;;) {
+        {
+          std::unique_lock<std::mutex> lock(_mutex_);
+          _wake_.wait(lock, [&] { return _stop_ || _generation_ != a_generation; });
+          if (_stop_) return;
+          a_generation = _generation_;
+        }
+        _work_();
+        {
+          std::lock_guard<std::mutex> lock(_mutex_);
+          _active_--;
+        }
+        _done_.notify_one();
+      }
+    }
+
+    void task_pool::run(size_t ntasks_, const std::function<void(size_t)> & task_)
+    {
+      std::unique_lock<std::mutex> run_lock(_run_mutex_, std::defer_lock);
+      if (_threads_.empty() || ntasks_ < 2 || in_parallel_section() || ! run_lock.try_lock()) {
+        // Serial batch, failures stop it as a plain loop would
+        for (size_t i = 0; i < ntasks_; i++) task_(i);
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex_);
+        _task_ = &task_;
+        _ntasks_ = ntasks_;
+        _next_ = 0;
+        _errors_.assign(ntasks_, std::exception_ptr());
+        _active_ = _threads_.size();
+        _generation_++;
+      }
+      _wake_.notify_all();
+      {
+        parallel_section a_section;
+        _work_();
+      }
+      {
+        std::unique_lock<std::mutex> lock(_mutex_);
+        _done_.wait(lock, [&] { return _active_ == 0; });
+        _task_ = nullptr;
+      }
+
+      // Report the first failure, as the serial batch would have
+      for (size_t i = 0; i < ntasks_; i++) {
+        if (_errors_[i]) std::rethrow_exception(_errors_[i]);
+      }
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
@@ -0,0 +1,103 @@
+/** \file falaise/snemo/reconstruction/task_pool.h
+ *
+ * Description:
+ *
+ *   A persistent pool of threads running batches of independent tasks,
+ *   such as the per-gamma measurements of an event, without creating
+ *   threads for every event.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TASK_POOL_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TASK_POOL_H 1
+
+// Standard library:
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Persistent pool of threads running batches of independent tasks
+    ///
+    /// The calling thread takes part in the batch. A batch runs serially on
+    /// the calling thread when it is issued from a parallel section, e.g. a
+    /// worker of the topology scheduler, or while another batch holds the
+    /// pool, so that nested parallelism never oversubscribes the CPU.
+    class task_pool
+    {
+    public:
+
+      /// \brief Guard marking the calling thread as running in a parallel section
+      class parallel_section
+      {
+      public:
+        parallel_section();
+        ~parallel_section();
+      private:
+        bool _previous_; //!< State of the thread before the guard
+      };
+
+      /// Check if the calling thread runs in a parallel section
+      static bool in_parallel_section();
+
+      /// Constructor with the number of threads, the calling one included (0 for the hardware concurrency)
+      explicit task_pool(size_t nthreads_);
+
+      /// Destructor
+      ~task_pool();
+
+      /// Return the number of threads running a batch, the calling one included
+      size_t get_number_of_threads() const;
+
+      /// Run the tasks [0, ntasks_) and return once all of them are done
+      ///
+      /// The first failure, in the task order, is rethrown.
+      void run(size_t ntasks_, const std::function<void(size_t)> & task_);
+
+    private:
+
+      /// Run the tasks of the current batch
+      void _work_();
+
+      /// Loop of the pool threads
+      void _loop_();
+
+    private:
+
+      std::vector<std::thread> _threads_;             //!< Pool threads
+      std::mutex _run_mutex_;                         //!< Guard of the pool by a batch
+      std::mutex _mutex_;                             //!< Guard of the batch state
+      std::condition_variable _wake_;                 //!< Signal of a new batch
+      std::condition_variable _done_;                 //!< Signal of the end of a batch
+      const std::function<void(size_t)> * _task_;     //!< Task of the current batch
+      size_t _ntasks_;                                //!< Number of tasks of the current batch
+      std::atomic<size_t> _next_;                     //!< Next task of the current batch
+      std::vector<std::exception_ptr> _errors_;       //!< Failures of the current batch
+      size_t _active_;                                //!< Number of pool threads busy with the current batch
+      uint64_t _generation_;                          //!< Number of issued batches
+      bool _stop_;                                    //!< Flag to stop the pool threads
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TASK_POOL_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -6,6 +6,7 @@
 // Standard library:
 #include <stdexcept>
 #include <sstream>
+#include <unordered_map>
 
 // Third party:
 //- GSL:
@@ -20,6 +21,8 @@
 
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/reconstruction/energy_driver.h>
+#include <falaise/snemo/reconstruction/vertex_summary.h>
 
 namespace snemo {
 
@@ -28,9 +31,6 @@ namespace snemo {
     /// Toolbox for TOF calculation
     struct tof_driver::tof_tool {
 
-      /// Gives the energy of particle
-      static double get_energy(const snemo::datamodel::particle_track & particle_);
-
       /// Gives the mass of the particle
       static double get_mass(const snemo::datamodel::particle_track & particle_);
 
@@ -40,36 +40,43 @@ namespace snemo {
       /// Gives the theoretical time of the track
       static double get_theoretical_time(double energy_, double mass_, double track_length_);
 
-      /// Gives the times for two charged particles (single deposit)
-      static void get_time(const snemo::datamodel::particle_track & particle_,
-                           double & t_, double & sigma_t);
-
       /// Gives the track length of an electron
       static double get_charged_particle_track_length(const snemo::datamodel::particle_track & particle_);
 
       /// Gives the track length of a gamma from the electron vertex
       static double get_gamma_track_length(const snemo::datamodel::particle_track & gamma_,
                                            const snemo::datamodel::particle_track & electron_,
+                                           const vertex_summary & vertices_,
+                                           size_t gamma_index_, size_t electron_index_,
                                            const bool external_hyp_ = false);
 
-      static datatools::logger::priority logging; //!< Internal logging priority
+      /// Gives the first vertex of a particle lying on the source foil
+      static void get_foil_vertex(const snemo::datamodel::particle_track & particle_,
+                                  const vertex_summary & vertices_, size_t index_,
+                                  geomtools::vector_3d & vertex_);
+
+      /// Hash functor for geometry identifiers
+      struct geom_id_hash {
+        std::size_t operator()(const geomtools::geom_id & gid_) const;
+      };
+
+      /// Lookup table from geometry identifier to calorimeter hit
+      typedef std::unordered_map<geomtools::geom_id,
+                                 const snemo::datamodel::calibrated_calorimeter_hit *,
+                                 geom_id_hash> calorimeter_index_type;
+
+      /// Index the calorimeter hits associated to a particle by geometry identifier
+      static void build_calorimeter_index(const snemo::datamodel::particle_track & particle_,
+                                          calorimeter_index_type & index_);
+
+      /// Gives gamma information (track length, time) for one calorimeter
+      /// vertex given the foil vertex of the charged particle
+      static void get_vertex_to_calo_info(const geomtools::vector_3d & foil_vertex_,
+                                          const calorimeter_index_type & gamma_calorimeters_,
+                                          const geomtools::blur_spot & vertex_,
+                                          double & track_length_, double & time_, double & sigma_time_);
     };
 
-    datatools::logger::priority tof_driver::tof_tool::logging = datatools::logger::PRIO_WARNING;
-
-    double tof_driver::tof_tool::get_energy(const snemo::datamodel::particle_track & particle_)
-    {
-      double energy = datatools::invalid_real();
-      if (particle_.has_associated_calorimeter_hits()) {
-        auto the_calorimeters = particle_.get_associated_calorimeter_hits();
-        // Get first associated calorimeter (charged particle can be associated to
-        // several calorimeter hits given the spatial resolution of the track fit:
-        // only take care of teh first one)
-        energy = the_calorimeters.front().get().get_energy();
-      }
-      return energy;
-    }
-
     double tof_driver::tof_tool::get_theoretical_time(double energy_, double mass_, double track_length_)
     {
       return track_length_ / (tof_tool::beta(energy_, mass_) * CLHEP::c_light);
@@ -80,19 +87,6 @@ namespace snemo {
       return std::sqrt(energy_ * (energy_ + 2.*mass_)) / (energy_ + mass_);
     }
 
-    void tof_driver::tof_tool::get_time(const snemo::datamodel::particle_track & particle_,
-                                        double & t_, double & sigma_t_)
-    {
-      datatools::invalidate(t_);
-      datatools::invalidate(sigma_t_);
-      if (particle_.has_associated_calorimeter_hits()) {
-        auto the_calorimeters = particle_.get_associated_calorimeter_hits();
-        auto a_calo_hit = the_calorimeters.front().get();
-        t_ = a_calo_hit.get_time();
-        sigma_t_ = a_calo_hit.get_sigma_time();
-      }
-    }
-
     double tof_driver::tof_tool::get_mass(const snemo::datamodel::particle_track & particle_)
     {
       double mass = datatools::invalid_real();
@@ -114,8 +108,8 @@ namespace snemo {
     {
       double length = datatools::invalid_real();
       if (particle_.has_trajectory()) {
-        auto a_trajectory = particle_.get_trajectory();
-        auto& a_track_pattern = a_trajectory.get_pattern();
+        const auto& a_trajectory = particle_.get_trajectory();
+        const auto& a_track_pattern = a_trajectory.get_pattern();
         length = a_track_pattern.get_shape().get_length();
       }
       return length;
@@ -123,25 +117,13 @@ namespace snemo {
 
     double tof_driver::tof_tool::get_gamma_track_length(const snemo::datamodel::particle_track & ptg_,
                                                         const snemo::datamodel::particle_track & pte_,
+                                                        const vertex_summary & vertices_,
+                                                        size_t gamma_index_, size_t electron_index_,
                                                         const bool external_hyp_)
     {
       double length = datatools::invalid_real();
-      if (! pte_.has_vertices()) {
-        //DT_LOG_WARNING(logging, "Electron has no vertices associated !");
-        return length;
-      }
-
-      auto the_vertices = pte_.get_vertices();
       geomtools::vector_3d electron_foil_vertex;
-      geomtools::invalidate(electron_foil_vertex);
-      for (auto& ivtx : the_vertices) {
-        auto a_vertex = ivtx.get();
-        if (! snemo::datamodel::particle_track::vertex_is_on_source_foil(a_vertex))
-          continue;
-
-        electron_foil_vertex = a_vertex.get_position();
-        break;
-      }
+      tof_tool::get_foil_vertex(pte_, vertices_, electron_index_, electron_foil_vertex);
       if (! geomtools::is_valid(electron_foil_vertex)) {
         //DT_LOG_WARNING(logging, "Electron has no vertices on the calorimeter !");
         return length;
@@ -151,15 +133,12 @@ namespace snemo {
         //DT_LOG_WARNING(logging, "Gamma has no vertices associated !");
         return length;
       }
-      auto the_gamma_vertices = ptg_.get_vertices();
+      const auto& the_gamma_vertices = ptg_.get_vertices();
       geomtools::vector_3d gamma_first_calo_vertex;
       geomtools::invalidate(gamma_first_calo_vertex);
-      for (auto ivtx : the_gamma_vertices) {
-        auto a_vertex = ivtx.get();
-        if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(a_vertex) ||
-            snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(a_vertex) ||
-            snemo::datamodel::particle_track::vertex_is_on_gamma_veto(a_vertex)) {
-          gamma_first_calo_vertex = a_vertex.get_position();
+      for (size_t rank = 0; rank < vertices_.get_number_of_vertices(gamma_index_); rank++) {
+        if (vertices_.get_category(gamma_index_, rank) & vertex_summary::CALORIMETER) {
+          gamma_first_calo_vertex = the_gamma_vertices[rank].get().get_position();
           if (! external_hyp_) break;
         }
       }
@@ -172,6 +151,69 @@ namespace snemo {
       return length;
     }
 
+    void tof_driver::tof_tool::get_foil_vertex(const snemo::datamodel::particle_track & particle_,
+                                               const vertex_summary & vertices_, size_t index_,
+                                               geomtools::vector_3d & vertex_)
+    {
+      geomtools::invalidate(vertex_);
+      const int rank = vertices_.find_first(index_, vertex_summary::SOURCE_FOIL);
+      if (rank < 0) {
+        //DT_LOG_WARNING(logging, "Particle has no vertices on the source foil !");
+        return;
+      }
+      vertex_ = particle_.get_vertices()[rank].get().get_position();
+    }
+
+    std::size_t tof_driver::tof_tool::geom_id_hash::operator()(const geomtools::geom_id & gid_) const
+    {
+      std::size_t h = gid_.get_type();
+      for (size_t i = 0; i < gid_.get_depth(); i++) {
+        h = h * 31 + gid_.get(i);
+      }
+      return h;
+    }
+
+    void tof_driver::tof_tool::build_calorimeter_index(const snemo::datamodel::particle_track & particle_,
+                                                       calorimeter_index_type & index_)
+    {
+      index_.clear();
+      if (! particle_.has_associated_calorimeter_hits()) return;
+      const auto& the_calorimeters = particle_.get_associated_calorimeter_hits();
+      index_.reserve(the_calorimeters.size());
+      for (const auto& icalo : the_calorimeters) {
+        const snemo::datamodel::calibrated_calorimeter_hit & a_calo_hit = icalo.get();
+        // Keep the first hit for a given geom_id as the former linear search did
+        index_.emplace(a_calo_hit.get_geom_id(), &a_calo_hit);
+      }
+    }
+
+    void tof_driver::tof_tool::get_vertex_to_calo_info(const geomtools::vector_3d & foil_vertex_,
+                                                       const calorimeter_index_type & gamma_calorimeters_,
+                                                       const geomtools::blur_spot & vertex_,
+                                                       double & track_length_, double & time_, double & sigma_time_)
+    {
+      datatools::invalidate(track_length_);
+      datatools::invalidate(time_);
+      datatools::invalidate(sigma_time_);
+
+      if (! geomtools::is_valid(foil_vertex_)) {
+        //DT_LOG_WARNING(logging, "Electron has no vertices on the source foil !");
+        return;
+      }
+
+      auto found = gamma_calorimeters_.find(vertex_.get_geom_id());
+      if (found == gamma_calorimeters_.end()) {
+        //DT_LOG_WARNING(logging, "Calibrated calorimeter hit with id " << vertex_.get_geom_id()
+        //               << " can not be found ! Might be a gamma from annihilation.");
+        return;
+      }
+      const snemo::datamodel::calibrated_calorimeter_hit & a_calo_hit = *found->second;
+
+      track_length_ = (foil_vertex_ - vertex_.get_position()).mag();
+      time_ = a_calo_hit.get_time();
+      sigma_time_ = a_calo_hit.get_sigma_time();
+    }
+
     const std::string & tof_driver::get_id()
     {
       static const std::string _id("TOFD");
@@ -229,9 +271,6 @@ namespace snemo {
                   "Invalid logging priority level !");
       set_logging_priority(lp);
 
-      // Set logging priority for tof_tool
-      tof_tool::logging = lp;
-
       _set_initialized(true);
     }
 
@@ -245,16 +284,40 @@ namespace snemo {
 
     void tof_driver::process(const snemo::datamodel::particle_track & pt1_,
                              const snemo::datamodel::particle_track & pt2_,
-                             snemo::datamodel::tof_measurement & tof_)
+                             snemo::datamodel::tof_measurement & tof_) const
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error,
+                  "Driver '" << get_id() << "' is not initialized !");
+      calorimeter_summary calorimeters;
+      calorimeters.fill({&pt1_, &pt2_});
+      vertex_summary vertices;
+      vertices.fill({&pt1_, &pt2_});
+      this->_process_algo(pt1_, pt2_, calorimeters, vertices, 0, 1,
+                          tof_.get_internal_probabilities(), tof_.get_external_probabilities());
+    }
+
+    void tof_driver::process(const snemo::datamodel::particle_track & pt1_,
+                             const snemo::datamodel::particle_track & pt2_,
+                             const calorimeter_summary & calorimeters_,
+                             const vertex_summary & vertices_,
+                             size_t index1_, size_t index2_,
+                             snemo::datamodel::tof_measurement & tof_) const
     {
       DT_THROW_IF(! is_initialized(), std::logic_error,
                   "Driver '" << get_id() << "' is not initialized !");
-      this->_process_algo(pt1_, pt2_, tof_.get_internal_probabilities(), tof_.get_external_probabilities());
+      DT_THROW_IF(index1_ >= calorimeters_.size() || index2_ >= calorimeters_.size() ||
+                  index1_ >= vertices_.size() || index2_ >= vertices_.size(), std::range_error,
+                  "Invalid particle indexes '" << index1_ << "' and '" << index2_ << "' !");
+      this->_process_algo(pt1_, pt2_, calorimeters_, vertices_, index1_, index2_,
+                          tof_.get_internal_probabilities(), tof_.get_external_probabilities());
     }
 
     void tof_driver::_process_algo(const snemo::datamodel::particle_track & pt1_,
                                    const snemo::datamodel::particle_track & pt2_,
-                                   std::vector<double> & proba_int_, std::vector<double> & proba_ext_)
+                                   const calorimeter_summary & calorimeters_,
+                                   const vertex_summary & vertices_,
+                                   size_t index1_, size_t index2_,
+                                   std::vector<double> & proba_int_, std::vector<double> & proba_ext_) const
     {
       if (! pt1_.has_associated_calorimeter_hits() ||
           ! pt2_.has_associated_calorimeter_hits()) {
@@ -271,10 +334,10 @@ namespace snemo {
       // Either specialize the methods or consider the case here
       if (! snemo::datamodel::pid_utils::particle_is_gamma(pt1_) &&
           ! snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
-        _process_charged_particles(pt1_, pt2_, proba_int_, proba_ext_);
+        _process_charged_particles(pt1_, pt2_, calorimeters_, index1_, index2_, proba_int_, proba_ext_);
       } else if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ||
                  snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
-        _process_charged_gamma_particles(pt1_, pt2_, proba_int_, proba_ext_);
+        _process_charged_gamma_particles(pt1_, pt2_, calorimeters_, vertices_, index1_, index2_, proba_int_, proba_ext_);
       } else {
         //DT_LOG_WARNING(get_logging_priority(), "Topology not supported !");
         return;
@@ -283,12 +346,14 @@ namespace snemo {
 
     void tof_driver::_process_charged_particles(const snemo::datamodel::particle_track & pt1_,
                                                 const snemo::datamodel::particle_track & pt2_,
+                                                const calorimeter_summary & calorimeters_,
+                                                size_t index1_, size_t index2_,
                                                 std::vector<double> & proba_int_,
-                                                std::vector<double> & proba_ext_)
+                                                std::vector<double> & proba_ext_) const
     {
       // Compute theoretical times given energy, mass and track length
-      const double E1 = tof_tool::get_energy(pt1_);
-      const double E2 = tof_tool::get_energy(pt2_);
+      const double E1 = calorimeters_.first_energies[index1_];
+      const double E2 = calorimeters_.first_energies[index2_];
       const double tl1 = tof_tool::get_charged_particle_track_length(pt1_);
       const double tl2 = tof_tool::get_charged_particle_track_length(pt2_);
       const double m1 = tof_tool::get_mass(pt1_);
@@ -296,10 +361,10 @@ namespace snemo {
       const double t1_th = tof_tool::get_theoretical_time(E1, m1, tl1);
       const double t2_th = tof_tool::get_theoretical_time(E2, m2, tl2);
 
-      double t1, t2;
-      double sigma_t1, sigma_t2;
-      tof_tool::get_time(pt1_, t1, sigma_t1);
-      tof_tool::get_time(pt2_, t2, sigma_t2);
+      const double t1 = calorimeters_.first_times[index1_];
+      const double t2 = calorimeters_.first_times[index2_];
+      const double sigma_t1 = calorimeters_.first_sigma_times[index1_];
+      const double sigma_t2 = calorimeters_.first_sigma_times[index2_];
 
       const double sigma_l = 0.1 * CLHEP::ns; //kind of arbitrary value to keep the internal probability distribution flat,
                                               // until the uncertainty on the track length is obtained from the reconstruction algorithm.
@@ -315,33 +380,43 @@ namespace snemo {
 
     void tof_driver::_process_charged_gamma_particles(const snemo::datamodel::particle_track & pt1_,
                                                       const snemo::datamodel::particle_track & pt2_,
+                                                      const calorimeter_summary & calorimeters_,
+                                                      const vertex_summary & vertices_,
+                                                      size_t index1_, size_t index2_,
                                                       std::vector<double> & proba_int_,
-                                                      std::vector<double> & proba_ext_)
+                                                      std::vector<double> & proba_ext_) const
     {
-      auto a_gamma = (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ? pt1_ : pt2_);
-      auto a_charged = (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ? pt2_ : pt1_);
+      const bool first_is_gamma = snemo::datamodel::pid_utils::particle_is_gamma(pt1_);
+      const snemo::datamodel::particle_track & a_gamma = (first_is_gamma ? pt1_ : pt2_);
+      const snemo::datamodel::particle_track & a_charged = (first_is_gamma ? pt2_ : pt1_);
+      const size_t charged_index = (first_is_gamma ? index2_ : index1_);
+      const size_t gamma_index = (first_is_gamma ? index1_ : index2_);
 
       // Compute theoretical times given energy, mass and track length
-      const double E1 = tof_tool::get_energy(a_charged);
+      const double E1 = calorimeters_.first_energies[charged_index];
       const double E2 = 1; // dummy, non-zero value
       const double m1 = tof_tool::get_mass(a_charged);
       const double m2 = tof_tool::get_mass(a_gamma);
 
       const double tl1 = tof_tool::get_charged_particle_track_length(a_charged);
       const double t1_th = tof_tool::get_theoretical_time(E1, m1, tl1);
-      double t1, sigma_t1;
-      tof_tool::get_time(a_charged, t1, sigma_t1);
-
-      snemo::datamodel::particle_track::vertex_collection_type the_gamma_calos_vertices;
-      a_gamma.fetch_vertices(the_gamma_calos_vertices,
-                             snemo::datamodel::particle_track::VERTEX_ON_MAIN_CALORIMETER |
-                             snemo::datamodel::particle_track::VERTEX_ON_X_CALORIMETER    |
-                             snemo::datamodel::particle_track::VERTEX_ON_GAMMA_VETO);
-
-      for (auto ivtx : the_gamma_calos_vertices) {
+      const double t1 = calorimeters_.first_times[charged_index];
+      const double sigma_t1 = calorimeters_.first_sigma_times[charged_index];
+
+      // Charged particle foil vertex and gamma calorimeter hits are looked up
+      // once for all the gamma calorimeter vertices
+      geomtools::vector_3d charged_foil_vertex;
+      tof_tool::get_foil_vertex(a_charged, vertices_, charged_index, charged_foil_vertex);
+      tof_tool::calorimeter_index_type gamma_calorimeters;
+      tof_tool::build_calorimeter_index(a_gamma, gamma_calorimeters);
+
+      // Gamma vertices on any calorimeter, in the order of the vertex collection
+      for (size_t rank = 0; rank < vertices_.get_number_of_vertices(gamma_index); rank++) {
+        if (! (vertices_.get_category(gamma_index, rank) & vertex_summary::CALORIMETER)) continue;
         double tl2, t2, sigma_t2;
-        this->_get_vertex_to_calo_info_(a_charged, a_gamma, ivtx.get(),
-                                        tl2, t2, sigma_t2);
+        tof_tool::get_vertex_to_calo_info(charged_foil_vertex, gamma_calorimeters,
+                                          a_gamma.get_vertices()[rank].get(),
+                                          tl2, t2, sigma_t2);
 
         const double t2_th = tof_tool::get_theoretical_time(E2, m2, tl2);
         const double sigma_l = 0.6 * CLHEP::ns;
@@ -355,54 +430,6 @@ namespace snemo {
       }
     }
 
-    void tof_driver::_get_vertex_to_calo_info_(const snemo::datamodel::particle_track & ptc_,
-                                               const snemo::datamodel::particle_track & ptg_,
-                                               const geomtools::blur_spot & vertex_,
-                                               double & track_length_, double & time_, double & sigma_time_)
-    {
-      datatools::invalidate(track_length_);
-      datatools::invalidate(time_);
-      datatools::invalidate(sigma_time_);
-
-      if (! ptc_.has_vertices()) {
-        //DT_LOG_WARNING(get_logging_priority(), "Electron has no vertices associated !");
-        return;
-      }
-      auto the_vertices = ptc_.get_vertices();
-      geomtools::vector_3d electron_foil_vertex;
-      geomtools::invalidate(electron_foil_vertex);
-      for (auto ivtx : the_vertices) {
-        auto a_vertex = ivtx.get();
-        if (! snemo::datamodel::particle_track::vertex_is_on_source_foil(a_vertex))
-          continue;
-
-        electron_foil_vertex = a_vertex.get_position();
-        break;
-      }
-      if (! geomtools::is_valid(electron_foil_vertex)) {
-        //DT_LOG_WARNING(get_logging_priority(), "Electron has no vertices on the calorimeter !");
-        return;
-      }
-
-      auto the_gamma_calorimeters = ptg_.get_associated_calorimeter_hits();
-      geomtools::base_hit::has_geom_id_predicate hit_pred(vertex_.get_geom_id());
-      datatools::mother_to_daughter_predicate<geomtools::base_hit,
-                                              snemo::datamodel::calibrated_calorimeter_hit> pred_M2D(hit_pred);
-      datatools::handle_predicate<snemo::datamodel::calibrated_calorimeter_hit> pred_via_handle(pred_M2D);
-      snemo::datamodel::calibrated_calorimeter_hit::collection_type::const_iterator
-        found = std::find_if(the_gamma_calorimeters.begin(),the_gamma_calorimeters.end(), pred_via_handle);
-      if (found == the_gamma_calorimeters.end()) {
-        //DT_LOG_WARNING(get_logging_priority(), "Calibrated calorimeter hit with id " << vertex_.get_geom_id()
-                       //<< " can not be found ! Might be a gamma from annihilation.");
-        return;
-      }
-      auto a_calo_hit = found->get();
-
-      track_length_ = (electron_foil_vertex - vertex_.get_position()).mag();
-      time_ = a_calo_hit.get_time();
-      sigma_time_ = a_calo_hit.get_sigma_time();
-    }
-
     // static
     void tof_driver::init_ocd(datatools::object_configuration_description & ocd_)
     {
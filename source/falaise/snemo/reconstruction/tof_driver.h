@@ -41,11 +41,6 @@
 // - Bayeux/datatools:
 #include <bayeux/datatools/logger.h>
 
-// Forward declaration
-namespace geomtools {
-  class blur_spot;
-}
-
 namespace snemo {
 
   namespace datamodel {
@@ -55,6 +50,9 @@ namespace snemo {
 
   namespace reconstruction {
 
+    struct calorimeter_summary;
+    struct vertex_summary;
+
     /// Driver for the gamma clustering algorithms
     class tof_driver
     {
@@ -85,7 +83,15 @@ namespace snemo {
       /// Main process
       void process(const snemo::datamodel::particle_track & pt1_,
                    const snemo::datamodel::particle_track & pt2_,
-                   snemo::datamodel::tof_measurement & tof_);
+                   snemo::datamodel::tof_measurement & tof_) const;
+
+      /// Process two particles given the event calorimeter and vertex summaries
+      void process(const snemo::datamodel::particle_track & pt1_,
+                   const snemo::datamodel::particle_track & pt2_,
+                   const calorimeter_summary & calorimeters_,
+                   const vertex_summary & vertices_,
+                   size_t index1_, size_t index2_,
+                   snemo::datamodel::tof_measurement & tof_) const;
 
       /// Reset the driver
       void reset();
@@ -104,26 +110,25 @@ namespace snemo {
       /// Main method to process particles and to retrieve internal/external TOF probabilities
       void _process_algo(const snemo::datamodel::particle_track & pt1_,
                          const snemo::datamodel::particle_track & pt2_,
-                         std::vector<double> & proba_int_, std::vector<double> & proba_ext_);
+                         const calorimeter_summary & calorimeters_,
+                         const vertex_summary & vertices_,
+                         size_t index1_, size_t index2_,
+                         std::vector<double> & proba_int_, std::vector<double> & proba_ext_) const;
 
       /// Special method to process charged particles
       void _process_charged_particles(const snemo::datamodel::particle_track & pt1_,
                                       const snemo::datamodel::particle_track & pt2_,
-                                      std::vector<double> & proba_int_, std::vector<double> & proba_ext_);
+                                      const calorimeter_summary & calorimeters_,
+                                      size_t index1_, size_t index2_,
+                                      std::vector<double> & proba_int_, std::vector<double> & proba_ext_) const;
 
       /// Special method to process gamma particles
       void _process_charged_gamma_particles(const snemo::datamodel::particle_track & pt1_,
                                             const snemo::datamodel::particle_track & pt2_,
-                                            std::vector<double> & proba_int_, std::vector<double> & proba_ext_);
-    private:
-
-      /// Special internal method to extract gamma information (track length,
-      /// time) given a charged particle track
-      void _get_vertex_to_calo_info_(const snemo::datamodel::particle_track & ptc_,
-                                     const snemo::datamodel::particle_track & ptg_,
-                                     const geomtools::blur_spot & vertex_,
-                                     double & track_length_, double & time_, double & sigma_time_);
-
+                                            const calorimeter_summary & calorimeters_,
+                                            const vertex_summary & vertices_,
+                                            size_t index1_, size_t index2_,
+                                            std::vector<double> & proba_int_, std::vector<double> & proba_ext_) const;
     private:
       struct tof_tool;
       bool _initialized_;                             //!< Initialization status
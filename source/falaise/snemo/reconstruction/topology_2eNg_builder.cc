@@ -3,13 +3,7 @@
 
 // Ourselves:
 #include <falaise/snemo/reconstruction/topology_2eNg_builder.h>
-#include <falaise/snemo/reconstruction/tof_driver.h>
-#include <falaise/snemo/reconstruction/angle_driver.h>
-#include <falaise/snemo/reconstruction/energy_driver.h>
 #include <falaise/snemo/datamodels/topology_2eNg_pattern.h>
-#include <falaise/snemo/datamodels/tof_measurement.h>
-#include <falaise/snemo/datamodels/angle_measurement.h>
-#include <falaise/snemo/datamodels/energy_measurement.h>
 
 namespace snemo {
 
@@ -32,53 +26,27 @@ namespace snemo {
       const std::string e1_label = "e1";
       DT_THROW_IF(! pattern_.has_particle_track(e1_label), std::logic_error,
                   "No particle with label '" << e1_label << "' has been stored !");
-      auto e1 = pattern_.get_particle_track(e1_label);
 
       const std::string e2_label = "e2";
       DT_THROW_IF(! pattern_.has_particle_track(e2_label), std::logic_error,
                   "No particle with label '" << e2_label << "' has been stored !");
-      auto e2 = pattern_.get_particle_track(e2_label);
 
       const int ngammas = pattern_.get_particle_track_dictionary().size()-2;
       dynamic_cast<snemo::datamodel::topology_2eNg_pattern &>(pattern_).set_number_of_gammas(ngammas);
 
+      std::vector<std::string> g_labels;
       for (int i_gamma = 1; i_gamma <= ngammas; ++i_gamma) {
         std::ostringstream oss;
         oss << "g" << i_gamma;
+        g_labels.push_back(oss.str());
+        DT_THROW_IF(! pattern_.has_particle_track(g_labels.back()), std::logic_error,
+                    "No particle with label '" << g_labels.back() << "' has been stored !");
+      }
 
-        const std::string g_label = oss.str();
-        DT_THROW_IF(! pattern_.has_particle_track(g_label), std::logic_error,
-                    "No particle with label '" << g_label << "' has been stored !");
-        const snemo::datamodel::particle_track & gamma = pattern_.get_particle_track(g_label);
-        auto meas = pattern_.get_measurement_dictionary();
-        auto& drivers = base_topology_builder::get_measurement_drivers();
-        {
-          snemo::datamodel::tof_measurement * ptr_tof = new snemo::datamodel::tof_measurement;
-          meas["tof_e1_" + g_label].reset(ptr_tof);
-          if (drivers.TOFD) drivers.TOFD->process(e1, gamma, *ptr_tof);
-        }
-
-        {
-          snemo::datamodel::tof_measurement * ptr_tof = new snemo::datamodel::tof_measurement;
-          meas["tof_e2_" + g_label].reset(ptr_tof);
-          if (drivers.TOFD) drivers.TOFD->process(e2, gamma, *ptr_tof);
-        }
-
-
-        if (drivers.AMD) {
-          double firstElectronGammaAngle = drivers.AMD->process(e1, gamma);
-          meas["angle_e1_" + g_label].reset(new snemo::datamodel::angle_measurement(firstElectronGammaAngle));
-
-          double secondElectronGammaAngle = drivers.AMD->process(e2, gamma);
-          meas["angle_e2_" + g_label].reset(new snemo::datamodel::angle_measurement(secondElectronGammaAngle));
-        }
+      add_gamma_measurements(pattern_, {e1_label, e2_label}, g_labels);
 
-        {
-          snemo::datamodel::energy_measurement * ptr_energy = new snemo::datamodel::energy_measurement;
-          meas["energy_" + g_label].reset(ptr_energy);
-          if (drivers.EMD) drivers.EMD->process(gamma, *ptr_energy);
-        }
-      }
+      // All the electron/gamma angles from one set of directions
+      add_angle_measurements(pattern_, {e1_label, e2_label}, g_labels);
     }
 
   } // end of namespace reconstruction
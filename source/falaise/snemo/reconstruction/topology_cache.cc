@@ -0,0 +1,438 @@
+/// \file falaise/snemo/reconstruction/topology_cache.cc
+
+// Ourselves:
+#include <snemo/reconstruction/topology_cache.h>
+
+// Standard library:
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// - POSIX:
+#include <unistd.h>
+
+// Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/io_factory.h>
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/tracker_cluster.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+
+namespace {
+
+  /// Append the raw bytes of a value to a key
+  template <typename T>
+  void append_to_key(std::string & key_, const T & value_)
+  {
+    key_.append(reinterpret_cast<const char *>(&value_), sizeof(value_));
+  }
+
+  /// Append a string and its length to a key
+  void append_string_to_key(std::string & key_, const std::string & value_)
+  {
+    append_to_key(key_, uint32_t(value_.size()));
+    key_.append(value_);
+  }
+
+  /// Append a position to a key
+  void append_vector_to_key(std::string & key_, const geomtools::vector_3d & value_)
+  {
+    append_to_key(key_, value_.x());
+    append_to_key(key_, value_.y());
+    append_to_key(key_, value_.z());
+  }
+
+  /// Append the keys and values of a set of properties to a key
+  void append_properties_to_key(std::string & key_, const datatools::properties & value_)
+  {
+    std::ostringstream oss;
+    value_.tree_dump(oss);
+    append_string_to_key(key_, oss.str());
+  }
+
+  /// Return the hexadecimal form of a key, as stored in the entries
+  std::string to_hex(const std::string & key_)
+  {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(2 * key_.size());
+    for (const auto& c : key_) {
+      hex += digits[(static_cast<unsigned char>(c) >> 4) & 0xf];
+      hex += digits[static_cast<unsigned char>(c) & 0xf];
+    }
+    return hex;
+  }
+
+}
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    topology_cache::statistics::statistics()
+    {
+      hits = 0;
+      misses = 0;
+      stores = 0;
+      mismatches = 0;
+      evictions = 0;
+    }
+
+    double topology_cache::statistics::get_hit_rate() const
+    {
+      const size_t lookups = hits + misses;
+      if (lookups == 0) return datatools::invalid_real();
+      return double(hits) / lookups;
+    }
+
+    void topology_cache::statistics::print(std::ostream & out_, const std::string & indent_) const
+    {
+      out_ << indent_ << "Hits           : " << hits << std::endl;
+      out_ << indent_ << "Misses         : " << misses << std::endl;
+      out_ << indent_ << "Hit rate       : " << get_hit_rate() << std::endl;
+      out_ << indent_ << "Stores         : " << stores << std::endl;
+      out_ << indent_ << "Mismatches     : " << mismatches << std::endl;
+      out_ << indent_ << "Evictions      : " << evictions << std::endl;
+    }
+
+    // static
+    std::string topology_cache::hash(const std::string & data_)
+    {
+      uint64_t h = 14695981039346656037ULL;
+      for (const auto& c : data_) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+      }
+      std::ostringstream oss;
+      oss << std::hex << std::setw(16) << std::setfill('0') << h;
+      return oss.str();
+    }
+
+    bool topology_cache::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void topology_cache::set_logging_priority(const datatools::logger::priority priority_)
+    {
+      _logging_priority_ = priority_;
+    }
+
+    datatools::logger::priority topology_cache::get_logging_priority() const
+    {
+      return _logging_priority_;
+    }
+
+    // Constructor
+    topology_cache::topology_cache()
+    {
+      _initialized_ = false;
+      _set_defaults();
+    }
+
+    // Destructor
+    topology_cache::~topology_cache()
+    {
+      if (is_initialized()) {
+        reset();
+      }
+    }
+
+    void topology_cache::initialize(const datatools::properties & setup_, const std::string & configuration_key_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Topology cache is already initialized !");
+
+      datatools::logger::priority lp = datatools::logger::extract_logging_configuration(setup_);
+      DT_THROW_IF(lp == datatools::logger::PRIO_UNDEFINED, std::logic_error,
+                  "Invalid logging priority level for topology cache !");
+      set_logging_priority(lp);
+
+      DT_THROW_IF(! setup_.has_key("directory"), std::logic_error, "Missing cache 'directory' !");
+      std::string a_directory = setup_.fetch_path("directory");
+      datatools::fetch_path_with_env(a_directory);
+
+      if (setup_.has_key("max_entries")) {
+        const int max_entries = setup_.fetch_integer("max_entries");
+        DT_THROW_IF(max_entries < 0, std::domain_error, "Invalid maximum number of entries !");
+        _max_entries_ = max_entries;
+      }
+
+      if (setup_.has_key("max_size")) {
+        const int max_size = setup_.fetch_integer("max_size");
+        DT_THROW_IF(max_size < 0, std::domain_error, "Invalid maximum size !");
+        _max_size_ = size_t(max_size) * 1024 * 1024;
+      }
+
+      // One directory per configuration: a new configuration never sees
+      // entries computed with another one
+      boost::filesystem::path a_path(a_directory);
+      a_path /= configuration_key_;
+      boost::filesystem::create_directories(a_path);
+      _directory_ = a_path.string();
+
+      // Entries of previous jobs, ordered by their last use
+      std::vector<std::pair<std::time_t, boost::filesystem::path> > previous_entries;
+      for (boost::filesystem::directory_iterator it(a_path), end; it != end; ++it) {
+        if (! boost::filesystem::is_regular_file(it->status())) continue;
+        if (it->path().extension() != ".data") continue;
+        // Entries being written by other jobs
+        if (it->path().filename().string().compare(0, 5, ".tmp.") == 0) continue;
+        previous_entries.push_back(std::make_pair(boost::filesystem::last_write_time(it->path()), it->path()));
+      }
+      std::sort(previous_entries.begin(), previous_entries.end());
+      for (const auto& an_entry : previous_entries) {
+        _touch_entry_(an_entry.second.stem().string(), boost::filesystem::file_size(an_entry.second));
+      }
+      _evict_entries_();
+      DT_LOG_DEBUG(get_logging_priority(), "Topology cache '" << _directory_ << "' holds "
+                   << _entries_.size() << " entries (" << _size_ << " bytes)");
+
+      _initialized_ = true;
+    }
+
+    void topology_cache::reset()
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Topology cache is not initialized !");
+      if (get_logging_priority() >= datatools::logger::PRIO_NOTICE) {
+        DT_LOG_NOTICE(get_logging_priority(), "Topology cache statistics: ");
+        _statistics_.print(std::clog, "[notice]: ");
+      }
+      _initialized_ = false;
+      _set_defaults();
+    }
+
+    void topology_cache::_set_defaults()
+    {
+      _logging_priority_ = datatools::logger::PRIO_WARNING;
+      _directory_.clear();
+      _max_entries_ = 0;
+      _max_size_ = size_t(1024) * 1024 * 1024;
+      _usage_.clear();
+      _entries_.clear();
+      _size_ = 0;
+      _statistics_ = statistics();
+    }
+
+    const topology_cache::statistics & topology_cache::get_statistics() const
+    {
+      return _statistics_;
+    }
+
+    std::string topology_cache::_get_entry_path_(const std::string & name_) const
+    {
+      return _directory_ + "/" + name_ + ".data";
+    }
+
+    std::string topology_cache::_get_temporary_path_(const std::string & name_) const
+    {
+      // Unique to the writing process and thread, so that two writers of the
+      // same entry never share their temporary file
+      std::ostringstream oss;
+      oss << _directory_ << "/.tmp." << ::getpid()
+          << "." << std::hash<std::thread::id>()(std::this_thread::get_id())
+          << "." << name_ << ".data";
+      return oss.str();
+    }
+
+    void topology_cache::_touch_entry_(const std::string & name_, size_t size_)
+    {
+      auto found = _entries_.find(name_);
+      if (found != _entries_.end()) {
+        _size_ -= found->second.size;
+        _usage_.erase(found->second.position);
+        _entries_.erase(found);
+      }
+      _usage_.push_front(name_);
+      entry_record a_record;
+      a_record.position = _usage_.begin();
+      a_record.size = size_;
+      _entries_[name_] = a_record;
+      _size_ += size_;
+    }
+
+    void topology_cache::_evict_entries_()
+    {
+      while (! _usage_.empty() &&
+             ((_max_entries_ > 0 && _entries_.size() > _max_entries_) ||
+              (_max_size_ > 0 && _size_ > _max_size_))) {
+        const std::string a_name = _usage_.back();
+        boost::system::error_code an_error;
+        boost::filesystem::remove(_get_entry_path_(a_name), an_error);
+        _size_ -= _entries_[a_name].size;
+        _entries_.erase(a_name);
+        _usage_.pop_back();
+        _statistics_.evictions++;
+      }
+    }
+
+    std::string topology_cache::make_key(const snemo::datamodel::particle_track_data & ptd_) const
+    {
+      std::string a_key;
+      a_key.reserve(512);
+      // The auxiliaries are restored from the entry on a hit
+      append_properties_to_key(a_key, ptd_.get_auxiliaries());
+      append_to_key(a_key, uint32_t(ptd_.get_particles().size()));
+      for (const auto& a_handle : ptd_.get_particles()) {
+        const snemo::datamodel::particle_track & a_particle = a_handle.get();
+        append_properties_to_key(a_key, a_particle.get_auxiliaries());
+        append_to_key(a_key, int32_t(a_particle.get_charge()));
+
+        append_to_key(a_key, uint32_t(a_particle.get_vertices().size()));
+        for (const auto& a_vertex_handle : a_particle.get_vertices()) {
+          const geomtools::blur_spot & a_vertex = a_vertex_handle.get();
+          const std::string & a_type_key = snemo::datamodel::particle_track::vertex_type_key();
+          append_string_to_key(a_key, a_vertex.get_auxiliaries().has_key(a_type_key)
+                               ? a_vertex.get_auxiliaries().fetch_string(a_type_key) : std::string());
+          append_to_key(a_key, int32_t(a_vertex.get_blur_dimension()));
+          append_vector_to_key(a_key, a_vertex.get_position());
+          append_to_key(a_key, a_vertex.get_x_error());
+          append_to_key(a_key, a_vertex.get_y_error());
+          append_to_key(a_key, a_vertex.get_z_error());
+          const geomtools::geom_id & a_gid = a_vertex.get_geom_id();
+          append_to_key(a_key, uint32_t(a_gid.get_type()));
+          append_to_key(a_key, uint32_t(a_gid.get_depth()));
+          for (size_t i = 0; i < a_gid.get_depth(); i++) append_to_key(a_key, uint32_t(a_gid.get(i)));
+        }
+
+        append_to_key(a_key, uint32_t(a_particle.get_associated_calorimeter_hits().size()));
+        for (const auto& a_calo_handle : a_particle.get_associated_calorimeter_hits()) {
+          const snemo::datamodel::calibrated_calorimeter_hit & a_calo = a_calo_handle.get();
+          const geomtools::geom_id & a_gid = a_calo.get_geom_id();
+          append_to_key(a_key, uint32_t(a_gid.get_type()));
+          append_to_key(a_key, uint32_t(a_gid.get_depth()));
+          for (size_t i = 0; i < a_gid.get_depth(); i++) append_to_key(a_key, uint32_t(a_gid.get(i)));
+          append_to_key(a_key, a_calo.get_energy());
+          append_to_key(a_key, a_calo.get_sigma_energy());
+          append_to_key(a_key, a_calo.get_time());
+          append_to_key(a_key, a_calo.get_sigma_time());
+        }
+
+        append_to_key(a_key, uint8_t(a_particle.has_trajectory()));
+        if (a_particle.has_trajectory()) {
+          const snemo::datamodel::tracker_trajectory & a_trajectory = a_particle.get_trajectory();
+          append_to_key(a_key, uint8_t(a_trajectory.has_cluster() && a_trajectory.get_cluster().is_delayed()));
+          const snemo::datamodel::base_trajectory_pattern & a_pattern = a_trajectory.get_pattern();
+          append_string_to_key(a_key, a_pattern.get_pattern_id());
+          append_vector_to_key(a_key, a_pattern.get_first());
+          append_vector_to_key(a_key, a_pattern.get_last());
+          append_to_key(a_key, a_pattern.get_shape().get_length());
+        }
+      }
+      return a_key;
+    }
+
+    bool topology_cache::load(const std::string & key_,
+                              snemo::datamodel::particle_track_data & ptd_,
+                              snemo::datamodel::topology_data & td_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Topology cache is not initialized !");
+
+      const std::string a_name = hash(key_);
+      const std::string a_path = _get_entry_path_(a_name);
+      if (! boost::filesystem::exists(a_path)) {
+        _statistics_.misses++;
+        return false;
+      }
+
+      datatools::properties a_header;
+      snemo::datamodel::topology_data a_td;
+      datatools::properties a_ptd_aux;
+      std::vector<datatools::properties> particle_auxes;
+      try {
+        datatools::data_reader reader(a_path, datatools::using_multiple_archives);
+        reader.load(a_header);
+        // Two keys may share a hash: only the entry of the very same key is used
+        if (! a_header.has_key("key") || a_header.fetch_string("key") != to_hex(key_)) {
+          DT_LOG_DEBUG(get_logging_priority(), "Cache entry '" << a_path << "' belongs to another key");
+          _statistics_.mismatches++;
+          _statistics_.misses++;
+          return false;
+        }
+        reader.load(a_td);
+        reader.load(a_ptd_aux);
+        const size_t nparticles = a_header.fetch_integer("number_of_particles");
+        particle_auxes.resize(nparticles);
+        for (auto& a_aux : particle_auxes) {
+          reader.load(a_aux);
+        }
+      } catch (std::exception & error) {
+        DT_LOG_WARNING(get_logging_priority(), "Cannot read cache entry '" << a_path << "': " << error.what());
+        _statistics_.misses++;
+        return false;
+      }
+
+      if (particle_auxes.size() != ptd_.get_particles().size()) {
+        DT_LOG_WARNING(get_logging_priority(), "Cache entry '" << a_path << "' does not match the particles !");
+        _statistics_.misses++;
+        return false;
+      }
+
+      ptd_.grab_auxiliaries() = a_ptd_aux;
+      for (size_t i = 0; i < particle_auxes.size(); i++) {
+        ptd_.grab_particles()[i].grab().grab_auxiliaries() = particle_auxes[i];
+      }
+      td_ = a_td;
+
+      // The file time records the last use for the eviction of later jobs
+      boost::system::error_code an_error;
+      boost::filesystem::last_write_time(a_path, std::time(0), an_error);
+      const uintmax_t a_size = boost::filesystem::file_size(a_path, an_error);
+      _touch_entry_(a_name, an_error ? 0 : a_size);
+      _statistics_.hits++;
+      return true;
+    }
+
+    void topology_cache::store(const std::string & key_,
+                               const snemo::datamodel::particle_track_data & ptd_,
+                               const snemo::datamodel::topology_data & td_)
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Topology cache is not initialized !");
+
+      // Written aside then renamed so concurrent jobs never read a partial entry
+      const std::string a_name = hash(key_);
+      const std::string a_path = _get_entry_path_(a_name);
+      const std::string a_tmp_path = _get_temporary_path_(a_name);
+      {
+        datatools::properties a_header;
+        a_header.store("key", to_hex(key_));
+        a_header.store("number_of_particles", int(ptd_.get_particles().size()));
+        datatools::data_writer writer(a_tmp_path, datatools::using_multiple_archives);
+        writer.store(a_header);
+        writer.store(td_);
+        writer.store(ptd_.get_auxiliaries());
+        for (const auto& a_particle : ptd_.get_particles()) {
+          writer.store(a_particle.get().get_auxiliaries());
+        }
+      }
+      if (std::rename(a_tmp_path.c_str(), a_path.c_str()) != 0) {
+        std::remove(a_tmp_path.c_str());
+        DT_THROW(std::runtime_error, "Cannot store cache entry '" << a_path << "' !");
+      }
+
+      _touch_entry_(a_name, boost::filesystem::file_size(a_path));
+      _statistics_.stores++;
+      _evict_entries_();
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
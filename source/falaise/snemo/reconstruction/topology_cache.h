@@ -0,0 +1,155 @@
+/** \file falaise/snemo/reconstruction/topology_cache.h
+ *
+ * Description:
+ *
+ *   An on-disk cache of the particle identification and topology results.
+ *   Entries are keyed by the input fields read by the PID and measurement
+ *   drivers and live in a directory named after a hash of the effective
+ *   configuration, so that any configuration change starts a new, empty
+ *   cache. The least recently used entries are evicted beyond the size
+ *   limits.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_CACHE_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_CACHE_H 1
+
+// Standard library:
+#include <iostream>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// - Bayeux/datatools:
+#include <datatools/logger.h>
+
+namespace snemo {
+
+  namespace datamodel {
+    class particle_track_data;
+    class topology_data;
+  }
+
+  namespace reconstruction {
+
+    /// \brief On-disk cache of topology results
+    class topology_cache
+    {
+    public:
+
+      /// Cache usage statistics
+      struct statistics {
+        statistics();
+
+        /// Return the fraction of lookups found in the cache
+        double get_hit_rate() const;
+
+        /// Print the statistics
+        void print(std::ostream & out_ = std::clog, const std::string & indent_ = "") const;
+
+        size_t hits;            //!< Number of lookups found in the cache
+        size_t misses;          //!< Number of lookups not found in the cache
+        size_t stores;          //!< Number of stored entries
+        size_t mismatches;      //!< Number of entries found under the hash of another key
+        size_t evictions;       //!< Number of least recently used entries removed to fit the limits
+      };
+
+      /// Return the 64 bits FNV-1a hash of a string as an hexadecimal string
+      static std::string hash(const std::string & data_);
+
+    public:
+      /// Constructor
+      topology_cache();
+
+      /// Destructor
+      virtual ~topology_cache();
+
+      /// Getting initialization flag
+      bool is_initialized() const;
+
+      /// Setting logging priority
+      void set_logging_priority(const datatools::logger::priority priority_);
+
+      /// Getting logging priority
+      datatools::logger::priority get_logging_priority() const;
+
+      /// Initialize the cache for a given configuration key
+      void initialize(const datatools::properties & setup_, const std::string & configuration_key_);
+
+      /// Reset the cache
+      void reset();
+
+      /// Return the key of an input particle track data, before any processing
+      ///
+      /// The key is a compact binary record of the fields read by the PID and
+      /// measurement drivers: charges, vertices, calorimeter hits and
+      /// trajectories, plus the auxiliaries that a hit overwrites. Entries are
+      /// named after its hash and store it in full.
+      std::string make_key(const snemo::datamodel::particle_track_data & ptd_) const;
+
+      /// Restore the PID labels and the topology data of an entry, return false if missing
+      bool load(const std::string & key_,
+                snemo::datamodel::particle_track_data & ptd_,
+                snemo::datamodel::topology_data & td_);
+
+      /// Store the PID labels and the topology data of an entry
+      void store(const std::string & key_,
+                 const snemo::datamodel::particle_track_data & ptd_,
+                 const snemo::datamodel::topology_data & td_);
+
+      /// Return the usage statistics
+      const statistics & get_statistics() const;
+
+    protected:
+
+      /// Set default values to class members
+      void _set_defaults();
+
+    private:
+
+      /// Return the path of an entry file
+      std::string _get_entry_path_(const std::string & name_) const;
+
+      /// Return the path an entry file is written to before it is renamed
+      std::string _get_temporary_path_(const std::string & name_) const;
+
+      /// Register an entry as the most recently used one
+      void _touch_entry_(const std::string & name_, size_t size_);
+
+      /// Remove the least recently used entries beyond the limits
+      void _evict_entries_();
+
+    private:
+
+      /// Position and size of an entry
+      struct entry_record {
+        std::list<std::string>::iterator position; //!< Position in the usage list
+        size_t size;                               //!< Size of the entry file in bytes
+      };
+
+      bool _initialized_;                             //!< Initialize flag
+      datatools::logger::priority _logging_priority_; //!< Logging priority
+      std::string _directory_;                        //!< Directory of the entries of the current configuration
+      size_t _max_entries_;                           //!< Maximum number of entries (0 for no limit)
+      size_t _max_size_;                              //!< Maximum size of the entries in bytes (0 for no limit)
+      std::list<std::string> _usage_;                 //!< Entry names, the most recently used first
+      std::unordered_map<std::string, entry_record> _entries_; //!< Known entries by name
+      size_t _size_;                                  //!< Current size of the entries in bytes
+      statistics _statistics_;                        //!< Usage statistics
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_CACHE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -6,6 +6,10 @@
 // Standard library
 #include <regex>
 
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/object_configuration_description.h>
+
 // Third party:
 // - Bayeux/cuts:
 #include <bayeux/cuts/cut_manager.h>
@@ -22,6 +26,7 @@
 #include <falaise/snemo/reconstruction/energy_driver.h>
 
 #include <falaise/snemo/reconstruction/base_topology_builder.h>
+#include <falaise/snemo/reconstruction/task_pool.h>
 
 namespace snemo {
 
@@ -91,38 +96,56 @@ namespace snemo {
         driver_names.push_back(snemo::reconstruction::energy_driver::get_id());
       }
       
+      // Drivers are only initialized when a measurement first needs them
+      std::shared_ptr<const datatools::properties> a_setup(new datatools::properties(setup_));
       for (auto& i_driver : driver_names) {
-        auto a_driver_name = i_driver;
-
-        if (a_driver_name == snemo::reconstruction::tof_driver::get_id()) {
-          // Initialize TOF Driver
-          _drivers_.TOFD.reset(new snemo::reconstruction::tof_driver);
-          datatools::properties TOFD_config;
-          setup_.export_and_rename_starting_with(TOFD_config, std::string(a_driver_name + "."), "");
-          _drivers_.TOFD->initialize(TOFD_config);
-        } else if (a_driver_name == snemo::reconstruction::vertex_driver::get_id()) {
-          // Initialize Vertex Driver
-          _drivers_.VD.reset(new snemo::reconstruction::vertex_driver);
-          datatools::properties VD_config;
-          setup_.export_and_rename_starting_with(VD_config, std::string(a_driver_name + "."), "");
-          _drivers_.VD->initialize(VD_config);
-        } else if (a_driver_name == snemo::reconstruction::angle_driver::get_id()) {
-          // Initialize Angle Driver
-          _drivers_.AMD.reset(new snemo::reconstruction::angle_driver);
-          datatools::properties AMD_config;
-          setup_.export_and_rename_starting_with(AMD_config, std::string(a_driver_name + "."), "");
-          _drivers_.AMD->initialize(AMD_config);
-        } else if (a_driver_name == snemo::reconstruction::energy_driver::get_id()) {
-          // Initialize Energy Driver
-          _drivers_.EMD.reset(new snemo::reconstruction::energy_driver);
-          datatools::properties EMD_config;
-          setup_.export_and_rename_starting_with(EMD_config, std::string(a_driver_name + "."), "");
-          _drivers_.EMD->initialize(EMD_config);
+        const std::string a_prefix = i_driver + ".";
+        if (i_driver == snemo::reconstruction::tof_driver::get_id()) {
+          _drivers_->TOFD.configure(a_setup, a_prefix);
+        } else if (i_driver == snemo::reconstruction::vertex_driver::get_id()) {
+          _drivers_->VD.configure(a_setup, a_prefix);
+        } else if (i_driver == snemo::reconstruction::angle_driver::get_id()) {
+          _drivers_->AMD.configure(a_setup, a_prefix);
+        } else if (i_driver == snemo::reconstruction::energy_driver::get_id()) {
+          _drivers_->EMD.configure(a_setup, a_prefix);
         } else {
-          DT_THROW_IF(true, std::logic_error, "Driver '" << a_driver_name << "' does not exist !");
+          DT_THROW_IF(true, std::logic_error, "Driver '" << i_driver << "' does not exist !");
         }
       }
 
+      if (setup_.has_key("lazy_measurements")) {
+        _lazy_measurements_ = setup_.fetch_boolean("lazy_measurements");
+      }
+
+      if (setup_.has_key("parallel_gammas.threshold")) {
+        const int threshold = setup_.fetch_integer("parallel_gammas.threshold");
+        DT_THROW_IF(threshold < 0, std::domain_error, "Invalid parallel gamma threshold !");
+        _parallel_gamma_threshold_ = threshold;
+      }
+
+      if (setup_.has_key("parallel_gammas.max_threads")) {
+        const int max_threads = setup_.fetch_integer("parallel_gammas.max_threads");
+        DT_THROW_IF(max_threads < 0, std::domain_error, "Invalid maximum number of threads !");
+        _parallel_max_threads_ = max_threads;
+      }
+
+      if (_parallel_gamma_threshold_ > 0) {
+        // Threads are started once, not for every event
+        _task_pool_.reset(new task_pool(_parallel_max_threads_));
+      }
+
+      if (setup_.has_key("accepted_classifications")) {
+        std::vector<std::string> classifications;
+        setup_.fetch("accepted_classifications", classifications);
+        for (const auto& a_classification : classifications) {
+          _accepted_classifications_.push_back(std::regex(a_classification));
+        }
+      }
+
+      if (setup_.has_key("generic_topologies")) {
+        _generic_topologies_ = setup_.fetch_boolean("generic_topologies");
+      }
+
       set_initialized(true);
     }
 
@@ -152,10 +175,15 @@ namespace snemo {
     void topology_driver::_set_defaults()
     {
       _logging_priority_ = datatools::logger::PRIO_WARNING;
-      _drivers_.TOFD.reset(0);
-      _drivers_.VD.reset(0);
-      _drivers_.AMD.reset(0);
-      _drivers_.EMD.reset(0);
+      _lazy_measurements_ = false;
+      _parallel_gamma_threshold_ = 0;
+      _parallel_max_threads_ = 0;
+      _task_pool_.reset();
+      _accepted_classifications_.clear();
+      _generic_topologies_ = false;
+      _builder_factories_.clear();
+      // Patterns still holding lazy measurements keep the previous drivers alive
+      _drivers_ = std::make_shared<measurement_drivers>();
     }
 
     int topology_driver::_process_algo(const snemo::datamodel::particle_track_data & ptd_,
@@ -166,23 +194,25 @@ namespace snemo {
       const std::string a_classification = topology_driver::_get_classification_(ptd_);
       td_.get_auxiliaries().store(snemo::datamodel::pid_utils::classification_label_key(),
                                    a_classification);
-      const std::string a_builder_class_id = topology_driver::_get_builder_class_id_(a_classification);
-      if (a_builder_class_id.empty()) {
-        DT_LOG_DEBUG(get_logging_priority(), "Topology not supported for the measurements ");
+      if (! _is_accepted_classification_(a_classification)) {
+        // Rejected events only keep their classification
+        DT_LOG_DEBUG(get_logging_priority(), "Classification '" << a_classification << "' is not accepted !");
         return 0;
       }
 
-      const base_topology_builder::factory_register_type & FB
-        = DATATOOLS_FACTORY_GET_SYSTEM_REGISTER(base_topology_builder);
-      DT_THROW_IF(! FB.has(a_builder_class_id), std::logic_error,
-                  "Topology builder class id '" << a_builder_class_id << "' "
-                  << "is not available from the system builder factory register !");
-      const auto& the_factory = FB.get(a_builder_class_id);
-      auto new_builder = the_factory();
-
+      const builder_factory_type & the_factory = _get_builder_factory_(a_classification);
+      if (! the_factory) {
+        DT_LOG_DEBUG(get_logging_priority(), "Topology not supported for the measurements ");
+        return 0;
+      }
+      // Shared ownership: lazy measurements keep the builder alive until evaluated
+      std::shared_ptr<base_topology_builder> new_builder(the_factory());
 
       // Build new topology pattern
       new_builder->set_measurement_drivers(_drivers_);
+      new_builder->set_lazy_measurements(_lazy_measurements_);
+      new_builder->set_parallel_gamma_threshold(_parallel_gamma_threshold_);
+      new_builder->set_task_pool(_task_pool_.get());
       auto pattern = new_builder->build(ptd_);
       td_.set_pattern_handle(pattern);
 
@@ -195,6 +225,28 @@ namespace snemo {
       return 0;
     }
 
+    const topology_driver::builder_factory_type &
+    topology_driver::_get_builder_factory_(const std::string & classification_)
+    {
+      // Factories are never removed while processing: references stay valid once unlocked
+      std::lock_guard<std::mutex> lock(_builder_factories_mutex_);
+      auto found = _builder_factories_.find(classification_);
+      if (found != _builder_factories_.end()) return found->second;
+
+      // First event of this classification: resolve its builder once
+      builder_factory_type & the_factory = _builder_factories_[classification_];
+      const std::string a_builder_class_id = topology_driver::_get_builder_class_id_(classification_);
+      if (! a_builder_class_id.empty()) {
+        const base_topology_builder::factory_register_type & FB
+          = DATATOOLS_FACTORY_GET_SYSTEM_REGISTER(base_topology_builder);
+        DT_THROW_IF(! FB.has(a_builder_class_id), std::logic_error,
+                    "Topology builder class id '" << a_builder_class_id << "' "
+                    << "is not available from the system builder factory register !");
+        the_factory = FB.get(a_builder_class_id);
+      }
+      return the_factory;
+    }
+
     std::string topology_driver::_get_classification_(const snemo::datamodel::particle_track_data & ptd_) const
     {
       const datatools::properties & aux = ptd_.get_auxiliaries();
@@ -239,6 +291,8 @@ namespace snemo {
         a_class_id = "snemo::reconstruction::topology_2e_builder";
       } else if (std::regex_match(classification_, std::regex("2e[0-9]+g"))) {
         a_class_id = "snemo::reconstruction::topology_2eNg_builder";
+      } else if (_generic_topologies_ && ! classification_.empty()) {
+        a_class_id = "snemo::reconstruction::topology_generic_builder";
       } else {
         DT_LOG_DEBUG(get_logging_priority(), "Non supported classification '" << classification_ << "' !");
       }
@@ -246,12 +300,121 @@ namespace snemo {
       return a_class_id;
     }
 
+    bool topology_driver::_is_accepted_classification_(const std::string & classification_) const
+    {
+      if (_accepted_classifications_.empty()) return true;
+      for (const auto& a_regex : _accepted_classifications_) {
+        if (std::regex_match(classification_, a_regex)) return true;
+      }
+      return false;
+    }
+
     // static
     void topology_driver::init_ocd(datatools::object_configuration_description & ocd_)
     {
       // Prefix "TD" stands for "Topology Driver" :
       //datatools::logger::declare_ocd_logging_configuration(ocd_, "fatal", "TD.");
 
+      {
+        // Description of the 'lazy_measurements' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("lazy_measurements")
+          .set_terse_description("Flag to compute topology measurements on first access")
+          .set_traits(datatools::TYPE_BOOLEAN)
+          .set_mandatory(false)
+          .set_default_value_boolean(false)
+          .set_long_description("Measurements are registered within the topology pattern and    \n"
+                                "only computed when a cut, an accessor or the serializer asks \n"
+                                "for them. The pattern shares the measurement drivers, so it  \n"
+                                "may be evaluated after the topology driver has been reset.   \n"
+                                "Concurrent readers of a pattern evaluate it once, and copies \n"
+                                "of a pattern evaluate its pending measurements first.        \n")
+          .add_example("Compute measurements on demand::  \n"
+                       "                                  \n"
+                       "  lazy_measurements : boolean = true \n"
+                       "                                  \n"
+                       );
+      }
+
+      {
+        // Description of the 'parallel_gammas.threshold' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("parallel_gammas.threshold")
+          .set_terse_description("Number of gammas from which per-gamma measurements are computed concurrently")
+          .set_traits(datatools::TYPE_INTEGER)
+          .set_mandatory(false)
+          .set_default_value_integer(0)
+          .set_long_description("The TOF and energy measurements of the gammas of '1eNg' and '2eNg' \n"
+                                "events are spread over several threads when the event holds at  \n"
+                                "least this number of gammas, using a pool of threads started at \n"
+                                "initialization. Results are identical to a serial computation.   \n"
+                                "Zero disables the feature. Lazy measurements, and events         \n"
+                                "processed by the workers of the topology scheduler, are always   \n"
+                                "computed serially.                                               \n")
+          .add_example("Spread the measurements of events with 8 gammas or more:: \n"
+                       "                                                          \n"
+                       "  parallel_gammas.threshold : integer = 8                 \n"
+                       "                                                          \n"
+                       );
+      }
+
+      {
+        // Description of the 'parallel_gammas.max_threads' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("parallel_gammas.max_threads")
+          .set_terse_description("Maximum number of threads computing per-gamma measurements")
+          .set_traits(datatools::TYPE_INTEGER)
+          .set_mandatory(false)
+          .set_default_value_integer(0)
+          .set_long_description("Size of the pool, the processing thread included. Zero stands \n"
+                                "for the hardware concurrency.                                  \n")
+          ;
+      }
+
+      {
+        // Description of the 'accepted_classifications' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("accepted_classifications")
+          .set_terse_description("List of event classifications to build topology patterns for")
+          .set_traits(datatools::TYPE_STRING,
+                      datatools::configuration_property_description::ARRAY)
+          .set_mandatory(false)
+          .set_long_description("Each entry is a regular expression matched against the event    \n"
+                                "classification (e.g. '2e', '1e[0-9]+g'). Events with another     \n"
+                                "classification only get the classification label within their  \n"
+                                "topology data: no pattern nor measurement is computed.          \n"
+                                "All the classifications are processed if the list is missing.  \n")
+          .add_example("Only process 2 electrons and 1 electron channels::     \n"
+                       "                                                         \n"
+                       "  accepted_classifications : string[2] = \"2e([0-9]+g)?\" \"1e([0-9]+g)?\" \n"
+                       "                                                         \n"
+                       );
+      }
+
+      {
+        // Description of the 'generic_topologies' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("generic_topologies")
+          .set_terse_description("Flag to build generic patterns for the classifications without a dedicated builder")
+          .set_traits(datatools::TYPE_BOOLEAN)
+          .set_mandatory(false)
+          .set_default_value_boolean(false)
+          .set_long_description("Events classified as '3e', '1e1p1g', '2e1a'... get a 'generic'  \n"
+                                "pattern holding the energies, TOFs, vertices and angles of all  \n"
+                                "their particles and relevant particle pairs. Otherwise they only \n"
+                                "get the classification label within their topology data.       \n")
+          .add_example("Build patterns for all the classifications:: \n"
+                       "                                             \n"
+                       "  generic_topologies : boolean = true        \n"
+                       "                                             \n"
+                       );
+      }
+
       // Invoke specific OCD support from the driver class:
       ::snemo::reconstruction::tof_driver::init_ocd(ocd_);
       ::snemo::reconstruction::vertex_driver::init_ocd(ocd_);
@@ -33,10 +33,19 @@
 
 // Third party:
 // - Boost:
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <vector>
+#include <functional>
 
 // - Bayeux/datatools:
+#include <datatools/exception.h>
 #include <datatools/logger.h>
+#include <datatools/properties.h>
 
 namespace snemo {
 
@@ -53,11 +62,93 @@ namespace snemo {
     class angle_driver;
     class energy_driver;
 
+    class base_topology_builder;
+    class task_pool;
+
+    /// \brief A measurement driver configured at startup and initialized on first use
+    ///
+    /// The driver configuration is only extracted, and the driver only
+    /// constructed, when a measurement first needs it. Once initialized,
+    /// the driver is only used through its const, reentrant interface, so
+    /// that a set of drivers can be shared by concurrent builders.
+    template<class Driver>
+    class lazy_driver
+    {
+    public:
+      /// Constructor
+      lazy_driver() : _requested_(false), _driver_(nullptr) {}
+
+      /// Request the driver with the properties starting with a given prefix
+      void configure(const std::shared_ptr<const datatools::properties> & setup_, const std::string & prefix_)
+      {
+        _setup_ = setup_;
+        _prefix_ = prefix_;
+        _requested_ = true;
+      }
+
+      /// Drop the driver
+      void reset()
+      {
+        _driver_ = nullptr;
+        _owned_driver_.reset();
+        _setup_.reset();
+        _prefix_.clear();
+        _requested_ = false;
+      }
+
+      /// Check if the driver has been requested
+      explicit operator bool() const
+      {
+        return _requested_;
+      }
+
+      /// Check if the driver has already been initialized
+      bool is_initialized() const
+      {
+        return _driver_.load(std::memory_order_acquire) != nullptr;
+      }
+
+      /// Return the driver, initializing it on first call (thread safe)
+      const Driver & get() const
+      {
+        const Driver * a_driver = _driver_.load(std::memory_order_acquire);
+        if (a_driver == nullptr) {
+          DT_THROW_IF(! _requested_, std::logic_error, "Driver has not been requested !");
+          std::lock_guard<std::mutex> lock(_mutex_);
+          a_driver = _driver_.load(std::memory_order_relaxed);
+          if (a_driver == nullptr) {
+            datatools::properties a_config;
+            _setup_->export_and_rename_starting_with(a_config, _prefix_, "");
+            std::unique_ptr<Driver> a_new_driver(new Driver);
+            a_new_driver->initialize(a_config);
+            _owned_driver_ = std::move(a_new_driver);
+            a_driver = _owned_driver_.get();
+            _driver_.store(a_driver, std::memory_order_release);
+          }
+        }
+        return *a_driver;
+      }
+
+      /// Access the driver, initializing it on first call (thread safe)
+      const Driver * operator->() const
+      {
+        return &get();
+      }
+
+    private:
+      bool _requested_;                                  //!< Request flag
+      std::shared_ptr<const datatools::properties> _setup_; //!< Setup holding the driver configuration
+      std::string _prefix_;                              //!< Prefix of the driver properties
+      mutable std::mutex _mutex_;                        //!< Guard of the driver initialization
+      mutable std::unique_ptr<Driver> _owned_driver_;    //!< Driver, once initialized
+      mutable std::atomic<const Driver *> _driver_;      //!< Published driver, once initialized
+    };
+
     struct measurement_drivers {
-      std::unique_ptr<snemo::reconstruction::tof_driver> TOFD;
-      std::unique_ptr<snemo::reconstruction::vertex_driver> VD;
-      std::unique_ptr<snemo::reconstruction::angle_driver> AMD;
-      std::unique_ptr<snemo::reconstruction::energy_driver> EMD;
+      lazy_driver<snemo::reconstruction::tof_driver> TOFD;
+      lazy_driver<snemo::reconstruction::vertex_driver> VD;
+      lazy_driver<snemo::reconstruction::angle_driver> AMD;
+      lazy_driver<snemo::reconstruction::energy_driver> EMD;
     };
 
     /// \brief Driver for the topology algorithm
@@ -94,7 +185,7 @@ namespace snemo {
       /// Reset the clusterizer
       virtual void reset();
 
-      /// Main tracker trajectory driver
+      /// Main tracker trajectory driver, which may be called concurrently
       int process(const snemo::datamodel::particle_track_data & ptd_,
                   snemo::datamodel::topology_data & td_);
 
@@ -119,11 +210,28 @@ namespace snemo {
       /// Build the topology builder class id from the classification field
       std::string _get_builder_class_id_(const std::string & classification) const;
 
+      /// Check if an event classification is to be processed
+      bool _is_accepted_classification_(const std::string & classification_) const;
+
+      /// Typedef to the factory of topology builders
+      typedef std::function<base_topology_builder * ()> builder_factory_type;
+
+      /// Return the builder factory of a classification, looked up on first use (empty if not supported)
+      const builder_factory_type & _get_builder_factory_(const std::string & classification_);
+
     private:
 
       bool _initialized_;                             //!< Initialize flag
       datatools::logger::priority _logging_priority_; //!< Logging priority
-      measurement_drivers _drivers_;                  //!< Measurement drivers such as TOF...
+      std::shared_ptr<measurement_drivers> _drivers_; //!< Measurement drivers such as TOF...
+      bool _lazy_measurements_;                       //!< Flag to compute measurements on first access
+      size_t _parallel_gamma_threshold_;              //!< Number of gammas from which measurements are concurrent
+      size_t _parallel_max_threads_;                  //!< Maximum number of threads for concurrent measurements
+      std::unique_ptr<task_pool> _task_pool_;         //!< Pool of threads for concurrent measurements
+      std::vector<std::regex> _accepted_classifications_; //!< Classifications to build patterns for (all if empty)
+      bool _generic_topologies_;                      //!< Flag to build generic patterns for the other classifications
+      std::map<std::string, builder_factory_type> _builder_factories_; //!< Builder factories per classification
+      std::mutex _builder_factories_mutex_;           //!< Guard of the builder factories, for concurrent processing
     };
 
   }  // end of namespace reconstruction
@@ -0,0 +1,109 @@
+/** \file falaise/snemo/datamodels/topology_generic_builder.cc
+ */
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/topology_generic_builder.h>
+#include <falaise/snemo/datamodels/topology_generic_pattern.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+
+// Standard library:
+#include <algorithm>
+#include <cstdlib>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    // Registration instantiation macro :
+    FL_SNEMO_RECONSTRUCTION_TOPOLOGY_BUILDER_REGISTRATION_IMPLEMENT(topology_generic_builder,
+                                                                    "snemo::reconstruction::topology_generic_builder")
+
+    snemo::datamodel::base_topology_pattern::handle_type topology_generic_builder::create_pattern()
+    {
+      snemo::datamodel::base_topology_pattern::handle_type h(new snemo::datamodel::topology_generic_pattern);
+      return h;
+    }
+
+    void topology_generic_builder::make_measurements(snemo::datamodel::base_topology_pattern & pattern_)
+    {
+      snemo::datamodel::topology_generic_pattern & a_pattern
+        = dynamic_cast<snemo::datamodel::topology_generic_pattern &>(pattern_);
+
+      // Labels ordered by particle type, then by index ('e2' before 'e10')
+      std::vector<std::string> labels;
+      for (const auto& i_track : pattern_.get_particle_track_dictionary()) {
+        labels.push_back(i_track.first);
+      }
+      std::sort(labels.begin(), labels.end(),
+                [] (const std::string & a_, const std::string & b_)
+                {
+                  const int rank_a = snemo::datamodel::topology_generic_pattern::get_type_rank(a_);
+                  const int rank_b = snemo::datamodel::topology_generic_pattern::get_type_rank(b_);
+                  if (rank_a != rank_b) return rank_a < rank_b;
+                  return std::atoi(a_.c_str() + 1) < std::atoi(b_.c_str() + 1);
+                });
+      a_pattern.set_particle_labels(labels);
+
+      std::vector<std::string> charged_labels;
+      std::vector<std::string> calorimetric_labels;
+      std::vector<std::string> gamma_labels;
+      for (const auto& a_label : labels) {
+        const snemo::datamodel::particle_track & a_particle = pattern_.get_particle_track(a_label);
+        if (snemo::datamodel::pid_utils::particle_is_gamma(a_particle)) {
+          gamma_labels.push_back(a_label);
+          continue;
+        }
+        charged_labels.push_back(a_label);
+        if (a_particle.has_associated_calorimeter_hits()) {
+          calorimetric_labels.push_back(a_label);
+        }
+      }
+
+      // Single charged particle measurements
+      for (const auto& a_label : charged_labels) {
+        add_angle_measurement(pattern_, a_label);
+      }
+      for (const auto& a_label : calorimetric_labels) {
+        add_energy_measurement(pattern_, a_label);
+      }
+
+      // Charged particle pairs
+      label_pair_collection_type angle_pairs;
+      for (size_t i = 0; i < charged_labels.size(); i++) {
+        for (size_t j = i + 1; j < charged_labels.size(); j++) {
+          const std::string & a_label1 = charged_labels[i];
+          const std::string & a_label2 = charged_labels[j];
+          const bool calorimetric
+            = std::find(calorimetric_labels.begin(), calorimetric_labels.end(), a_label1) != calorimetric_labels.end()
+            && std::find(calorimetric_labels.begin(), calorimetric_labels.end(), a_label2) != calorimetric_labels.end();
+          if (calorimetric) {
+            add_tof_measurement(pattern_, a_label1, a_label2);
+          }
+          add_vertex_measurement(pattern_, a_label1, a_label2);
+          angle_pairs.push_back(std::make_pair(a_label1, a_label2));
+        }
+      }
+
+      // Gammas: energies and TOFs with the calorimetric charged particles
+      add_gamma_measurements(pattern_, calorimetric_labels, gamma_labels);
+      for (const auto& a_label : charged_labels) {
+        for (const auto& g_label : gamma_labels) {
+          angle_pairs.push_back(std::make_pair(a_label, g_label));
+        }
+      }
+
+      // All the pair angles from one set of directions
+      add_angle_measurements(pattern_, angle_pairs);
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
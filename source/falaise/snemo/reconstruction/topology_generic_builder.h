@@ -0,0 +1,52 @@
+/// \file falaise/snemo/datamodels/topology_generic_builder.h
+/*
+ * Description: The class to build the topology pattern of the
+ *              classifications without a dedicated builder
+ */
+
+#ifndef FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_BUILDER_H
+#define FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_BUILDER_H 1
+
+// This project:
+#include <falaise/snemo/reconstruction/base_topology_builder.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief The class to build the 'generic' topology pattern of any set of particles
+    ///
+    /// Every particle gets its energy when it has calorimeter hits, and
+    /// its angle with the source foil when it is charged. Pairs get:
+    /// - a TOF when both particles have calorimeter hits and one is charged,
+    /// - a common vertex when both particles are charged,
+    /// - an angle when one particle is charged.
+    ///
+    /// Per-gamma measurements go through add_gamma_measurements and all the
+    /// angles are computed from one batch of directions.
+    class topology_generic_builder : public base_topology_builder
+    {
+    protected:
+
+      ///
+      virtual snemo::datamodel::base_topology_pattern::handle_type create_pattern();
+
+      virtual void make_measurements(snemo::datamodel::base_topology_pattern & pattern_);
+
+    private:
+
+      /// Macro to automate the registration of the cut
+      FL_SNEMO_RECONSTRUCTION_TOPOLOGY_BUILDER_REGISTRATION_INTERFACE(topology_generic_builder)
+    };
+  }
+}
+
+#endif // FALAISE_SNEMO_DATAMODEL_TOPOLOGY_GENERIC_BUILDER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
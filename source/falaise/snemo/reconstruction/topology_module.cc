@@ -4,24 +4,33 @@
 #include <snemo/reconstruction/topology_module.h>
 
 // Standard library:
+#include <memory>
 #include <stdexcept>
 #include <sstream>
 
 // Third party:
 // - Bayeux/datatools:
+#include <datatools/io_factory.h>
+#include <datatools/multi_properties.h>
 #include <datatools/service_manager.h>
+#include <datatools/utils.h>
 // - Bayeux/cuts:
 #include <cuts/cut_service.h>
 #include <cuts/cut_manager.h>
+#include <cuts/i_cut.h>
 
 // This project:
 #include <falaise/snemo/datamodels/data_model.h>
 #include <falaise/snemo/datamodels/particle_track_data.h>
 #include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/processing/services.h>
 
 #include <snemo/reconstruction/particle_identification_driver.h>
 #include <snemo/reconstruction/topology_driver.h>
+#include <snemo/reconstruction/topology_cache.h>
+#include <snemo/reconstruction/classification_index.h>
+#include <snemo/reconstruction/selection_bitmap.h>
 
 namespace snemo {
 
@@ -38,8 +47,42 @@ namespace snemo {
       std::string outputBank;  //!< The label of the output data bank
       snemo::reconstruction::particle_identification_driver pidDriver; //! pid driver instance
       snemo::reconstruction::topology_driver topoDriver; //! topology driver instance
+      snemo::reconstruction::topology_cache cache; //! optional on-disk cache of results
+      snemo::reconstruction::classification_index_writer index; //! optional classification index
+      std::vector<cuts::i_cut *> indexCuts; //! channel cuts recorded in the index
+      snemo::reconstruction::selection_bitmap_set selections; //! optional selection bitmaps
+      std::string selectionsFile; //! file of the selection bitmaps
+      std::vector<std::pair<std::string, cuts::i_cut *> > selectionCuts; //! cuts recorded in the selection bitmaps, with their measurement label (empty for record cuts)
+      uint64_t recordNumber; //! number of the current record
+      datatools::service_manager * services; //! service manager providing the cut service
+      std::string cutLabel; //! label of the cut service
+      cuts::cut_service * cutService; //! cut service, once fetched
+      std::unique_ptr<datatools::data_writer> capture; //! optional capture of the inputs for replay
+
+      /// Fetch the cut service on first use
+      cuts::cut_service & grabCutService();
+
+      /// Give the pid driver its cut manager on first use
+      particle_identification_driver & grabPidDriver();
     };
 
+    cuts::cut_service & topology_module::TopologyModuleImpl::grabCutService()
+    {
+      if (cutService == 0) {
+        // Services may be initialized on request: only do so when first needed
+        cutService = &services->grab<cuts::cut_service>(cutLabel);
+      }
+      return *cutService;
+    }
+
+    particle_identification_driver & topology_module::TopologyModuleImpl::grabPidDriver()
+    {
+      if (! pidDriver.has_cut_manager()) {
+        pidDriver.set_cut_manager(grabCutService().grab_cut_manager());
+      }
+      return pidDriver;
+    }
+
     // Constructor :
     topology_module::topology_module(datatools::logger::priority p)
     : dpp::base_module(p), tpmImpl_(new TopologyModuleImpl)
@@ -61,6 +104,17 @@ namespace snemo {
       tpmImpl_->outputBank = "TD";//snemo::datamodel::data_info::default_topology_data_label();
       tpmImpl_->pidDriver.reset();
       tpmImpl_->topoDriver.reset();
+      if (tpmImpl_->cache.is_initialized()) tpmImpl_->cache.reset();
+      if (tpmImpl_->index.is_open()) tpmImpl_->index.close();
+      tpmImpl_->indexCuts.clear();
+      tpmImpl_->selections.clear();
+      tpmImpl_->selectionsFile.clear();
+      tpmImpl_->selectionCuts.clear();
+      tpmImpl_->recordNumber = 0;
+      tpmImpl_->services = 0;
+      tpmImpl_->cutLabel.clear();
+      tpmImpl_->cutService = 0;
+      tpmImpl_->capture.reset();
     }
 
     // Initialization :
@@ -93,15 +147,101 @@ namespace snemo {
                   ! service_manager_.is_a<cuts::cut_service>(cut_label),
                   std::logic_error,
                   "Module '" << get_name() << "' has no '" << cut_label << "' service !");
-      auto Cut = service_manager_.grab<cuts::cut_service>(cut_label);
+      tpmImpl_->services = &service_manager_;
+      tpmImpl_->cutLabel = cut_label;
 
-      // Drivers
-      tpmImpl_->pidDriver.set_cut_manager(Cut.grab_cut_manager());
+      // Drivers: their configuration is checked now, but the cut service is
+      // only fetched with the first event, unless the cache, the index, the
+      // selections or the capture need it now
       datatools::properties PID_config;
       setup_.export_and_rename_starting_with(PID_config, particle_identification_driver::get_id() + ".", "");
       tpmImpl_->pidDriver.initialize(PID_config);
       tpmImpl_->topoDriver.initialize(setup_);
 
+      // Result cache :
+      datatools::properties cache_config;
+      setup_.export_and_rename_starting_with(cache_config, "cache.", "");
+      if (cache_config.has_key("directory")) {
+        // The effective configuration is the module setup, apart from the
+        // cache settings, and the definitions of all the available cuts
+        auto& Cut = tpmImpl_->grabCutService();
+        std::ostringstream configuration;
+        datatools::properties module_config;
+        setup_.export_not_starting_with(module_config, "cache.");
+        module_config.tree_dump(configuration);
+        for (const auto& a_cut : Cut.get_cut_manager().get_cuts()) {
+          configuration << a_cut.first << " " << a_cut.second.get_cut_id() << std::endl;
+          a_cut.second.get_cut_config().tree_dump(configuration);
+        }
+        tpmImpl_->cache.initialize(cache_config, topology_cache::hash(configuration.str()));
+      }
+
+      // Classification index :
+      if (setup_.has_key("index.filename")) {
+        std::string index_filename = setup_.fetch_path("index.filename");
+        datatools::fetch_path_with_env(index_filename);
+        std::vector<std::string> index_cuts;
+        if (setup_.has_key("index.channel_cuts")) {
+          setup_.fetch("index.channel_cuts", index_cuts);
+        }
+        for (const auto& a_cut_name : index_cuts) {
+          auto& Cut = tpmImpl_->grabCutService();
+          DT_THROW_IF(! Cut.get_cut_manager().has(a_cut_name), std::logic_error,
+                      "Module '" << get_name() << "' has no '" << a_cut_name << "' cut !");
+          tpmImpl_->indexCuts.push_back(&Cut.grab_cut_manager().grab(a_cut_name));
+        }
+        tpmImpl_->index.open(index_filename, index_cuts);
+      }
+
+      // Selection bitmaps :
+      if (setup_.has_key("selections.filename")) {
+        std::string selections_filename = setup_.fetch_path("selections.filename");
+        datatools::fetch_path_with_env(selections_filename);
+        std::vector<std::string> selection_names;
+        if (setup_.has_key("selections.cuts")) {
+          setup_.fetch("selections.cuts", selection_names);
+        }
+        for (const auto& a_name : selection_names) {
+          DT_THROW_IF(! setup_.has_key("selections." + a_name + ".cut_label"), std::logic_error,
+                      "Module '" << get_name() << "' has no cut label for the '" << a_name << "' selection !");
+          const std::string a_cut_name = setup_.fetch_string("selections." + a_name + ".cut_label");
+          std::string a_meas_label;
+          if (setup_.has_key("selections." + a_name + ".measurement_label")) {
+            a_meas_label = setup_.fetch_string("selections." + a_name + ".measurement_label");
+          }
+          auto& Cut = tpmImpl_->grabCutService();
+          DT_THROW_IF(! Cut.get_cut_manager().has(a_cut_name), std::logic_error,
+                      "Module '" << get_name() << "' has no '" << a_cut_name << "' cut !");
+          tpmImpl_->selectionCuts.push_back(std::make_pair(a_meas_label, &Cut.grab_cut_manager().grab(a_cut_name)));
+        }
+        tpmImpl_->selections.set_names(selection_names);
+        tpmImpl_->selectionsFile = selections_filename;
+      }
+
+      // Input capture :
+      if (setup_.has_key("capture.filename")) {
+        std::string capture_filename = setup_.fetch_path("capture.filename");
+        datatools::fetch_path_with_env(capture_filename);
+        // The drivers configuration and the cut definitions make the
+        // capture self-contained, followed by the input of every record
+        datatools::properties drivers_config;
+        datatools::properties no_capture_config;
+        datatools::properties no_cache_config;
+        setup_.export_not_starting_with(no_capture_config, "capture.");
+        no_capture_config.export_not_starting_with(no_cache_config, "cache.");
+        datatools::properties no_index_config;
+        no_cache_config.export_not_starting_with(no_index_config, "index.");
+        no_index_config.export_not_starting_with(drivers_config, "selections.");
+        datatools::multi_properties cuts_config("name", "type");
+        auto& Cut = tpmImpl_->grabCutService();
+        for (const auto& a_cut : Cut.get_cut_manager().get_cuts()) {
+          cuts_config.add(a_cut.first, a_cut.second.get_cut_id(), a_cut.second.get_cut_config());
+        }
+        tpmImpl_->capture.reset(new datatools::data_writer(capture_filename, datatools::using_multiple_archives));
+        tpmImpl_->capture->store(drivers_config);
+        tpmImpl_->capture->store(cuts_config);
+      }
+
       _set_initialized(true);
     }
 
@@ -109,6 +249,17 @@ namespace snemo {
     {
       DT_THROW_IF (! is_initialized(), std::logic_error,
                    "Module '" << get_name() << "' is not initialized !");
+      // Selection bitmaps of the processed records, a failure being reported
+      // without preventing the module reset
+      if (! tpmImpl_->selectionsFile.empty()) {
+        try {
+          tpmImpl_->selections.set_number_of_records(tpmImpl_->recordNumber);
+          tpmImpl_->selections.store(tpmImpl_->selectionsFile);
+        } catch (std::exception & error) {
+          DT_LOG_ERROR(get_logging_priority(), "Module '" << get_name() << "' cannot store the selections in '"
+                       << tpmImpl_->selectionsFile << "': " << error.what());
+        }
+      }
       _set_initialized(false);
       _set_defaults();
     }
@@ -128,20 +279,84 @@ namespace snemo {
 
 
       // Grab the 'particle_track_data' entry from the data model :
-      auto particleTrackData = data_record_.grab<snemo::datamodel::particle_track_data>(tpmImpl_->inputBank);
-
-      // Prepare process by running the PID driver
-      tpmImpl_->pidDriver.process(particleTrackData);
+      auto& particleTrackData = data_record_.grab<snemo::datamodel::particle_track_data>(tpmImpl_->inputBank);
 
       // Prepare output bank
       if (!data_record_.has(tpmImpl_->outputBank)) {
         data_record_.add<snemo::datamodel::topology_data>(tpmImpl_->outputBank);
       }
-      auto topologyData = data_record_.grab<snemo::datamodel::topology_data>(tpmImpl_->outputBank);
+      auto& topologyData = data_record_.grab<snemo::datamodel::topology_data>(tpmImpl_->outputBank);
       topologyData.reset();
 
-      // Main processing method via the topology driver
-      tpmImpl_->topoDriver.process(particleTrackData, topologyData);
+      // Capture the input as seen by the drivers
+      if (tpmImpl_->capture) {
+        tpmImpl_->capture->store(particleTrackData);
+      }
+
+      // Reuse results computed by a previous job with the same configuration
+      std::string cacheKey;
+      bool cached = false;
+      if (tpmImpl_->cache.is_initialized()) {
+        cacheKey = tpmImpl_->cache.make_key(particleTrackData);
+        cached = tpmImpl_->cache.load(cacheKey, particleTrackData, topologyData);
+      }
+
+      if (! cached) {
+        // Prepare process by running the PID driver. Both drivers run back to
+        // back: dpp expects the topology data to be complete when process()
+        // returns, so the PID of the next record cannot overlap this one
+        tpmImpl_->grabPidDriver().process(particleTrackData);
+
+        // Main processing method via the topology driver
+        tpmImpl_->topoDriver.process(particleTrackData, topologyData);
+
+        if (tpmImpl_->cache.is_initialized()) {
+          tpmImpl_->cache.store(cacheKey, particleTrackData, topologyData);
+        }
+      }
+
+      if (tpmImpl_->index.is_open()) {
+        classification_index_entry an_entry;
+        an_entry.record = tpmImpl_->recordNumber;
+        an_entry.classification = 0;
+        an_entry.channels = 0;
+        const std::string & classification_key = snemo::datamodel::pid_utils::classification_label_key();
+        if (topologyData.get_auxiliaries().has_key(classification_key)) {
+          an_entry.classification = pack_classification(topologyData.get_auxiliaries().fetch_string(classification_key));
+        }
+        for (size_t i = 0; i < tpmImpl_->indexCuts.size(); i++) {
+          cuts::i_cut & a_cut = *tpmImpl_->indexCuts[i];
+          a_cut.set_user_data(data_record_);
+          if (a_cut.process() == cuts::SELECTION_ACCEPTED) an_entry.channels |= uint32_t(1) << i;
+          a_cut.reset_user_data();
+        }
+        tpmImpl_->index.append(an_entry);
+      }
+
+      // Measurement cuts only see the topology pattern, record cuts the
+      // whole record: results shared with the channel cuts are memoized
+      const snemo::datamodel::topology_data & TD = topologyData;
+      for (size_t i = 0; i < tpmImpl_->selectionCuts.size(); i++) {
+        const std::string & a_meas_label = tpmImpl_->selectionCuts[i].first;
+        cuts::i_cut & a_cut = *tpmImpl_->selectionCuts[i].second;
+        int status = cuts::SELECTION_INAPPLICABLE;
+        if (a_meas_label.empty()) {
+          a_cut.set_user_data(data_record_);
+          status = a_cut.process();
+          a_cut.reset_user_data();
+        } else if (TD.has_pattern()) {
+          // The label is a measurement name, not a regular expression
+          const auto * a_measurement = TD.get_pattern().find_measurement(a_meas_label);
+          if (a_measurement != nullptr && ! TD.find_cut_result(&a_cut, a_measurement, status)) {
+            a_cut.set_user_data(*a_measurement);
+            status = a_cut.process();
+            a_cut.reset_user_data();
+            TD.store_cut_result(&a_cut, a_measurement, status);
+          }
+        }
+        tpmImpl_->selections.add(tpmImpl_->recordNumber, i, status);
+      }
+      tpmImpl_->recordNumber++;
 
       return dpp::base_module::PROCESS_SUCCESS;
     }
@@ -159,7 +374,13 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::topology_module, ocd_)
   ocd_.set_class_library("Falaise_ParticleIdentification");
   ocd_.set_class_documentation("This module uses the ``snemo::datamodel::particle_track_data`` bank               \n"
                                "and, given the particles identified, computes relevant topology quantities before \n"
-                               "storing them in ``snemo::datamodel::topology_data.``                              \n");
+                               "storing them in ``snemo::datamodel::topology_data.``                              \n"
+                               "                                                                                  \n"
+                               "The particle identification and the topology of a record run one after the other \n"
+                               "on the calling thread: dpp hands the module one record at a time and writes it   \n"
+                               "once processed, so the pipelined mode of ``topology_pipeline`` is not available   \n"
+                               "here and production runs gain nothing from it. It only serves programs owning     \n"
+                               "the whole event stream, such as ``flpid_replay_topology --pipeline``.              \n");
 
   dpp::base_module::common_ocd(ocd_);
 
@@ -213,6 +434,171 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::reconstruction::topology_module, ocd_)
                    );
   }
 
+  {
+    // Description of the 'cache.directory' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("cache.directory")
+      .set_terse_description("Directory of the on-disk cache of topology results")
+      .set_traits(datatools::TYPE_STRING)
+      .set_path(true)
+      .set_mandatory(false)
+      .set_long_description("When set, the PID labels and the topology data of each event \n"
+                            "are stored and reused for input particle track data with the  \n"
+                            "same charges, vertices, calorimeter hits and trajectories,    \n"
+                            "processed with the same configuration. Entries are grouped by \n"
+                            "configuration hash, so a configuration change (module setup    \n"
+                            "or cut definitions) never reuses older results. The least      \n"
+                            "recently used entries are removed beyond the size limits.      \n")
+      .add_example("Cache results in the job area::                             \n"
+                   "                                                           \n"
+                   "  cache.directory : string as path = \"/tmp/${USER}/td_cache\" \n"
+                   "                                                           \n"
+                   );
+  }
+
+  {
+    // Description of the 'cache.max_entries' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("cache.max_entries")
+      .set_terse_description("Maximum number of entries in the cache")
+      .set_traits(datatools::TYPE_INTEGER)
+      .set_mandatory(false)
+      .set_long_description("The least recently used entries are removed once the \n"
+                            "limit is reached. Zero means no limit.                \n")
+      .set_default_value_integer(0)
+      .add_example("Limit the number of entries::        \n"
+                   "                                     \n"
+                   "  cache.max_entries : integer = 1000000 \n"
+                   "                                     \n"
+                   );
+  }
+
+  {
+    // Description of the 'cache.max_size' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("cache.max_size")
+      .set_terse_description("Maximum size of the cache in megabytes")
+      .set_traits(datatools::TYPE_INTEGER)
+      .set_mandatory(false)
+      .set_long_description("The least recently used entries are removed once the \n"
+                            "limit is reached. Zero means no limit.                \n")
+      .set_default_value_integer(1024)
+      .add_example("Limit the cache to 2 GB::          \n"
+                   "                                   \n"
+                   "  cache.max_size : integer = 2048  \n"
+                   "                                   \n"
+                   );
+  }
+
+  {
+    // Description of the 'index.filename' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("index.filename")
+      .set_terse_description("Sidecar classification index file")
+      .set_traits(datatools::TYPE_STRING)
+      .set_path(true)
+      .set_mandatory(false)
+      .set_long_description("When set, one fixed size entry is written per processed record \n"
+                            "with its record number, its packed classification and the      \n"
+                            "outcomes of the 'index.channel_cuts'. Record numbers count the   \n"
+                            "records seen by the module, so the index matches the data file  \n"
+                            "written right after it, before any event filtering.             \n")
+      .add_example("Index the processed records::                            \n"
+                   "                                                         \n"
+                   "  index.filename : string as path = \"/tmp/${USER}/run.idx\" \n"
+                   "                                                         \n"
+                   );
+  }
+
+  {
+    // Description of the 'index.channel_cuts' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("index.channel_cuts")
+      .set_terse_description("Channel cuts whose outcomes are stored in the classification index")
+      .set_traits(datatools::TYPE_STRING,
+                  datatools::configuration_property_description::ARRAY)
+      .set_mandatory(false)
+      .set_long_description("At most 32 cuts, evaluated on the full event record once the \n"
+                            "topology data has been built.                                 \n")
+      .add_example("Record the 2e channels::                                           \n"
+                   "                                                                   \n"
+                   "  index.channel_cuts : string[2] = \"2e::channel_cut\" \"2e1g::channel_cut\" \n"
+                   "                                                                   \n"
+                   );
+  }
+
+  {
+    // Description of the 'selections.filename' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("selections.filename")
+      .set_terse_description("Sidecar file of the selection bitmaps")
+      .set_traits(datatools::TYPE_STRING)
+      .set_path(true)
+      .set_mandatory(false)
+      .set_long_description("When set, the decisions of the 'selections.cuts' are recorded in \n"
+                            "compressed bitmaps of record numbers, written to this file when  \n"
+                            "the module is reset. The 'flpid_select' program combines them    \n"
+                            "with AND/OR/NOT queries without reading the events again. Record \n"
+                            "numbers are counted as for the classification index.            \n")
+      .add_example("Record the selections of the processed records::                \n"
+                   "                                                                \n"
+                   "  selections.filename : string as path = \"/tmp/${USER}/run.sel\" \n"
+                   "                                                                \n"
+                   );
+  }
+
+  {
+    // Description of the 'selections.cuts' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("selections.cuts")
+      .set_terse_description("Names of the selections recorded in the selection bitmaps")
+      .set_traits(datatools::TYPE_STRING,
+                  datatools::configuration_property_description::ARRAY)
+      .set_mandatory(false)
+      .set_long_description("Each selection records the accepted and rejected records of the \n"
+                            "cut given by 'selections.${name}.cut_label'. The cut is applied  \n"
+                            "to the 'selections.${name}.measurement_label' measurement of the \n"
+                            "topology pattern if set, and to the whole event record otherwise,\n"
+                            "as for channel cuts. Results of measurement cuts are shared with \n"
+                            "the channel cuts of the same event, so such a cut is processed,  \n"
+                            "and counted by the cut manager, once per event and measurement.  \n")
+      .add_example("Record a channel and an energy cut::                                   \n"
+                   "                                                                       \n"
+                   "  selections.cuts : string[2] = \"2e\" \"e1_energy\"                    \n"
+                   "  selections.2e.cut_label : string = \"2e::channel_cut\"                \n"
+                   "  selections.e1_energy.cut_label : string = \"energy_cut\"              \n"
+                   "  selections.e1_energy.measurement_label : string = \"energy_e1\"       \n"
+                   "                                                                       \n"
+                   );
+  }
+
+  {
+    // Description of the 'capture.filename' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("capture.filename")
+      .set_terse_description("File capturing the module inputs for a standalone replay")
+      .set_traits(datatools::TYPE_STRING)
+      .set_path(true)
+      .set_mandatory(false)
+      .set_long_description("When set, the module configuration, the definitions of the      \n"
+                            "available cuts and the input 'particle track data' of every     \n"
+                            "record are written to this file. The 'flpid_replay_topology'    \n"
+                            "program runs them through the drivers outside of any pipeline. \n")
+      .add_example("Capture the processed records::                               \n"
+                   "                                                              \n"
+                   "  capture.filename : string as path = \"/tmp/${USER}/pid.data\" \n"
+                   "                                                              \n"
+                   );
+  }
+
   // Invoke specific OCD support from the driver class:
   ::snemo::reconstruction::topology_driver::init_ocd(ocd_);
 
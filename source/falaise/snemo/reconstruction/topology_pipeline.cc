@@ -0,0 +1,140 @@
+/// \file falaise/snemo/reconstruction/topology_pipeline.cc
+
+// Ourselves:
+#include <snemo/reconstruction/topology_pipeline.h>
+
+// Standard library:
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <thread>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <snemo/reconstruction/particle_identification_driver.h>
+#include <snemo/reconstruction/topology_driver.h>
+#include <snemo/reconstruction/spsc_queue.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    topology_pipeline::statistics::statistics()
+    {
+      events = 0;
+      pid_waits = 0;
+      topology_waits = 0;
+      pid_seconds = 0;
+      topology_seconds = 0;
+      wall_seconds = 0;
+    }
+
+    void topology_pipeline::statistics::print(std::ostream & out_, const std::string & indent_) const
+    {
+      out_ << indent_ << "Events          : " << events << std::endl;
+      out_ << indent_ << "Time            : " << wall_seconds << " s" << std::endl;
+      out_ << indent_ << "Rate            : " << (wall_seconds > 0 ? events / wall_seconds : 0) << " events/s" << std::endl;
+      out_ << indent_ << "PID stage       : " << pid_seconds << " s busy ("
+           << (wall_seconds > 0 ? 100 * pid_seconds / wall_seconds : 0) << " %), "
+           << pid_waits << " events waited for a free slot" << std::endl;
+      out_ << indent_ << "Topology stage  : " << topology_seconds << " s busy ("
+           << (wall_seconds > 0 ? 100 * topology_seconds / wall_seconds : 0) << " %), "
+           << topology_waits << " events waited for" << std::endl;
+    }
+
+    topology_pipeline::topology_pipeline()
+    {
+      _capacity_ = 64;
+    }
+
+    void topology_pipeline::set_capacity(size_t capacity_)
+    {
+      DT_THROW_IF(capacity_ == 0, std::domain_error, "Invalid pipeline capacity !");
+      _capacity_ = capacity_;
+    }
+
+    size_t topology_pipeline::get_capacity() const
+    {
+      return _capacity_;
+    }
+
+    const topology_pipeline::statistics & topology_pipeline::get_statistics() const
+    {
+      return _statistics_;
+    }
+
+    void topology_pipeline::clear_statistics()
+    {
+      _statistics_ = statistics();
+    }
+
+    void topology_pipeline::process(particle_identification_driver & pid_,
+                                    topology_driver & topology_,
+                                    const std::vector<snemo::datamodel::particle_track_data *> & ptds_,
+                                    const std::vector<snemo::datamodel::topology_data *> & tds_,
+                                    const done_function_type & done_)
+    {
+      DT_THROW_IF(ptds_.size() != tds_.size(), std::logic_error,
+                  "Batch of " << ptds_.size() << " events has " << tds_.size() << " topology data !");
+      const size_t nevents = ptds_.size();
+      const size_t end_of_batch = std::numeric_limits<size_t>::max();
+      spsc_queue<size_t> queue(_capacity_);
+      std::vector<std::exception_ptr> errors(nevents);
+
+      // Topology stage : events come in order, the end of the batch last
+      size_t topology_waits = 0;
+      double topology_seconds = 0;
+      auto topology_stage = [&] ()
+        {
+          for (;;) {
+            size_t i = end_of_batch;
+            if (queue.pop(i)) topology_waits++;
+            if (i == end_of_batch) break;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try {
+              topology_.process(*ptds_[i], *tds_[i]);
+              if (done_) done_(i);
+            } catch (...) {
+              errors[i] = std::current_exception();
+            }
+            topology_seconds
+              += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+          }
+        };
+
+      // PID stage, stopping at its first failure as the serial processing would
+      const std::chrono::steady_clock::time_point batch_start = std::chrono::steady_clock::now();
+      std::thread topology_thread(topology_stage);
+      for (size_t i = 0; i < nevents; i++) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        try {
+          pid_.process(*ptds_[i]);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+        _statistics_.pid_seconds
+          += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (errors[i]) break;
+        if (queue.push(i)) _statistics_.pid_waits++;
+        _statistics_.events++;
+      }
+      queue.push(end_of_batch);
+      topology_thread.join();
+      _statistics_.wall_seconds
+        += std::chrono::duration<double>(std::chrono::steady_clock::now() - batch_start).count();
+      _statistics_.topology_waits += topology_waits;
+      _statistics_.topology_seconds += topology_seconds;
+
+      for (size_t i = 0; i < nevents; i++) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+      }
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
@@ -0,0 +1,111 @@
+/** \file falaise/snemo/reconstruction/topology_pipeline.h
+ *
+ * Description:
+ *
+ *   A two-stage pipeline over a stream of events: the particle
+ *   identification of an event runs on the calling thread while the
+ *   topology of the previous events is built on another thread, records
+ *   being handed off in order through a bounded lock-free queue.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_PIPELINE_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_PIPELINE_H 1
+
+// Standard library:
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace snemo {
+
+  namespace datamodel {
+    class particle_track_data;
+    class topology_data;
+  }
+
+  namespace reconstruction {
+
+    class particle_identification_driver;
+    class topology_driver;
+
+    /// \brief Pipelined particle identification and topology processing
+    ///
+    /// The PID driver drives shared cut objects and stays on the calling
+    /// thread; the topology driver runs on a single stage thread, so both
+    /// drivers keep seeing the events one at a time and in order. A full
+    /// queue holds the PID stage back, bounding the events in flight.
+    ///
+    /// The pipeline needs the whole batch of events up front. The topology
+    /// module is not pipelined: dpp hands it one record at a time and
+    /// expects the record to be complete when the module returns, so dpp
+    /// production runs gain nothing from this class. It serves programs
+    /// owning the event stream, such as flpid_replay_topology.
+    class topology_pipeline
+    {
+    public:
+
+      /// Activity of the stages over the processed batches
+      struct statistics {
+        statistics();
+        size_t events;           //!< Number of processed events
+        size_t pid_waits;        //!< Number of events the PID stage waited for a free slot
+        size_t topology_waits;   //!< Number of events the topology stage waited for
+        double pid_seconds;      //!< Time spent in the PID driver
+        double topology_seconds; //!< Time spent in the topology driver
+        double wall_seconds;     //!< Duration of the batches
+        /// Print the statistics
+        void print(std::ostream & out_ = std::clog, const std::string & indent_ = "") const;
+      };
+
+      /// Typedef of the function called, on the topology stage and in order, for every processed event
+      typedef std::function<void(size_t)> done_function_type;
+
+      /// Constructor
+      topology_pipeline();
+
+      /// Set the maximal number of events handed off to the topology stage
+      void set_capacity(size_t capacity_);
+
+      /// Return the maximal number of events handed off to the topology stage
+      size_t get_capacity() const;
+
+      /// Process a batch of events
+      ///
+      /// The optional function is called once the topology of an event is
+      /// built, in the event order. The first failure, in the event order,
+      /// is rethrown once the topology stage is done.
+      void process(particle_identification_driver & pid_,
+                   topology_driver & topology_,
+                   const std::vector<snemo::datamodel::particle_track_data *> & ptds_,
+                   const std::vector<snemo::datamodel::topology_data *> & tds_,
+                   const done_function_type & done_ = done_function_type());
+
+      /// Return the activity of the stages
+      const statistics & get_statistics() const;
+
+      /// Clear the activity of the stages
+      void clear_statistics();
+
+    private:
+
+      size_t _capacity_;        //!< Maximal number of events handed off to the topology stage
+      statistics _statistics_;  //!< Activity of the stages
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_PIPELINE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,249 @@
+/// \file falaise/snemo/reconstruction/topology_scheduler.cc
+
+// Ourselves:
+#include <snemo/reconstruction/topology_scheduler.h>
+
+// Standard library:
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <snemo/reconstruction/topology_driver.h>
+#include <snemo/reconstruction/task_pool.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+
+      /// Queue of the tasks of a worker, heaviest first
+      struct worker_queue {
+        worker_queue() : size(0), remaining_cost(0) {}
+        std::mutex mutex;                   //!< Guard of the tasks
+        std::deque<size_t> tasks;           //!< Tasks, heaviest first
+        std::atomic<size_t> size;           //!< Number of tasks, readable without the guard
+        std::atomic<double> remaining_cost; //!< Estimated cost of the tasks, readable without the guard
+      };
+
+      /// Take a task from one end of a queue
+      bool take(worker_queue & queue_, const std::vector<double> & costs_, bool heaviest_, size_t & task_)
+      {
+        std::lock_guard<std::mutex> lock(queue_.mutex);
+        if (queue_.tasks.empty()) return false;
+        if (heaviest_) {
+          task_ = queue_.tasks.front();
+          queue_.tasks.pop_front();
+        } else {
+          task_ = queue_.tasks.back();
+          queue_.tasks.pop_back();
+        }
+        queue_.size.store(queue_.tasks.size());
+        queue_.remaining_cost.store(queue_.remaining_cost.load() - costs_[task_]);
+        return true;
+      }
+
+    }
+
+    topology_scheduler::worker_report::worker_report()
+    {
+      events = 0;
+      stolen = 0;
+      estimated_cost = 0;
+      busy_seconds = 0;
+      wall_seconds = 0;
+    }
+
+    double topology_scheduler::worker_report::get_utilization() const
+    {
+      return wall_seconds > 0 ? busy_seconds / wall_seconds : 0;
+    }
+
+    // static
+    double topology_scheduler::estimate_cost(const snemo::datamodel::particle_track_data & ptd_)
+    {
+      const datatools::properties & aux = ptd_.get_auxiliaries();
+      const std::string * labels[] = {
+        &snemo::datamodel::pid_utils::electron_label(),
+        &snemo::datamodel::pid_utils::positron_label(),
+        &snemo::datamodel::pid_utils::gamma_label(),
+        &snemo::datamodel::pid_utils::alpha_label(),
+        &snemo::datamodel::pid_utils::undefined_label()
+      };
+      double n = 0;
+      for (const std::string * a_label : labels) {
+        if (aux.has_key(*a_label)) n += aux.fetch_integer(*a_label);
+      }
+      return 1 + n + 3 * n * (n - 1) / 2;
+    }
+
+    topology_scheduler::topology_scheduler()
+    {
+      _number_of_workers_ = 0;
+    }
+
+    void topology_scheduler::set_number_of_workers(size_t nworkers_)
+    {
+      _number_of_workers_ = nworkers_;
+    }
+
+    size_t topology_scheduler::get_number_of_workers() const
+    {
+      return _number_of_workers_;
+    }
+
+    const std::vector<topology_scheduler::worker_report> & topology_scheduler::get_reports() const
+    {
+      return _reports_;
+    }
+
+    void topology_scheduler::clear_reports()
+    {
+      _reports_.clear();
+    }
+
+    void topology_scheduler::run(const std::vector<double> & costs_, const std::function<void(size_t)> & task_)
+    {
+      const size_t ntasks = costs_.size();
+      size_t nworkers = _number_of_workers_;
+      if (nworkers == 0) nworkers = std::max(1u, std::thread::hardware_concurrency());
+      nworkers = std::max<size_t>(1, std::min(nworkers, ntasks));
+      if (_reports_.size() < nworkers) _reports_.resize(nworkers);
+
+      // Deal the tasks heaviest first, each to the least loaded worker:
+      // queues stay sorted from the heaviest to the lightest task
+      std::vector<size_t> order(ntasks);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&costs_](size_t a_, size_t b_) { return costs_[a_] > costs_[b_]; });
+      std::unique_ptr<worker_queue[]> queues(new worker_queue[nworkers]);
+      std::vector<double> loads(nworkers, 0);
+      for (const size_t a_task : order) {
+        const size_t w = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        queues[w].tasks.push_back(a_task);
+        loads[w] += costs_[a_task];
+      }
+      for (size_t w = 0; w < nworkers; w++) {
+        queues[w].size.store(queues[w].tasks.size());
+        queues[w].remaining_cost.store(loads[w]);
+      }
+
+      std::vector<std::exception_ptr> errors(ntasks);
+      auto worker = [&] (size_t w_)
+        {
+          // Events already run in parallel: nested task pools stay serial
+          task_pool::parallel_section a_section;
+          worker_report & a_report = _reports_[w_];
+          for (;;) {
+            size_t a_task = 0;
+            bool stolen = false;
+            if (! take(queues[w_], costs_, true, a_task)) {
+              // Steal the lightest task of the most loaded worker; no task
+              // is ever added, so the batch is over once all queues are empty
+              bool found = false;
+              for (;;) {
+                size_t victim = nworkers;
+                double victim_cost = -1;
+                for (size_t v = 0; v < nworkers; v++) {
+                  if (v == w_ || queues[v].size.load() == 0) continue;
+                  const double a_cost = queues[v].remaining_cost.load();
+                  if (a_cost > victim_cost) {
+                    victim = v;
+                    victim_cost = a_cost;
+                  }
+                }
+                if (victim == nworkers) break;
+                if (take(queues[victim], costs_, false, a_task)) {
+                  found = true;
+                  break;
+                }
+              }
+              if (! found) break;
+              stolen = true;
+            }
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try {
+              task_(a_task);
+            } catch (...) {
+              errors[a_task] = std::current_exception();
+            }
+            a_report.busy_seconds
+              += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            a_report.events++;
+            if (stolen) a_report.stolen++;
+            a_report.estimated_cost += costs_[a_task];
+          }
+        };
+
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      std::vector<std::thread> threads;
+      for (size_t w = 1; w < nworkers; w++) {
+        threads.push_back(std::thread(worker, w));
+      }
+      worker(0);
+      for (auto& a_thread : threads) {
+        a_thread.join();
+      }
+      const double wall_seconds
+        = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      // Only the workers of this batch were available during it
+      for (size_t w = 0; w < nworkers; w++) {
+        _reports_[w].wall_seconds += wall_seconds;
+      }
+
+      // Report the first failure, as the serial processing would have
+      for (size_t i = 0; i < ntasks; i++) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+      }
+    }
+
+    void topology_scheduler::process(topology_driver & driver_,
+                                     const std::vector<const snemo::datamodel::particle_track_data *> & ptds_,
+                                     const std::vector<snemo::datamodel::topology_data *> & tds_)
+    {
+      DT_THROW_IF(ptds_.size() != tds_.size(), std::logic_error,
+                  "Batch of " << ptds_.size() << " events has " << tds_.size() << " topology data !");
+      std::vector<double> costs(ptds_.size());
+      for (size_t i = 0; i < ptds_.size(); i++) {
+        costs[i] = estimate_cost(*ptds_[i]);
+      }
+      run(costs, [&] (size_t i_) { driver_.process(*ptds_[i_], *tds_[i_]); });
+    }
+
+    void topology_scheduler::print_report(std::ostream & out_, const std::string & indent_) const
+    {
+      out_ << indent_ << std::setw(8) << std::left << "Worker"
+           << std::setw(10) << std::right << "Events"
+           << std::setw(10) << "Stolen"
+           << std::setw(16) << "Est. cost"
+           << std::setw(12) << "Busy [s]"
+           << std::setw(16) << "Utilization [%]" << std::endl;
+      for (size_t w = 0; w < _reports_.size(); w++) {
+        const worker_report & a_report = _reports_[w];
+        out_ << indent_ << std::setw(8) << std::left << w
+             << std::setw(10) << std::right << a_report.events
+             << std::setw(10) << a_report.stolen
+             << std::setw(16) << a_report.estimated_cost
+             << std::setw(12) << a_report.busy_seconds
+             << std::setw(16) << 100 * a_report.get_utilization() << std::endl;
+      }
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
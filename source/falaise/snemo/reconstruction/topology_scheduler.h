@@ -0,0 +1,110 @@
+/** \file falaise/snemo/reconstruction/topology_scheduler.h
+ *
+ * Description:
+ *
+ *   A cost-aware, work-stealing scheduler running the topology driver
+ *   over a batch of events with several threads. Event costs are estimated
+ *   from the particle identification counts, which are known once the PID
+ *   driver has run, so that heavy events do not make a worker straggle.
+ *
+ * History:
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_SCHEDULER_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_SCHEDULER_H 1
+
+// Standard library:
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace snemo {
+
+  namespace datamodel {
+    class particle_track_data;
+    class topology_data;
+  }
+
+  namespace reconstruction {
+
+    class topology_driver;
+
+    /// \brief Cost-aware work-stealing scheduler of the topology processing
+    ///
+    /// Events are dealt to the workers heaviest first, each one going to the
+    /// worker with the least estimated work. Every worker processes its own
+    /// queue from the heaviest event on; once empty, it steals the lightest
+    /// event of the worker with the most estimated work left.
+    class topology_scheduler
+    {
+    public:
+
+      /// Activity of a worker over the processed batches
+      struct worker_report {
+        worker_report();
+        size_t events;         //!< Number of processed events
+        size_t stolen;         //!< Number of events stolen from other workers
+        double estimated_cost; //!< Estimated cost of the processed events
+        double busy_seconds;   //!< Time spent processing events
+        double wall_seconds;   //!< Duration of the batches the worker took part in
+        /// Return the fraction of the batches duration spent processing events
+        double get_utilization() const;
+      };
+
+      /// Return the estimated cost of an event from its particle identification counts
+      ///
+      /// Each particle costs one energy measurement and each pair of
+      /// particles the TOF, vertex and angle measurements, on top of a unit
+      /// cost for building the pattern: 2 for '1e', 36 for '2e3g'.
+      static double estimate_cost(const snemo::datamodel::particle_track_data & ptd_);
+
+      /// Constructor
+      topology_scheduler();
+
+      /// Set the number of workers (0 for the hardware concurrency)
+      void set_number_of_workers(size_t nworkers_);
+
+      /// Return the number of workers (0 for the hardware concurrency)
+      size_t get_number_of_workers() const;
+
+      /// Run tasks given their estimated costs
+      ///
+      /// The first failure, in the task order, is rethrown once all the
+      /// workers are done.
+      void run(const std::vector<double> & costs_, const std::function<void(size_t)> & task_);
+
+      /// Process a batch of events with a topology driver, shared by the workers
+      void process(topology_driver & driver_,
+                   const std::vector<const snemo::datamodel::particle_track_data *> & ptds_,
+                   const std::vector<snemo::datamodel::topology_data *> & tds_);
+
+      /// Return the activity of the workers since the reports were cleared
+      const std::vector<worker_report> & get_reports() const;
+
+      /// Clear the activity of the workers
+      void clear_reports();
+
+      /// Print the activity of the workers since the reports were cleared
+      void print_report(std::ostream & out_ = std::clog, const std::string & indent_ = "") const;
+
+    private:
+
+      size_t _number_of_workers_;           //!< Number of workers (0 for the hardware concurrency)
+      std::vector<worker_report> _reports_; //!< Activity of the workers since the reports were cleared
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_SNEMO_RECONSTRUCTION_TOPOLOGY_SCHEDULER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -6,10 +6,17 @@
 // Standard library:
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <set>
 
 // Third party:
 //- GSL:
 #include <gsl/gsl_cdf.h>
+// - Bayeux/datatools:
+#include <bayeux/datatools/object_configuration_description.h>
 // - Bayeux/geomtools:
 #include <bayeux/geomtools/blur_spot.h>
 
@@ -17,6 +24,100 @@
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/particle_track.h>
 #include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/reconstruction/vertex_summary.h>
+
+namespace {
+
+  /// Vertex categories within which a common origin is looked for
+  enum vertex_category_type {
+    VERTEX_CATEGORY_SOURCE_FOIL      = 0,
+    VERTEX_CATEGORY_MAIN_CALORIMETER = 1,
+    VERTEX_CATEGORY_X_CALORIMETER    = 2,
+    VERTEX_CATEGORY_GAMMA_VETO       = 3,
+    VERTEX_CATEGORY_NUMBER           = 4
+  };
+
+  /// Return the category of a vertex from its category bits or -1 if none applies
+  int get_vertex_category(unsigned int bits_)
+  {
+    if (bits_ & snemo::reconstruction::vertex_summary::SOURCE_FOIL) {
+      return VERTEX_CATEGORY_SOURCE_FOIL;
+    }
+    if (bits_ & snemo::reconstruction::vertex_summary::MAIN_CALORIMETER) {
+      return VERTEX_CATEGORY_MAIN_CALORIMETER;
+    }
+    if (bits_ & snemo::reconstruction::vertex_summary::X_CALORIMETER) {
+      return VERTEX_CATEGORY_X_CALORIMETER;
+    }
+    if (bits_ & snemo::reconstruction::vertex_summary::GAMMA_VETO) {
+      return VERTEX_CATEGORY_GAMMA_VETO;
+    }
+    return -1;
+  }
+
+  /// Vertices of a particle track bucketed by category
+  struct vertex_buckets
+  {
+    /// Vertex and its rank within the particle vertex collection
+    typedef std::pair<size_t, const geomtools::blur_spot *> entry_type;
+
+    vertex_buckets(const snemo::datamodel::particle_track & pt_,
+                   const snemo::reconstruction::vertex_summary & vertices_, size_t index_)
+    {
+      for (size_t rank = 0; rank < vertices_.get_number_of_vertices(index_); rank++) {
+        const int category = get_vertex_category(vertices_.get_category(index_, rank));
+        if (category >= 0) buckets[category].push_back(std::make_pair(rank, &pt_.get_vertices()[rank].get()));
+      }
+    }
+
+    std::vector<entry_type> buckets[VERTEX_CATEGORY_NUMBER];
+  };
+
+  /// Squared resolution of a vertex given its blur dimension
+  double get_vertex_sigma(const geomtools::blur_spot & vtx_)
+  {
+    double a_sigma = 0.0;
+    if (vtx_.get_blur_dimension() >= geomtools::blur_spot::DIMENSION_ONE) {
+      a_sigma += std::pow(vtx_.get_x_error(), 2);
+    }
+    if (vtx_.get_blur_dimension() >= geomtools::blur_spot::DIMENSION_TWO) {
+      a_sigma += std::pow(vtx_.get_y_error(), 2);
+    }
+    if (vtx_.get_blur_dimension() >= geomtools::blur_spot::DIMENSION_THREE) {
+      a_sigma += std::pow(vtx_.get_z_error(), 2);
+    }
+    return datatools::is_valid(a_sigma) ? a_sigma : 1.0;
+  }
+
+  /// Fit a common vertex to a set of vertices and return its chi2 probability
+  double fit_common_vertex(const std::vector<const geomtools::blur_spot *> & vertices_,
+                           geomtools::vector_3d & barycenter_)
+  {
+    double sum_weights = 0.0;
+    geomtools::vector_3d sum_positions(0.0, 0.0, 0.0);
+    double sigma2_x = 0.0, sigma2_y = 0.0, sigma2_z = 0.0;
+    for (const auto* a_vertex : vertices_) {
+      const double weight = 1/get_vertex_sigma(*a_vertex);
+      sum_weights += weight;
+      sum_positions += weight * a_vertex->get_position();
+      sigma2_x += std::pow(a_vertex->get_x_error(), 2);
+      sigma2_y += std::pow(a_vertex->get_y_error(), 2);
+      sigma2_z += std::pow(a_vertex->get_z_error(), 2);
+    }
+    barycenter_ = sum_positions / sum_weights;
+
+    double chi2_x = 0.0, chi2_y = 0.0, chi2_z = 0.0;
+    for (const auto* a_vertex : vertices_) {
+      const geomtools::vector_3d & pos = a_vertex->get_position();
+      chi2_x += std::pow(barycenter_.x() - pos.x(), 2);
+      chi2_y += std::pow(barycenter_.y() - pos.y(), 2);
+      chi2_z += std::pow(barycenter_.z() - pos.z(), 2);
+    }
+    const double chi2 = chi2_x/sigma2_x + chi2_y/sigma2_y + chi2_z/sigma2_z;
+    return gsl_cdf_chisq_Q(chi2, vertices_.size() - 1);
+  }
+
+}
 
 namespace snemo {
 
@@ -67,6 +168,8 @@ namespace snemo {
 
       _initialized_ = false;
       _logging_priority_ = datatools::logger::PRIO_WARNING;
+      _clustering_max_distance_ = 20.0 * CLHEP::mm;
+      _clustering_min_probability_ = 1.0 * CLHEP::perCent;
     }
 
     // Initialization :
@@ -80,6 +183,26 @@ namespace snemo {
                   "Invalid logging priority level !");
       set_logging_priority(lp);
 
+      if (setup_.has_key("clustering.max_distance")) {
+        double dmax = setup_.fetch_real("clustering.max_distance");
+        if (! setup_.has_explicit_unit("clustering.max_distance")) {
+          dmax *= CLHEP::mm;
+        }
+        DT_THROW_IF(dmax <= 0.0*CLHEP::mm, std::range_error,
+                    "Invalid maximal vertices distance (" << dmax/CLHEP::mm << " mm) !");
+        _clustering_max_distance_ = dmax;
+      }
+
+      if (setup_.has_key("clustering.min_probability")) {
+        double pmin = setup_.fetch_real("clustering.min_probability");
+        if (! setup_.has_explicit_unit("clustering.min_probability")) {
+          pmin *= CLHEP::perCent;
+        }
+        DT_THROW_IF(pmin < 0.0*CLHEP::perCent || pmin > 100.0*CLHEP::perCent, std::range_error,
+                    "Invalid minimal vertices probability (" << pmin << ") !");
+        _clustering_min_probability_ = pmin;
+      }
+
       _set_initialized(true);
       return;
     }
@@ -93,16 +216,41 @@ namespace snemo {
 
     void vertex_driver::process(const snemo::datamodel::particle_track & pt1_,
                                 const snemo::datamodel::particle_track & pt2_,
-                                snemo::datamodel::vertex_measurement & vertex_)
+                                snemo::datamodel::vertex_measurement & vertex_) const
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      vertex_summary vertices;
+      vertices.fill({&pt1_, &pt2_});
+      this->_process_algo(pt1_, pt2_, vertices, 0, 1, vertex_);
+      return;
+    }
+
+    void vertex_driver::process(const snemo::datamodel::particle_track & pt1_,
+                                const snemo::datamodel::particle_track & pt2_,
+                                const vertex_summary & vertices_,
+                                size_t index1_, size_t index2_,
+                                snemo::datamodel::vertex_measurement & vertex_) const
     {
-      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is already initialized !");
-      this->_process_algo(pt1_, pt2_, vertex_);
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      DT_THROW_IF(index1_ >= vertices_.size() || index2_ >= vertices_.size(), std::range_error,
+                  "Invalid particle indexes '" << index1_ << "' and '" << index2_ << "' !");
+      this->_process_algo(pt1_, pt2_, vertices_, index1_, index2_, vertex_);
+      return;
+    }
+
+    void vertex_driver::process(const std::vector<const snemo::datamodel::particle_track *> & pts_,
+                                std::vector<snemo::datamodel::vertex_measurement> & vertices_) const
+    {
+      DT_THROW_IF(! is_initialized(), std::logic_error, "Driver '" << get_id() << "' is not initialized !");
+      this->_process_clustering(pts_, vertices_);
       return;
     }
 
     void vertex_driver::_process_algo(const snemo::datamodel::particle_track & pt1_,
                                       const snemo::datamodel::particle_track & pt2_,
-                                      snemo::datamodel::vertex_measurement & vertex_)
+                                      const vertex_summary & vertices_,
+                                      size_t index1_, size_t index2_,
+                                      snemo::datamodel::vertex_measurement & vertex_) const
     {
       if (snemo::datamodel::pid_utils::particle_is_gamma(pt1_) ||
           snemo::datamodel::pid_utils::particle_is_gamma(pt2_)) {
@@ -111,111 +259,249 @@ namespace snemo {
         return;
       }
 
-      auto the_vertices_1 = pt1_.get_vertices();
-      auto the_vertices_2 = pt2_.get_vertices();
+      // Vertices are only compared within the same category
+      const vertex_buckets buckets1(pt1_, vertices_, index1_);
+      const vertex_buckets buckets2(pt2_, vertices_, index2_);
+
+      typedef std::pair<size_t, size_t> rank_pair_type;
+      std::vector<std::pair<rank_pair_type, vertex_pair_collection_type::value_type> > candidates;
+      for (size_t icat = 0; icat < VERTEX_CATEGORY_NUMBER; icat++) {
+        for (const auto& ivtx1 : buckets1.buckets[icat]) {
+          for (const auto& ivtx2 : buckets2.buckets[icat]) {
+            candidates.push_back(std::make_pair(std::make_pair(ivtx1.first, ivtx2.first),
+                                                std::make_pair(ivtx1.second, ivtx2.second)));
+          }
+        }
+      }
+      if (candidates.empty()) {
+        //DT_LOG_TRACE(get_logging_priority(), "Vertices do not come from the same origin !");
+        return;
+      }
 
-      for (auto& ivtx1 : the_vertices_1) {
-        for (auto& ivtx2 : the_vertices_2) {
-          auto vtx1 = ivtx1.get();
-          auto vtx2 = ivtx2.get();
+      // Restore the pair ordering of the vertex collections so ties are
+      // resolved as in a plain double loop
+      std::sort(candidates.begin(), candidates.end(),
+                [] (const std::pair<rank_pair_type, vertex_pair_collection_type::value_type> & a_,
+                    const std::pair<rank_pair_type, vertex_pair_collection_type::value_type> & b_) {
+                  return a_.first < b_.first;
+                });
+
+      vertex_pair_collection_type pairs;
+      pairs.reserve(candidates.size());
+      for (const auto& icandidate : candidates) {
+        pairs.push_back(icandidate.second);
+      }
+      _find_common_vertex(pairs, vertex_);
+    }
 
-          auto have_same_origin = [] (const geomtools::blur_spot & vtx1_,
-                                      const geomtools::blur_spot & vtx2_) -> bool
-            {
-              if (snemo::datamodel::particle_track::vertex_is_on_source_foil(vtx1_) &&
-                  snemo::datamodel::particle_track::vertex_is_on_source_foil(vtx2_)) {
-                return true;
-              }
-              if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vtx1_) &&
-                  snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vtx2_)) {
-                return true;
-              }
-              if (snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vtx1_) &&
-                  snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vtx2_)) {
-                return true;
-              }
-              if (snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vtx1_) &&
-                  snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vtx2_)) {
-                return true;
-              }
-              return false;
-            };
+    void vertex_driver::_find_common_vertex(const vertex_pair_collection_type & pairs_,
+                                            snemo::datamodel::vertex_measurement & vertex_) const
 
-          if (! have_same_origin(vtx1, vtx2)) {
-            //DT_LOG_TRACE(get_logging_priority(), "Vertices do not come from the same origin !");
-            continue;
-          }
+    {
+      const size_t npairs = pairs_.size();
+
+      // Gather vertex positions and resolutions in contiguous arrays
+      std::vector<double> x1(npairs), y1(npairs), z1(npairs), s1(npairs);
+      std::vector<double> x2(npairs), y2(npairs), z2(npairs), s2(npairs);
+      std::vector<double> sx2(npairs), sy2(npairs), sz2(npairs);
+      for (size_t i = 0; i < npairs; i++) {
+        const geomtools::blur_spot & vtx1 = *pairs_[i].first;
+        const geomtools::blur_spot & vtx2 = *pairs_[i].second;
+        DT_THROW_IF(vtx1.get_blur_dimension() != vtx2.get_blur_dimension(),
+                    std::logic_error, "Blur dimensions are differents !");
+        const geomtools::vector_3d & pos1 = vtx1.get_position();
+        const geomtools::vector_3d & pos2 = vtx2.get_position();
+        x1[i] = pos1.x(); y1[i] = pos1.y(); z1[i] = pos1.z();
+        x2[i] = pos2.x(); y2[i] = pos2.y(); z2[i] = pos2.z();
+        s1[i] = get_vertex_sigma(vtx1);
+        s2[i] = get_vertex_sigma(vtx2);
+        sx2[i] = vtx1.get_x_error()*vtx1.get_x_error() + vtx2.get_x_error()*vtx2.get_x_error();
+        sy2[i] = vtx1.get_y_error()*vtx1.get_y_error() + vtx2.get_y_error()*vtx2.get_y_error();
+        sz2[i] = vtx1.get_z_error()*vtx1.get_z_error() + vtx2.get_z_error()*vtx2.get_z_error();
+      }
+
+      // Weighted barycenters and chi2 for all the pairs at once
+      std::vector<double> bx(npairs), by(npairs), bz(npairs), chi2(npairs);
+      for (size_t i = 0; i < npairs; i++) {
+        const double w1 = 1/s1[i];
+        const double w2 = 1/s2[i];
+        bx[i] = (x1[i]*w1 + x2[i]*w2)/(w1 + w2);
+        by[i] = (y1[i]*w1 + y2[i]*w2)/(w1 + w2);
+        bz[i] = (z1[i]*w1 + z2[i]*w2)/(w1 + w2);
+        const double chi2_x = ((bx[i]-x1[i])*(bx[i]-x1[i]) + (bx[i]-x2[i])*(bx[i]-x2[i]))/sx2[i];
+        const double chi2_y = ((by[i]-y1[i])*(by[i]-y1[i]) + (by[i]-y2[i])*(by[i]-y2[i]))/sy2[i];
+        const double chi2_z = ((bz[i]-z1[i])*(bz[i]-z1[i]) + (bz[i]-z2[i])*(bz[i]-z2[i]))/sz2[i];
+        chi2[i] = chi2_x + chi2_y + chi2_z;
+      }
 
-          _find_common_vertex(vtx1, vtx2, vertex_);
+      // Keep the most probable pair
+      double best_probability = vertex_.get_probability();
+      size_t best = npairs;
+      for (size_t i = 0; i < npairs; i++) {
+        const double probability = gsl_cdf_chisq_Q(chi2[i], 1);
+        if (! datatools::is_valid(best_probability) || best_probability < probability) {
+          best_probability = probability;
+          best = i;
         }
       }
+      if (best == npairs) return;
+
+      // Update vertex value
+      vertex_.set_probability(best_probability);
+      geomtools::blur_spot & a_spot = vertex_.get_vertex();
+      a_spot.set_blur_dimension(pairs_[best].first->get_blur_dimension());
+      a_spot.set_position(geomtools::vector_3d(bx[best], by[best], bz[best]));
+      // temporary store the vertices distance in the barycenter errors
+      const double dx = std::abs(x1[best]-x2[best]);
+      const double dy = std::abs(y1[best]-y2[best]);
+      const double dz = std::abs(z1[best]-z2[best]);
+      a_spot.set_x_error(datatools::is_valid(dx) ? dx : 0);
+      a_spot.set_y_error(datatools::is_valid(dy) ? dy : 0);
+      a_spot.set_z_error(datatools::is_valid(dz) ? dz : 0);
     }
 
-    void vertex_driver::_find_common_vertex(const geomtools::blur_spot & vtx1_,
-                                            const geomtools::blur_spot & vtx2_,
-                                            snemo::datamodel::vertex_measurement & vertex_)
-
+    void vertex_driver::_process_clustering(const std::vector<const snemo::datamodel::particle_track *> & pts_,
+                                            std::vector<snemo::datamodel::vertex_measurement> & vertices_) const
     {
-      DT_THROW_IF(vtx1_.get_blur_dimension() != vtx2_.get_blur_dimension(),
-                  std::logic_error, "Blur dimensions are differents !");
-
-      auto sigma = [] (const geomtools::blur_spot & vtx_) -> double
+      // Collect the source foil vertices of charged particles
+      vertex_summary the_vertices;
+      the_vertices.fill(pts_);
+      std::vector<const geomtools::blur_spot *> foil_vertices;
+      std::vector<size_t> owners;
+      for (size_t ipt = 0; ipt < pts_.size(); ipt++) {
+        if (! pts_[ipt]) continue;
+        if (snemo::datamodel::pid_utils::particle_is_gamma(*pts_[ipt])) continue;
+        const vertex_buckets buckets(*pts_[ipt], the_vertices, ipt);
+        for (const auto& ivtx : buckets.buckets[VERTEX_CATEGORY_SOURCE_FOIL]) {
+          if (! geomtools::is_valid(ivtx.second->get_position())) continue;
+          foil_vertices.push_back(ivtx.second);
+          owners.push_back(ipt);
+        }
+      }
+      const size_t nvertices = foil_vertices.size();
+      if (nvertices < 2) return;
+
+      // Spatial grid with cells as large as the maximal distance between
+      // clustered vertices: compatible vertices lie in neighbouring cells
+      typedef std::array<long, 3> cell_type;
+      const double cell_size = _clustering_max_distance_;
+      auto cell_of = [cell_size] (const geomtools::vector_3d & pos_) -> cell_type
         {
-          double a_sigma = 0.0;
-          if (vtx_.get_blur_dimension() >= geomtools::blur_spot::DIMENSION_ONE) {
-            a_sigma += std::pow(vtx_.get_x_error(), 2);
-          }
-          if (vtx_.get_blur_dimension() >= geomtools::blur_spot::DIMENSION_TWO) {
-            a_sigma += std::pow(vtx_.get_y_error(), 2);
-          }
-          if (vtx_.get_blur_dimension() >= geomtools::blur_spot::DIMENSION_THREE) {
-            a_sigma += std::pow(vtx_.get_z_error(), 2);
-          }
-          return datatools::is_valid(a_sigma) ? a_sigma : 1.0;
+          cell_type a_cell = {{static_cast<long>(std::floor(pos_.x()/cell_size)),
+                               static_cast<long>(std::floor(pos_.y()/cell_size)),
+                               static_cast<long>(std::floor(pos_.z()/cell_size))}};
+          return a_cell;
         };
+      std::map<cell_type, std::vector<size_t> > grid;
+      for (size_t i = 0; i < nvertices; i++) {
+        grid[cell_of(foil_vertices[i]->get_position())].push_back(i);
+      }
 
-      const double sigma1 = sigma(vtx1_);
-      const double sigma2 = sigma(vtx2_);
-
-      const double sigma1_x = vtx1_.get_x_error();
-      const double sigma1_y = vtx1_.get_y_error();
-      const double sigma1_z = vtx1_.get_z_error();
-      const double sigma2_x = vtx2_.get_x_error();
-      const double sigma2_y = vtx2_.get_y_error();
-      const double sigma2_z = vtx2_.get_z_error();
-
-      const geomtools::vector_3d & pos1 = vtx1_.get_position();
-      const geomtools::vector_3d & pos2 = vtx2_.get_position();
-      const geomtools::vector_3d bary = (pos1/sigma1 + pos2/sigma2)/(1/sigma1 + 1/sigma2);
-
-      const double chi2_x = (std::pow(bary.x()-pos1.x(),2) + std::pow(bary.x()-pos2.x(),2))/(sigma1_x*sigma1_x + sigma2_x*sigma2_x);
-      const double chi2_y = (std::pow(bary.y()-pos1.y(),2) + std::pow(bary.y()-pos2.y(),2))/(sigma1_y*sigma1_y + sigma2_y*sigma2_y);
-      const double chi2_z = (std::pow(bary.z()-pos1.z(),2) + std::pow(bary.z()-pos2.z(),2))/(sigma1_z*sigma1_z + sigma2_z*sigma2_z);
-
-      const double probability = gsl_cdf_chisq_Q(chi2_x+chi2_y+chi2_z, 1);
-
-      if (! vertex_.has_probability() || vertex_.get_probability() < probability) {
-        // Update vertex value
-        vertex_.set_probability(probability);
-        geomtools::blur_spot & a_spot = vertex_.get_vertex();
-        a_spot.set_blur_dimension(vtx1_.get_blur_dimension());
-        a_spot.set_position(bary);
-        // temporary store the vertices distance in the barycenter errors
-        if(datatools::is_valid(std::abs(pos1.x()-pos2.x())))
-          a_spot.set_x_error(std::abs(pos1.x()-pos2.x()));
-        else
-          a_spot.set_x_error(0);
-
-        if(datatools::is_valid(std::abs(pos1.y()-pos2.y())))
-          a_spot.set_y_error(std::abs(pos1.y()-pos2.y()));
-        else
-          a_spot.set_y_error(0);
+      // Compatible pairs of vertices from different tracks
+      typedef std::pair<size_t, size_t> vertex_pair_type;
+      std::set<vertex_pair_type> compatibles;
+      std::vector<std::pair<double, vertex_pair_type> > links;
+      for (size_t i = 0; i < nvertices; i++) {
+        const geomtools::blur_spot & vtx1 = *foil_vertices[i];
+        const cell_type a_cell = cell_of(vtx1.get_position());
+        for (long dx = -1; dx <= 1; dx++) {
+          for (long dy = -1; dy <= 1; dy++) {
+            for (long dz = -1; dz <= 1; dz++) {
+              const cell_type neighbour = {{a_cell[0] + dx, a_cell[1] + dy, a_cell[2] + dz}};
+              const auto found = grid.find(neighbour);
+              if (found == grid.end()) continue;
+              for (const size_t j : found->second) {
+                if (j <= i || owners[j] == owners[i]) continue;
+                const geomtools::blur_spot & vtx2 = *foil_vertices[j];
+                if (vtx1.get_blur_dimension() != vtx2.get_blur_dimension()) continue;
+                const geomtools::vector_3d delta = vtx1.get_position() - vtx2.get_position();
+                if (std::abs(delta.x()) > cell_size ||
+                    std::abs(delta.y()) > cell_size ||
+                    std::abs(delta.z()) > cell_size) continue;
+
+                geomtools::vector_3d barycenter;
+                const double probability = fit_common_vertex({&vtx1, &vtx2}, barycenter);
+                if (! (probability >= _clustering_min_probability_)) continue;
+
+                compatibles.insert(std::make_pair(i, j));
+                links.push_back(std::make_pair(probability, std::make_pair(i, j)));
+              }
+            }
+          }
+        }
+      }
 
-        if(datatools::is_valid(std::abs(pos1.z()-pos2.z())))
-          a_spot.set_z_error(std::abs(pos1.z()-pos2.z()));
-        else
-          a_spot.set_z_error(0);
+      // Group vertices by complete linkage, the most probable pairs first :
+      // two clusters are merged only if every pair of their vertices is
+      // compatible, so that a chain A-B-C does not group A with C when the
+      // A-C pair fails. Clusters are keyed by their lowest vertex index.
+      std::sort(links.begin(), links.end(),
+                [] (const std::pair<double, vertex_pair_type> & a_, const std::pair<double, vertex_pair_type> & b_)
+                {
+                  if (a_.first != b_.first) return a_.first > b_.first;
+                  return a_.second < b_.second;
+                });
+      std::vector<size_t> roots(nvertices);
+      std::iota(roots.begin(), roots.end(), 0);
+      std::map<size_t, std::vector<size_t> > clusters;
+      for (size_t i = 0; i < nvertices; i++) {
+        clusters[i].push_back(i);
+      }
+      for (const auto& a_link : links) {
+        const size_t root1 = roots[a_link.second.first];
+        const size_t root2 = roots[a_link.second.second];
+        if (root1 == root2) continue;
+        bool complete = true;
+        for (const size_t i : clusters[root1]) {
+          for (const size_t j : clusters[root2]) {
+            if (! compatibles.count(std::make_pair(std::min(i, j), std::max(i, j)))) {
+              complete = false;
+              break;
+            }
+          }
+          if (! complete) break;
+        }
+        if (! complete) continue;
+        const size_t root = std::min(root1, root2);
+        const size_t merged = std::max(root1, root2);
+        for (const size_t i : clusters[merged]) {
+          roots[i] = root;
+          clusters[root].push_back(i);
+        }
+        clusters.erase(merged);
+      }
 
+      for (const auto& icluster : clusters) {
+        std::set<size_t> tracks;
+        std::vector<const geomtools::blur_spot *> members;
+        for (const size_t i : icluster.second) {
+          tracks.insert(owners[i]);
+          members.push_back(foil_vertices[i]);
+        }
+        if (tracks.size() < 2) continue;
+
+        snemo::datamodel::vertex_measurement a_measurement;
+        geomtools::vector_3d barycenter;
+        a_measurement.set_probability(fit_common_vertex(members, barycenter));
+        geomtools::blur_spot & a_spot = a_measurement.get_vertex();
+        a_spot.set_blur_dimension(members.front()->get_blur_dimension());
+        a_spot.set_position(barycenter);
+        // As for pairs, store the extent of the clustered vertices in the errors
+        geomtools::vector_3d pmin = members.front()->get_position();
+        geomtools::vector_3d pmax = pmin;
+        for (const auto* a_vertex : members) {
+          const geomtools::vector_3d & pos = a_vertex->get_position();
+          pmin.set(std::min(pmin.x(), pos.x()), std::min(pmin.y(), pos.y()), std::min(pmin.z(), pos.z()));
+          pmax.set(std::max(pmax.x(), pos.x()), std::max(pmax.y(), pos.y()), std::max(pmax.z(), pos.z()));
+        }
+        a_spot.set_x_error(pmax.x() - pmin.x());
+        a_spot.set_y_error(pmax.y() - pmin.y());
+        a_spot.set_z_error(pmax.z() - pmin.z());
+        // Keep track of the particles sharing this vertex
+        std::vector<int> track_indexes(tracks.begin(), tracks.end());
+        a_measurement.grab_auxiliaries().store("tracks", track_indexes,
+                                               "Indexes of the particle tracks sharing the vertex");
+        vertices_.push_back(a_measurement);
       }
     }
 
@@ -224,6 +510,46 @@ namespace snemo {
     {
       // Prefix "VD" stands for "Vertex Driver" :
       datatools::logger::declare_ocd_logging_configuration(ocd_, "fatal", "VD.");
+
+      {
+        // Description of the 'VD.clustering.max_distance' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("VD.clustering.max_distance")
+          .set_terse_description("Maximal distance between vertices grouped into a common vertex")
+          .set_traits(datatools::TYPE_REAL)
+          .set_mandatory(false)
+          .set_explicit_unit(true)
+          .set_unit_label("length")
+          .set_unit_symbol("mm")
+          .set_long_description("Default value is 20 mm. It also sets the cell size of the \n"
+                                "spatial grid used to look for neighbouring vertices.     \n")
+          .add_example("Set the maximal distance along each axis::        \n"
+                       "                                                  \n"
+                       "  VD.clustering.max_distance : real as length = 10 mm \n"
+                       "                                                  \n"
+                       );
+      }
+
+      {
+        // Description of the 'VD.clustering.min_probability' configuration property :
+        datatools::configuration_property_description & cpd
+          = ocd_.add_property_info();
+        cpd.set_name_pattern("VD.clustering.min_probability")
+          .set_terse_description("Minimal common vertex probability for two vertices to be grouped")
+          .set_traits(datatools::TYPE_REAL)
+          .set_mandatory(false)
+          .set_explicit_unit(true)
+          .set_unit_label("fraction")
+          .set_unit_symbol("%")
+          .set_long_description("Default value is 1 %. Every pair of vertices within a \n"
+                                "common vertex must pass this probability.            \n")
+          .add_example("Set the minimal probability::                        \n"
+                       "                                                     \n"
+                       "  VD.clustering.min_probability : real as fraction = 5 % \n"
+                       "                                                     \n"
+                       );
+      }
     }
 
   } // end of namespace reconstruction
@@ -31,6 +31,10 @@
 #ifndef FALAISE_VERTEX_PLUGIN_SNEMO_RECONSTRUCTION_VERTEX_DRIVER_H
 #define FALAISE_VERTEX_PLUGIN_SNEMO_RECONSTRUCTION_VERTEX_DRIVER_H 1
 
+// Standard library:
+#include <utility>
+#include <vector>
+
 // Third party:
 // - Bayeux/datatools:
 #include <bayeux/datatools/logger.h>
@@ -49,6 +53,8 @@ namespace snemo {
 
   namespace reconstruction {
 
+    struct vertex_summary;
+
     /// Driver for the gamma clustering algorithms
     class vertex_driver
     {
@@ -72,7 +78,19 @@ namespace snemo {
       /// Main process
       void process(const snemo::datamodel::particle_track & pt1_,
                    const snemo::datamodel::particle_track & pt2_,
-                   snemo::datamodel::vertex_measurement & vertex_);
+                   snemo::datamodel::vertex_measurement & vertex_) const;
+
+      /// Process two particles given the event vertex summary
+      void process(const snemo::datamodel::particle_track & pt1_,
+                   const snemo::datamodel::particle_track & pt2_,
+                   const vertex_summary & vertices_,
+                   size_t index1_, size_t index2_,
+                   snemo::datamodel::vertex_measurement & vertex_) const;
+
+      /// Cluster the source foil vertices of several particle tracks into
+      /// common vertices, one measurement per cluster
+      void process(const std::vector<const snemo::datamodel::particle_track *> & pts_,
+                   std::vector<snemo::datamodel::vertex_measurement> & vertices_) const;
 
       /// Check if theclusterizer is initialized
       bool is_initialized() const;
@@ -97,16 +115,27 @@ namespace snemo {
       /// Special method to process and determine common vertex between particle tracks
       void _process_algo(const snemo::datamodel::particle_track & pt1_,
                          const snemo::datamodel::particle_track & pt2_,
-                         snemo::datamodel::vertex_measurement & vertex_);
+                         const vertex_summary & vertices_,
+                         size_t index1_, size_t index2_,
+                         snemo::datamodel::vertex_measurement & vertex_) const;
+
+      /// Collection of vertex pairs sharing the same origin
+      typedef std::vector<std::pair<const geomtools::blur_spot *,
+                                    const geomtools::blur_spot *> > vertex_pair_collection_type;
+
+      /// Find the most probable common vertex among pairs of vertices
+      void _find_common_vertex(const vertex_pair_collection_type & pairs_,
+                               snemo::datamodel::vertex_measurement & vertex_) const;
 
-      /// Find the common vertex between two vertices
-      void _find_common_vertex(const geomtools::blur_spot & vtx1_,
-                               const geomtools::blur_spot & vtx2_,
-                               snemo::datamodel::vertex_measurement & vertex_);
+      /// Special method to group the source foil vertices of several particle tracks
+      void _process_clustering(const std::vector<const snemo::datamodel::particle_track *> & pts_,
+                               std::vector<snemo::datamodel::vertex_measurement> & vertices_) const;
 
     private:
-      bool                        _initialized_;      //!< Initialization status
-      datatools::logger::priority _logging_priority_; //!< Logging priority
+      bool                        _initialized_;                //!< Initialization status
+      datatools::logger::priority _logging_priority_;           //!< Logging priority
+      double                      _clustering_max_distance_;    //!< Maximal distance between clustered vertices
+      double                      _clustering_min_probability_; //!< Minimal probability of a vertex pair to be clustered
     };
 
   }  // end of namespace reconstruction
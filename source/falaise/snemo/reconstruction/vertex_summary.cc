@@ -0,0 +1,82 @@
+/// \file falaise/snemo/reconstruction/vertex_summary.cc
+
+// Ourselves:
+#include <falaise/snemo/reconstruction/vertex_summary.h>
+
+// Third party:
+// - Bayeux/geomtools:
+#include <bayeux/geomtools/blur_spot.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track.h>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    // static
+    unsigned int vertex_summary::decode(const geomtools::blur_spot & vertex_)
+    {
+      unsigned int bits = 0;
+      if (snemo::datamodel::particle_track::vertex_is_on_source_foil(vertex_))      bits |= SOURCE_FOIL;
+      if (snemo::datamodel::particle_track::vertex_is_on_main_calorimeter(vertex_)) bits |= MAIN_CALORIMETER;
+      if (snemo::datamodel::particle_track::vertex_is_on_x_calorimeter(vertex_))    bits |= X_CALORIMETER;
+      if (snemo::datamodel::particle_track::vertex_is_on_gamma_veto(vertex_))       bits |= GAMMA_VETO;
+      return bits;
+    }
+
+    void vertex_summary::fill(const std::vector<const snemo::datamodel::particle_track *> & particles_)
+    {
+      categories.clear();
+      offsets.assign(1, 0);
+      offsets.reserve(particles_.size() + 1);
+      for (const auto* a_particle : particles_) {
+        if (a_particle != nullptr && a_particle->has_vertices()) {
+          for (const auto& ivtx : a_particle->get_vertices()) {
+            categories.push_back(decode(ivtx.get()));
+          }
+        }
+        offsets.push_back(categories.size());
+      }
+    }
+
+    void vertex_summary::clear()
+    {
+      categories.clear();
+      offsets.clear();
+    }
+
+    size_t vertex_summary::size() const
+    {
+      return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    size_t vertex_summary::get_number_of_vertices(size_t index_) const
+    {
+      return offsets[index_ + 1] - offsets[index_];
+    }
+
+    unsigned int vertex_summary::get_category(size_t index_, size_t rank_) const
+    {
+      return categories[offsets[index_] + rank_];
+    }
+
+    int vertex_summary::find_first(size_t index_, unsigned int categories_) const
+    {
+      for (size_t i = offsets[index_]; i < offsets[index_ + 1]; i++) {
+        if (categories[i] & categories_) return i - offsets[index_];
+      }
+      return -1;
+    }
+
+  } // end of namespace reconstruction
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
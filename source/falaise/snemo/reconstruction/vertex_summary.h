@@ -0,0 +1,79 @@
+/// \file falaise/snemo/reconstruction/vertex_summary.h
+/*
+ * Description: Vertex categories of the particles of an event decoded once
+ */
+
+#ifndef FALAISE_SNEMO_RECONSTRUCTION_VERTEX_SUMMARY_H
+#define FALAISE_SNEMO_RECONSTRUCTION_VERTEX_SUMMARY_H 1
+
+// Standard library:
+#include <vector>
+
+// Forward declaration
+namespace geomtools {
+  class blur_spot;
+}
+
+namespace snemo {
+
+  namespace datamodel {
+    class particle_track;
+  }
+
+  namespace reconstruction {
+
+    /// Vertex categories of the particles of an event
+    ///
+    /// The type of every vertex of every particle, stored as a string in the
+    /// vertex auxiliaries, is decoded once into a bitmask. The masks of a
+    /// particle follow the order of its vertex collection and are stored in
+    /// a contiguous array indexed by particle.
+    struct vertex_summary
+    {
+      /// Category bits of a vertex
+      enum category_bit {
+        SOURCE_FOIL      = 0x1,
+        MAIN_CALORIMETER = 0x2,
+        X_CALORIMETER    = 0x4,
+        GAMMA_VETO       = 0x8,
+        CALORIMETER      = MAIN_CALORIMETER | X_CALORIMETER | GAMMA_VETO
+      };
+
+      /// Decode the category bits of a vertex from its auxiliaries
+      static unsigned int decode(const geomtools::blur_spot & vertex_);
+
+      /// Decode the vertex categories of a set of particles (null particles have no vertices)
+      void fill(const std::vector<const snemo::datamodel::particle_track *> & particles_);
+
+      /// Remove all entries
+      void clear();
+
+      /// Return the number of particles
+      size_t size() const;
+
+      /// Return the number of vertices of a particle
+      size_t get_number_of_vertices(size_t index_) const;
+
+      /// Return the category bits of the vertex 'rank_' of a particle
+      unsigned int get_category(size_t index_, size_t rank_) const;
+
+      /// Return the rank of the first vertex of a particle within some categories, -1 if none
+      int find_first(size_t index_, unsigned int categories_) const;
+
+      std::vector<unsigned char> categories; //!< Category bits of all the vertices
+      std::vector<size_t> offsets;           //!< Offset of the vertices of every particle, plus the total
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif // FALAISE_SNEMO_RECONSTRUCTION_VERTEX_SUMMARY_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
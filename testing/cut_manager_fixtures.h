@@ -0,0 +1,58 @@
+/** \file testing/cut_manager_fixtures.h
+ *
+ * Description:
+ *
+ *   Cut manager set up from inline cut definitions, shared by the test programs
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_TESTING_CUT_MANAGER_FIXTURES_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_TESTING_CUT_MANAGER_FIXTURES_H 1
+
+// Standard library:
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+// - Bayeux/datatools:
+#include <bayeux/datatools/properties.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+
+namespace snemo {
+
+  namespace testing {
+
+    /// Initialize a cut manager with the cuts of a 'name'/'type' multi-properties text
+    inline void initialize_cut_manager(cuts::cut_manager & cm_, const std::string & definitions_)
+    {
+      const boost::filesystem::path cuts_file
+        = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("flpid_test_cuts_%%%%-%%%%.conf");
+      {
+        std::ofstream out(cuts_file.string().c_str());
+        out << definitions_;
+      }
+      datatools::properties CM_config;
+      CM_config.store("logging.priority", "error");
+      CM_config.store("factory.no_preload", false);
+      CM_config.store_paths("cuts.configuration_files", std::vector<std::string>(1, cuts_file.string()));
+      cm_.initialize(CM_config);
+      boost::filesystem::remove(cuts_file);
+    }
+
+  }  // end of namespace testing
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_TESTING_CUT_MANAGER_FIXTURES_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,119 @@
+/** \file testing/particle_track_fixtures.h
+ *
+ * Description:
+ *
+ *   Synthetic particle tracks shared by the test and benchmark programs
+ *
+ */
+
+#ifndef FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_TESTING_PARTICLE_TRACK_FIXTURES_H
+#define FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_TESTING_PARTICLE_TRACK_FIXTURES_H 1
+
+// Standard library:
+#include <string>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+// - Bayeux/geomtools:
+#include <bayeux/geomtools/blur_spot.h>
+
+// This project:
+#include <falaise/snemo/datamodels/calibrated_calorimeter_hit.h>
+#include <falaise/snemo/datamodels/line_trajectory_pattern.h>
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+
+namespace snemo {
+
+  namespace testing {
+
+    /// Add a typed vertex to a particle track
+    inline void add_vertex(snemo::datamodel::particle_track & pt_, const geomtools::vector_3d & position_,
+                           const std::string & type_)
+    {
+      snemo::datamodel::particle_track::vertex_collection_type & the_vertices = pt_.grab_vertices();
+      the_vertices.push_back(new geomtools::blur_spot);
+      geomtools::blur_spot & a_vertex = the_vertices.back().grab();
+      a_vertex.set_blur_dimension(geomtools::blur_spot::dimension_three);
+      a_vertex.set_position(position_);
+      a_vertex.set_errors(0.1 * CLHEP::mm, 2 * CLHEP::mm, 7 * CLHEP::mm);
+      a_vertex.grab_auxiliaries().update(snemo::datamodel::particle_track::vertex_type_key(), type_);
+    }
+
+    /// Add a calorimeter hit to a particle track
+    inline void add_calorimeter_hit(snemo::datamodel::particle_track & pt_, double time_, double energy_)
+    {
+      snemo::datamodel::calibrated_calorimeter_hit::collection_type & the_calos
+        = pt_.grab_associated_calorimeter_hits();
+      the_calos.push_back(new snemo::datamodel::calibrated_calorimeter_hit);
+      snemo::datamodel::calibrated_calorimeter_hit & a_calo = the_calos.back().grab();
+      a_calo.set_energy(energy_);
+      a_calo.set_sigma_energy(80 * CLHEP::keV);
+      a_calo.set_time(time_);
+      a_calo.set_sigma_time(0.05 * CLHEP::ns);
+    }
+
+    /// Add a straight trajectory to a particle track
+    inline void add_line_trajectory(snemo::datamodel::particle_track & pt_,
+                                    const geomtools::vector_3d & first_,
+                                    const geomtools::vector_3d & last_)
+    {
+      snemo::datamodel::line_trajectory_pattern * ltp = new snemo::datamodel::line_trajectory_pattern;
+      ltp->grab_segment().set_first(first_);
+      ltp->grab_segment().set_last(last_);
+      snemo::datamodel::tracker_trajectory::handle_pattern a_pattern;
+      a_pattern.reset(ltp);
+      snemo::datamodel::tracker_trajectory::handle_type a_trajectory;
+      a_trajectory.reset(new snemo::datamodel::tracker_trajectory);
+      a_trajectory.grab().set_pattern_handle(a_pattern);
+      pt_.set_trajectory_handle(a_trajectory);
+    }
+
+    /// Make an electron emitted from the source foil at height z_ and hitting
+    /// the main calorimeter wall at (y_, z_)
+    inline snemo::datamodel::particle_track make_electron(double y_, double z_, double time_, double energy_)
+    {
+      snemo::datamodel::particle_track electron;
+      electron.set_charge(snemo::datamodel::particle_track::negative);
+      electron.grab_auxiliaries().update(snemo::datamodel::pid_utils::pid_label_key(),
+                                         snemo::datamodel::pid_utils::electron_label());
+      add_vertex(electron, geomtools::vector_3d(0, 0, z_),
+                 snemo::datamodel::particle_track::vertex_on_source_foil_label());
+      add_line_trajectory(electron, geomtools::vector_3d(0, 0, z_), geomtools::vector_3d(45 * CLHEP::cm, y_, z_));
+      add_calorimeter_hit(electron, time_, energy_);
+      return electron;
+    }
+
+    /// Make a gamma hitting a main calorimeter block at (y_, z_)
+    inline snemo::datamodel::particle_track make_gamma(double y_, double z_, double time_, double energy_)
+    {
+      snemo::datamodel::particle_track gamma;
+      gamma.set_charge(snemo::datamodel::particle_track::neutral);
+      gamma.grab_auxiliaries().update(snemo::datamodel::pid_utils::pid_label_key(),
+                                      snemo::datamodel::pid_utils::gamma_label());
+      add_vertex(gamma, geomtools::vector_3d(-45 * CLHEP::cm, y_, z_),
+                 snemo::datamodel::particle_track::vertex_on_main_calorimeter_label());
+      add_calorimeter_hit(gamma, time_, energy_);
+      return gamma;
+    }
+
+    /// Wrap a particle track into a handle, as stored by the particle track data
+    inline snemo::datamodel::particle_track::handle_type make_handle(const snemo::datamodel::particle_track & pt_)
+    {
+      return snemo::datamodel::particle_track::handle_type(new snemo::datamodel::particle_track(pt_));
+    }
+
+  }  // end of namespace testing
+
+}  // end of namespace snemo
+
+#endif // FALAISE_PARTICLE_IDENTIFICATION_PLUGIN_TESTING_PARTICLE_TRACK_FIXTURES_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
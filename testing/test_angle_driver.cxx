@@ -4,6 +4,8 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cmath>
 #include <exception>
 
 // This project:
@@ -60,6 +62,26 @@ int main()
 
       std::clog << "Electron angle : " << std::endl;
       angle.tree_dump();
+
+      // Memoized direction and pairwise angles
+      const geomtools::vector_3d electron_dir = AD.get_direction(electron);
+      DT_THROW_IF(AD.process(electron_dir) != driverCalculatedAngle, std::logic_error,
+                  "Angle from memoized direction differs !");
+      const std::vector<geomtools::vector_3d> directions = {
+        electron_dir,
+        geomtools::vector_3d(1, 0, 0),
+        geomtools::vector_3d(0, 0, 1)
+      };
+      std::vector<double> angles;
+      AD.process(directions, angles);
+      for (size_t i = 0; i < directions.size(); i++) {
+        for (size_t j = 0; j < directions.size(); j++) {
+          std::clog << "Angle(" << i << "," << j << ") = "
+                    << angles[i * directions.size() + j]/CLHEP::degree << " degree" << std::endl;
+        }
+      }
+      DT_THROW_IF(std::abs(angles[0 * 3 + 1] - 90 * CLHEP::degree) > 1e-9, std::logic_error,
+                  "Invalid pairwise angle !");
     }
 
   } catch (std::exception & x) {
@@ -1,14 +1,23 @@
 // test_base_topology_pattern.cxx
 
 // Standard library:
+#include <atomic>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <exception>
 
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+
 // This project:
 #include <falaise/snemo/datamodels/topology_2e_pattern.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
 
 int main()
 {
@@ -21,8 +30,8 @@ int main()
     hTP0.reset(new snemo::datamodel::topology_2e_pattern);
     snemo::datamodel::base_topology_pattern & a_pattern = hTP0.grab();
 
-    // Add associated measurement :
-    auto meas_dict = a_pattern.get_measurement_dictionary();
+    // Add associated measurement, in the pattern itself :
+    auto & meas_dict = a_pattern.get_measurement_dictionary();
     // Add fake TOF measurements
     meas_dict.insert(std::make_pair("fake_tof_1", new snemo::datamodel::tof_measurement));
     meas_dict.insert(std::make_pair("fake_tof_2", new snemo::datamodel::tof_measurement));
@@ -50,6 +59,121 @@ int main()
       }
       std::clog << "'" << a_key << "' measurement" << std::endl;
     }
+    DT_THROW_IF(! a_pattern.has_measurement("fake_tof_[0-9]{2}"), std::logic_error,
+                "Measurements are not stored in the pattern !");
+    DT_THROW_IF(a_pattern.has_measurement(".*_(100|1000)"), std::logic_error, "Unexpected measurement !");
+
+    // Add a measurement computed on first access
+    int nevaluations = 0;
+    a_pattern.add_deferred_measurement("deferred_tof",
+                                       [&nevaluations] () {
+                                         nevaluations++;
+                                         return snemo::datamodel::base_topology_pattern::handle_measurement(new snemo::datamodel::tof_measurement);
+                                       });
+    DT_THROW_IF(! a_pattern.has_measurement("deferred_.*"), std::logic_error, "Deferred measurement not found !");
+    DT_THROW_IF(nevaluations != 0, std::logic_error, "Deferred measurement evaluated too early !");
+    a_pattern.get_measurement("deferred_tof");
+    a_pattern.get_measurement("deferred_tof");
+    DT_THROW_IF(a_pattern.is_deferred_measurement("deferred_tof"), std::logic_error, "Deferred measurement not evaluated !");
+    DT_THROW_IF(nevaluations != 1, std::logic_error, "Deferred measurement evaluated " << nevaluations << " times !");
+
+    // Concurrent readers evaluate a deferred measurement once, and a copy
+    // only holds evaluated measurements, valid once the source is gone
+    {
+      std::atomic<int> nconcurrent(0);
+      snemo::datamodel::base_topology_pattern::handle_type hTP1;
+      hTP1.reset(new snemo::datamodel::topology_2e_pattern);
+      const snemo::datamodel::base_topology_pattern & a_source = hTP1.get();
+      for (size_t i = 0; i < 10; i++) {
+        hTP1.grab().add_deferred_measurement("tof_" + std::to_string(i),
+                                             [&nconcurrent, &a_source, i] () {
+                                               nconcurrent++;
+                                               // Nested evaluation of another deferred measurement
+                                               if (i > 0) a_source.get_measurement("tof_0");
+                                               return snemo::datamodel::base_topology_pattern::handle_measurement(new snemo::datamodel::tof_measurement);
+                                             });
+      }
+      std::vector<std::thread> readers;
+      for (size_t ireader = 0; ireader < 4; ireader++) {
+        readers.push_back(std::thread([&a_source, ireader] {
+              for (size_t i = 0; i < 10; i++) {
+                a_source.find_measurement("tof_" + std::to_string((i + 3 * ireader) % 10));
+                a_source.has_measurement("tof_[0-9]");
+              }
+            }));
+      }
+      snemo::datamodel::topology_2e_pattern a_copy(dynamic_cast<const snemo::datamodel::topology_2e_pattern &>(a_source));
+      for (auto& a_reader : readers) {
+        a_reader.join();
+      }
+      DT_THROW_IF(nconcurrent != 10, std::logic_error,
+                  "Deferred measurements evaluated " << nconcurrent << " times !");
+      hTP1.reset();
+      DT_THROW_IF(a_copy.is_deferred_measurement("tof_5"), std::logic_error, "Copy holds a deferred measurement !");
+      DT_THROW_IF(a_copy.get_measurement_dictionary().size() != 10, std::logic_error, "Copy misses measurements !");
+    }
+
+    // Typed access to a measurement
+    DT_THROW_IF(! a_pattern.has_measurement_as<snemo::datamodel::tof_measurement>("deferred_tof"),
+                std::logic_error, "Measurement is not recognized as a TOF measurement !");
+    a_pattern.get_measurement_as<snemo::datamodel::tof_measurement>("deferred_tof");
+
+    // Energy ordering of the electrons, computed when the pattern is finalized
+    snemo::datamodel::topology_2e_pattern & a_2e_pattern = dynamic_cast<snemo::datamodel::topology_2e_pattern &>(a_pattern);
+    DT_THROW_IF(a_2e_pattern.has_electrons_energy(), std::logic_error, "Unexpected electrons energy !");
+    snemo::datamodel::energy_measurement * energy_e1 = new snemo::datamodel::energy_measurement;
+    energy_e1->set_energy(1.2 * CLHEP::MeV);
+    snemo::datamodel::energy_measurement * energy_e2 = new snemo::datamodel::energy_measurement;
+    energy_e2->set_energy(0.7 * CLHEP::MeV);
+    a_pattern.get_measurement_dictionary()["energy_e1"].reset(energy_e1);
+    a_pattern.get_measurement_dictionary()["energy_e2"].reset(energy_e2);
+    a_pattern.finalize();
+    DT_THROW_IF(! a_2e_pattern.has_electrons_energy(), std::logic_error, "Missing electrons energy !");
+    DT_THROW_IF(a_2e_pattern.get_minimal_energy_electron_name() != "e2", std::logic_error, "Wrong minimal energy electron !");
+    DT_THROW_IF(std::abs(a_2e_pattern.get_electrons_energy_sum() - 1.9 * CLHEP::MeV) > 1e-9,
+                std::logic_error, "Wrong electrons energy sum !");
+
+    // The energy ordering is computed again once the measurements have been
+    // handed out for changes, copies and concurrent readers order their own
+    {
+      const snemo::datamodel::topology_2e_pattern a_copy(a_2e_pattern);
+      snemo::datamodel::energy_measurement * new_energy_e2 = new snemo::datamodel::energy_measurement;
+      new_energy_e2->set_energy(1.5 * CLHEP::MeV);
+      a_pattern.get_measurement_dictionary()["energy_e2"].reset(new_energy_e2);
+      DT_THROW_IF(a_2e_pattern.get_minimal_energy_electron_name() != "e1", std::logic_error,
+                  "Stale minimal energy electron !");
+      std::vector<std::thread> readers;
+      std::atomic<size_t> nwrong(0);
+      for (size_t ireader = 0; ireader < 4; ireader++) {
+        readers.push_back(std::thread([&a_copy, &nwrong] {
+              if (a_copy.get_minimal_energy_electron_name() != "e2") nwrong++;
+              if (std::abs(a_copy.get_electrons_energy_sum() - 1.9 * CLHEP::MeV) > 1e-9) nwrong++;
+            }));
+      }
+      for (auto& a_reader : readers) {
+        a_reader.join();
+      }
+      DT_THROW_IF(nwrong != 0, std::logic_error, "Wrong electrons energies of the copy !");
+    }
+
+    // Measurements of the schema are resolved again once the measurements
+    // have been handed out for changes, and copies resolve their own
+    {
+      snemo::datamodel::tof_measurement * tof_e1_e2 = new snemo::datamodel::tof_measurement;
+      tof_e1_e2->get_internal_probabilities().push_back(0.3);
+      a_pattern.get_measurement_dictionary()["tof_e1_e2"].reset(tof_e1_e2);
+      a_pattern.finalize();
+      DT_THROW_IF(a_2e_pattern.get_electrons_internal_probability() != 0.3, std::logic_error,
+                  "Wrong electrons internal probability !");
+      const snemo::datamodel::topology_2e_pattern a_copy(a_2e_pattern);
+      snemo::datamodel::tof_measurement * new_tof_e1_e2 = new snemo::datamodel::tof_measurement;
+      new_tof_e1_e2->get_internal_probabilities().push_back(0.6);
+      a_pattern.get_measurement_dictionary()["tof_e1_e2"].reset(new_tof_e1_e2);
+      DT_THROW_IF(a_2e_pattern.get_electrons_internal_probability() != 0.6, std::logic_error,
+                  "Stale electrons internal probability !");
+      DT_THROW_IF(a_copy.get_electrons_internal_probability() != 0.3, std::logic_error,
+                  "Wrong electrons internal probability of the copy !");
+    }
 
   } catch (std::exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
@@ -0,0 +1,127 @@
+// test_batch_measurement_cuts.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/cuts/energy_measurement_cut.h>
+#include <falaise/snemo/cuts/tof_measurement_cut.h>
+
+namespace {
+
+  /// Check that the batch selection matches the event by event processing
+  void compare(cuts::i_cut & cut_, const snemo::cut::i_batch_measurement_cut & batch_cut_,
+               const snemo::cut::i_batch_measurement_cut::measurement_batch_type & measurements_)
+  {
+    snemo::cut::batch_selection selection;
+    batch_cut_.select(measurements_, selection);
+    DT_THROW_IF(selection.size() != measurements_.size(), std::logic_error, "Wrong batch size !");
+    for (size_t i = 0; i < measurements_.size(); i++) {
+      int status = cuts::SELECTION_INAPPLICABLE;
+      if (measurements_[i] != nullptr) {
+        cut_.set_user_data(*measurements_[i]);
+        status = cut_.process();
+      }
+      std::clog << "Event #" << i << " : status = " << status
+                << ", batch status = " << selection.get_status(i) << std::endl;
+      DT_THROW_IF(selection.get_status(i) != status, std::logic_error,
+                  "Batch selection differs for event #" << i << " !");
+    }
+  }
+
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the batch selection of measurement cuts." << std::endl;
+
+    // Energies of a batch, the last one being invalid :
+    std::vector<snemo::datamodel::energy_measurement> energies(5);
+    energies[0].set_energy(100 * CLHEP::keV);
+    energies[1].set_energy(400 * CLHEP::keV);
+    energies[2].set_energy(1500 * CLHEP::keV);
+    energies[3].set_energy(300 * CLHEP::keV);
+    energies[4].set_energy(datatools::invalid_real());
+    snemo::cut::i_batch_measurement_cut::measurement_batch_type energy_batch;
+    for (const auto& a_energy : energies) {
+      energy_batch.push_back(&a_energy);
+    }
+    energy_batch.push_back(nullptr);
+
+    {
+      snemo::cut::energy_measurement_cut EMC;
+      datatools::properties EMC_config;
+      EMC_config.store("mode.has_energy", true);
+      EMC_config.store("mode.range_energy", true);
+      EMC_config.store_real_with_explicit_unit("range_energy.min", 300 * CLHEP::keV);
+      EMC.initialize_standalone(EMC_config);
+      compare(EMC, EMC, energy_batch);
+    }
+    {
+      snemo::cut::energy_measurement_cut EMC;
+      datatools::properties EMC_config;
+      EMC_config.store("mode.has_energy", true);
+      EMC.initialize_standalone(EMC_config);
+      compare(EMC, EMC, energy_batch);
+    }
+
+    // TOF measurements of a batch, the last one being empty :
+    std::vector<snemo::datamodel::tof_measurement> tofs(4);
+    tofs[0].get_internal_probabilities() = {10 * CLHEP::perCent, 30 * CLHEP::perCent};
+    tofs[0].get_external_probabilities() = {1e-3 * CLHEP::perCent};
+    tofs[1].get_internal_probabilities() = {60 * CLHEP::perCent};
+    tofs[1].get_external_probabilities() = {1e-5 * CLHEP::perCent, 1e-4 * CLHEP::perCent};
+    tofs[2].get_internal_probabilities() = {2 * CLHEP::perCent, 20 * CLHEP::perCent};
+    tofs[2].get_external_probabilities() = {10 * CLHEP::perCent};
+    snemo::cut::i_batch_measurement_cut::measurement_batch_type tof_batch;
+    for (const auto& a_tof : tofs) {
+      tof_batch.push_back(&a_tof);
+    }
+    tof_batch.push_back(&energies[0]);
+
+    {
+      snemo::cut::tof_measurement_cut TMC;
+      datatools::properties TMC_config;
+      TMC_config.store("mode.has_internal_probability", true);
+      TMC_config.store("mode.range_internal_probability", true);
+      TMC_config.store("range_internal_probability.mode", "all");
+      TMC_config.store_real_with_explicit_unit("range_internal_probability.min", 5 * CLHEP::perCent);
+      TMC_config.store_real_with_explicit_unit("range_internal_probability.max", 50 * CLHEP::perCent);
+      TMC_config.store("mode.range_external_probability", true);
+      TMC_config.store("range_external_probability.mode", "strict");
+      TMC_config.store_real_with_explicit_unit("range_external_probability.max", 1 * CLHEP::perCent);
+      TMC.initialize_standalone(TMC_config);
+      // The energy measurement of the last event is not a TOF measurement :
+      tof_batch.pop_back();
+      compare(TMC, TMC, tof_batch);
+      tof_batch.push_back(&energies[0]);
+      snemo::cut::batch_selection selection;
+      TMC.select(tof_batch, selection);
+      DT_THROW_IF(selection.get_status(tof_batch.size() - 1) != cuts::SELECTION_INAPPLICABLE,
+                  std::logic_error, "Measurement of another type must be inapplicable !");
+      std::clog << "Accepted TOF measurements : " << selection.count(cuts::SELECTION_ACCEPTED) << std::endl;
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
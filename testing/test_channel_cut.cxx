@@ -0,0 +1,155 @@
+// test_channel_cut.cxx
+//
+// The batch selection of a channel cut must give the same statuses as
+// processing the cut record by record, including records without topology
+// data, without pattern or missing the measurements of the channel.
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/things.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/topology_2e_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/cuts/batch_selection.h>
+#include <falaise/snemo/cuts/channel_cut.h>
+#include "cut_manager_fixtures.h"
+
+namespace {
+
+  const std::string cuts_definitions =
+    "#@key_label  \"name\"                                                 \n"
+    "#@meta_label \"type\"                                                 \n"
+    "[name=\"good_internal_probability\" type=\"snemo::cut::tof_measurement_cut\"] \n"
+    "mode.has_internal_probability : boolean = true                        \n"
+    "mode.range_internal_probability : boolean = true                      \n"
+    "range_internal_probability.mode : string = \"all\"                    \n"
+    "range_internal_probability.min : real as fraction = 1 %               \n"
+    "[name=\"energy_above_threshold\" type=\"snemo::cut::energy_measurement_cut\"] \n"
+    "mode.has_energy : boolean = true                                      \n"
+    "mode.range_energy : boolean = true                                    \n"
+    "range_energy.min : real as energy = 300 keV                           \n"
+    "[name=\"any\" type=\"cuts::accept_cut\"]                              \n"
+    "[name=\"2e::channel_cut\" type=\"snemo::cut::channel_cut\"]           \n"
+    "cuts : string[3] = \"int_prob\" \"energy\" \"any\"                    \n"
+    "int_prob.cut_label : string = \"good_internal_probability\"           \n"
+    "int_prob.measurement_label : string = \"tof_e1_e2\"                   \n"
+    "energy.cut_label : string = \"energy_above_threshold\"                \n"
+    "energy.measurement_label : string = \"energy_e1\"                     \n"
+    "any.cut_label : string = \"any\"                                      \n"
+    "any.measurement_label : string = \"energy_e1\"                        \n";
+
+  // Kinds of records, cycled over the batch
+  enum record_kind {
+    ACCEPTED_RECORD = 0,
+    LOW_PROBABILITY_RECORD,
+    LOW_ENERGY_RECORD,
+    NO_PROBABILITY_RECORD,
+    MISSING_TOF_RECORD,
+    MISSING_ENERGY_RECORD,
+    NO_PATTERN_RECORD,
+    NO_TD_RECORD,
+    NUMBER_OF_RECORD_KINDS
+  };
+
+  void make_record(const record_kind kind_, datatools::things & record_)
+  {
+    if (kind_ == NO_TD_RECORD) return;
+    snemo::datamodel::topology_data & TD = record_.add<snemo::datamodel::topology_data>("TD");
+    if (kind_ == NO_PATTERN_RECORD) return;
+    snemo::datamodel::topology_data::handle_pattern a_pattern(new snemo::datamodel::topology_2e_pattern);
+    snemo::datamodel::base_topology_pattern::measurement_dict_type & measurements
+      = a_pattern.grab().get_measurement_dictionary();
+    if (kind_ != MISSING_TOF_RECORD) {
+      auto * a_tof = new snemo::datamodel::tof_measurement;
+      if (kind_ != NO_PROBABILITY_RECORD) {
+        a_tof->get_internal_probabilities().push_back(kind_ == LOW_PROBABILITY_RECORD ? 0.005 : 0.3);
+      }
+      measurements["tof_e1_e2"].reset(a_tof);
+    }
+    if (kind_ != MISSING_ENERGY_RECORD) {
+      auto * an_energy = new snemo::datamodel::energy_measurement;
+      an_energy->set_energy((kind_ == LOW_ENERGY_RECORD ? 100 : 1000) * CLHEP::keV);
+      measurements["energy_e1"].reset(an_energy);
+    }
+    TD.set_pattern_handle(a_pattern);
+  }
+
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the batch selection of the channel cut." << std::endl;
+
+    cuts::cut_manager CM;
+    snemo::testing::initialize_cut_manager(CM, cuts_definitions);
+    snemo::cut::channel_cut & CC = dynamic_cast<snemo::cut::channel_cut &>(CM.grab("2e::channel_cut"));
+
+    // More records than a bitmask word holds
+    const size_t nrecords = 9 * NUMBER_OF_RECORD_KINDS;
+    std::vector<datatools::things> records(nrecords);
+    std::vector<const datatools::things *> record_pointers;
+    snemo::cut::channel_cut::pattern_batch_type patterns;
+    for (size_t i = 0; i < nrecords; i++) {
+      make_record(static_cast<record_kind>(i % NUMBER_OF_RECORD_KINDS), records[i]);
+      record_pointers.push_back(&records[i]);
+      const datatools::things & ER = records[i];
+      const snemo::datamodel::base_topology_pattern * a_pattern = nullptr;
+      if (ER.has("TD") && ER.get<snemo::datamodel::topology_data>("TD").has_pattern()) {
+        a_pattern = &ER.get<snemo::datamodel::topology_data>("TD").get_pattern();
+      }
+      patterns.push_back(a_pattern);
+    }
+
+    snemo::cut::batch_selection record_selection;
+    CC.select_records(record_pointers, record_selection);
+    snemo::cut::batch_selection pattern_selection;
+    CC.select(patterns, pattern_selection);
+    DT_THROW_IF(record_selection.size() != nrecords || pattern_selection.size() != nrecords,
+                std::logic_error, "Wrong batch size !");
+
+    for (size_t i = 0; i < nrecords; i++) {
+      CC.set_user_data(records[i]);
+      const int status = CC.process();
+      CC.reset_user_data();
+      DT_THROW_IF(record_selection.get_status(i) != status, std::logic_error,
+                  "Record #" << i << " : batch status " << record_selection.get_status(i)
+                  << " differs from processed status " << status << " !");
+      DT_THROW_IF(pattern_selection.get_status(i) != status, std::logic_error,
+                  "Pattern #" << i << " : batch status " << pattern_selection.get_status(i)
+                  << " differs from processed status " << status << " !");
+      const record_kind kind = static_cast<record_kind>(i % NUMBER_OF_RECORD_KINDS);
+      const int expected = (kind == ACCEPTED_RECORD ? cuts::SELECTION_ACCEPTED
+                            : kind >= NO_PROBABILITY_RECORD ? cuts::SELECTION_INAPPLICABLE
+                            : cuts::SELECTION_REJECTED);
+      DT_THROW_IF(status != expected, std::logic_error,
+                  "Record #" << i << " : unexpected status " << status << " !");
+    }
+    DT_THROW_IF(record_selection.count(cuts::SELECTION_ACCEPTED) != nrecords / NUMBER_OF_RECORD_KINDS,
+                std::logic_error, "Wrong number of accepted records !");
+
+    CM.reset();
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,69 @@
+// test_classification_index.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/classification_index.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'classification_index' classes." << std::endl;
+
+    // Classification packing
+    const std::vector<std::string> labels = {"2e", "1e1g", "2e2g", "1e1a", "1e1p", "2p", "3X", ""};
+    for (const auto& a_label : labels) {
+      const uint32_t packed = snemo::reconstruction::pack_classification(a_label);
+      std::clog << "Classification '" << a_label << "' is packed as " << packed << std::endl;
+      DT_THROW_IF(snemo::reconstruction::unpack_classification(packed) != a_label, std::logic_error,
+                  "Classification '" << a_label << "' does not survive packing !");
+    }
+
+    // Index round trip
+    const std::string filename = "test_classification_index.idx";
+    const std::vector<std::string> channels = {"2e::channel_cut", "1e::channel_cut"};
+    {
+      snemo::reconstruction::classification_index_writer writer;
+      writer.open(filename, channels);
+      for (uint64_t i = 0; i < 100; i++) {
+        snemo::reconstruction::classification_index_entry an_entry;
+        an_entry.record = i;
+        an_entry.classification = snemo::reconstruction::pack_classification(i % 2 ? "2e" : "1e1g");
+        an_entry.channels = (i % 2 && i % 3 == 0) ? 1 : 0;
+        writer.append(an_entry);
+      }
+      writer.close();
+    }
+
+    snemo::reconstruction::classification_index_reader reader;
+    reader.open(filename);
+    DT_THROW_IF(reader.size() != 100, std::logic_error, "Invalid number of entries !");
+    DT_THROW_IF(reader.get_channels() != channels, std::logic_error, "Invalid channel names !");
+
+    std::vector<uint64_t> records;
+    reader.select({snemo::reconstruction::pack_classification("2e")}, 0, records);
+    DT_THROW_IF(records.size() != 50, std::logic_error, "Invalid number of '2e' records !");
+    reader.select({}, reader.get_channel_bit("2e::channel_cut"), records);
+    DT_THROW_IF(records.size() != 17, std::logic_error, "Invalid number of '2e::channel_cut' records !");
+    DT_THROW_IF(records.front() != 3, std::logic_error, "Invalid first '2e::channel_cut' record !");
+    reader.close();
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
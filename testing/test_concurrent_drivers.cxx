@@ -0,0 +1,156 @@
+// test_concurrent_drivers.cxx
+//
+// One set of measurement drivers is shared by several threads processing
+// the same events. Drivers are initialized by the first thread needing them
+// and every thread must get the results of a sequential processing. Meant
+// to be run under the thread sanitizer as well.
+
+// Standard library:
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/vertex_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/reconstruction/tof_driver.h>
+#include <falaise/snemo/reconstruction/vertex_driver.h>
+#include <falaise/snemo/reconstruction/angle_driver.h>
+#include <falaise/snemo/reconstruction/energy_driver.h>
+#include <falaise/snemo/reconstruction/topology_driver.h>
+#include "particle_track_fixtures.h"
+
+namespace {
+
+  using snemo::testing::make_electron;
+
+  /// Results of the measurements of one event
+  struct event_results {
+    std::vector<double> tof_internal;
+    std::vector<double> tof_external;
+    double vertex_probability;
+    double angle;
+    double energy1;
+    double energy2;
+
+    /// Invalid values of both results are considered equal
+    static bool same(double a_, double b_)
+    {
+      return a_ == b_ || (! datatools::is_valid(a_) && ! datatools::is_valid(b_));
+    }
+
+    bool operator==(const event_results & other_) const
+    {
+      return tof_internal == other_.tof_internal && tof_external == other_.tof_external
+        && same(vertex_probability, other_.vertex_probability) && same(angle, other_.angle)
+        && same(energy1, other_.energy1) && same(energy2, other_.energy2);
+    }
+  };
+
+  /// Run all the measurements of an event with a set of drivers
+  event_results measure(const snemo::reconstruction::measurement_drivers & drivers_,
+                        const snemo::datamodel::particle_track & pt1_,
+                        const snemo::datamodel::particle_track & pt2_)
+  {
+    event_results results;
+    snemo::datamodel::tof_measurement a_tof;
+    drivers_.TOFD->process(pt1_, pt2_, a_tof);
+    results.tof_internal = a_tof.get_internal_probabilities();
+    results.tof_external = a_tof.get_external_probabilities();
+    snemo::datamodel::vertex_measurement a_vertex;
+    drivers_.VD->process(pt1_, pt2_, a_vertex);
+    results.vertex_probability = a_vertex.get_probability();
+    results.angle = drivers_.AMD->process(pt1_, pt2_);
+    snemo::datamodel::energy_measurement an_energy;
+    drivers_.EMD->process(pt1_, an_energy);
+    results.energy1 = an_energy.get_energy();
+    drivers_.EMD->process(pt2_, an_energy);
+    results.energy2 = an_energy.get_energy();
+    return results;
+  }
+
+  /// Request all the drivers from a common setup
+  void configure(snemo::reconstruction::measurement_drivers & drivers_)
+  {
+    std::shared_ptr<const datatools::properties> a_setup(new datatools::properties);
+    drivers_.TOFD.configure(a_setup, snemo::reconstruction::tof_driver::get_id() + ".");
+    drivers_.VD.configure(a_setup, snemo::reconstruction::vertex_driver::get_id() + ".");
+    drivers_.AMD.configure(a_setup, snemo::reconstruction::angle_driver::get_id() + ".");
+    drivers_.EMD.configure(a_setup, snemo::reconstruction::energy_driver::get_id() + ".");
+  }
+
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for measurement drivers shared by concurrent threads." << std::endl;
+
+    // Fake events :
+    const size_t nevents = 64;
+    std::vector<std::pair<snemo::datamodel::particle_track, snemo::datamodel::particle_track> > events;
+    for (size_t i = 0; i < nevents; i++) {
+      events.push_back(std::make_pair(make_electron(10 * CLHEP::cm + i * CLHEP::mm, i * CLHEP::mm,
+                                                    1.6 * CLHEP::ns, 1000 * CLHEP::keV),
+                                      make_electron(-20 * CLHEP::cm, i * CLHEP::mm + 3 * CLHEP::mm,
+                                                    (1.4 + 0.01 * i) * CLHEP::ns, (500 + 10 * i) * CLHEP::keV)));
+    }
+
+    // Sequential reference :
+    std::vector<event_results> references;
+    {
+      snemo::reconstruction::measurement_drivers drivers;
+      configure(drivers);
+      for (const auto& an_event : events) {
+        references.push_back(measure(drivers, an_event.first, an_event.second));
+      }
+    }
+
+    // Concurrent processing with drivers initialized on first use :
+    const size_t nthreads = 8;
+    const size_t npasses = 50;
+    snemo::reconstruction::measurement_drivers shared_drivers;
+    configure(shared_drivers);
+    std::atomic<size_t> nmismatches(0);
+    std::atomic<size_t> nprocessed(0);
+    std::vector<std::thread> threads;
+    for (size_t ithread = 0; ithread < nthreads; ithread++) {
+      threads.push_back(std::thread([&, ithread] {
+            for (size_t ipass = 0; ipass < npasses; ipass++) {
+              for (size_t i = 0; i < nevents; i++) {
+                // Threads walk through the events with different offsets
+                const size_t ievent = (i + ithread * 7) % nevents;
+                const event_results results = measure(shared_drivers, events[ievent].first, events[ievent].second);
+                if (! (results == references[ievent])) nmismatches++;
+                nprocessed++;
+              }
+            }
+          }));
+    }
+    for (auto& a_thread : threads) {
+      a_thread.join();
+    }
+
+    std::clog << "Processed events : " << nprocessed << std::endl;
+    DT_THROW_IF(nprocessed != nthreads * npasses * nevents, std::logic_error, "Missing processed events !");
+    DT_THROW_IF(nmismatches != 0, std::logic_error,
+                nmismatches << " events differ from the sequential processing !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
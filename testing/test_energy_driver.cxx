@@ -61,6 +61,45 @@ int main()
       energy.tree_dump();
     }
 
+    // Event calorimeter summary :
+    {
+      snemo::datamodel::particle_track electron;
+      snemo::datamodel::particle_track gamma;
+      snemo::datamodel::particle_track alpha;
+      {
+        snemo::datamodel::calibrated_calorimeter_hit::collection_type & the_calos
+          = electron.grab_associated_calorimeter_hits();
+        the_calos.push_back(new snemo::datamodel::calibrated_calorimeter_hit);
+        snemo::datamodel::calibrated_calorimeter_hit & a_calo = the_calos.back().grab();
+        a_calo.set_energy(1000 * CLHEP::keV);
+        a_calo.set_time(2 * CLHEP::ns);
+        a_calo.set_sigma_time(0.3 * CLHEP::ns);
+      }
+      {
+        snemo::datamodel::calibrated_calorimeter_hit::collection_type & the_calos
+          = gamma.grab_associated_calorimeter_hits();
+        the_calos.push_back(new snemo::datamodel::calibrated_calorimeter_hit);
+        the_calos.back().grab().set_energy(500 * CLHEP::keV);
+        the_calos.push_back(new snemo::datamodel::calibrated_calorimeter_hit);
+        the_calos.back().grab().set_energy(1000 * CLHEP::keV);
+      }
+
+      snemo::reconstruction::calorimeter_summary calorimeters;
+      calorimeters.fill({&electron, &gamma, &alpha});
+      for (size_t i = 0; i < calorimeters.size(); i++) {
+        std::clog << "Particle #" << i << " : energy = " << calorimeters.energies[i]/CLHEP::keV
+                  << " keV, first hit energy = " << calorimeters.first_energies[i]/CLHEP::keV
+                  << " keV, first hit time = " << calorimeters.first_times[i]/CLHEP::ns << " ns"
+                  << std::endl;
+      }
+      snemo::datamodel::energy_measurement energy;
+      ED.process(calorimeters, 1, energy);
+      DT_THROW_IF(energy.get_energy() != 1500 * CLHEP::keV, std::logic_error,
+                  "Invalid summed gamma energy !");
+      DT_THROW_IF(datatools::is_valid(calorimeters.energies[2]), std::logic_error,
+                  "Particle without calorimeter hit should have an invalid energy !");
+    }
+
   } catch (std::exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
     error_code = EXIT_FAILURE;
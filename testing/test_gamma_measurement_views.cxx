@@ -0,0 +1,122 @@
+// test_gamma_measurement_views.cxx
+//
+// The per-gamma measurements of 1eNg and 2eNg patterns are gathered in
+// contiguous arrays: each gamma must be found with its energy and its TOF
+// probabilities, and the views must be built again once the measurements
+// have been changed.
+
+// Standard library:
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_1eNg_pattern.h>
+#include <falaise/snemo/datamodels/topology_2eNg_pattern.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/energy_measurement.h>
+
+namespace {
+
+  void add_energy(snemo::datamodel::base_topology_pattern & pattern_, const std::string & label_, double energy_)
+  {
+    snemo::datamodel::energy_measurement * an_energy = new snemo::datamodel::energy_measurement;
+    an_energy->set_energy(energy_);
+    pattern_.get_measurement_dictionary()["energy_" + label_].reset(an_energy);
+  }
+
+  void add_tof(snemo::datamodel::base_topology_pattern & pattern_, const std::string & label_,
+               const snemo::datamodel::tof_measurement::probability_type & internal_,
+               const snemo::datamodel::tof_measurement::probability_type & external_)
+  {
+    snemo::datamodel::tof_measurement * a_tof = new snemo::datamodel::tof_measurement;
+    a_tof->get_internal_probabilities() = internal_;
+    a_tof->get_external_probabilities() = external_;
+    pattern_.get_measurement_dictionary()["tof_" + label_].reset(a_tof);
+  }
+
+}
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'gamma_measurement_views' class." << std::endl;
+
+    // Two electrons and two gammas, the 'e2'-'g2' TOF being not measured :
+    snemo::datamodel::topology_2eNg_pattern a_2eNg_pattern;
+    a_2eNg_pattern.set_number_of_gammas(2);
+    add_energy(a_2eNg_pattern, "g1", 0.5 * CLHEP::MeV);
+    add_energy(a_2eNg_pattern, "g2", 0.3 * CLHEP::MeV);
+    add_tof(a_2eNg_pattern, "e1_g1", {0.1}, {0.9});
+    add_tof(a_2eNg_pattern, "e2_g1", {0.2}, {0.8});
+    add_tof(a_2eNg_pattern, "e1_g2", {0.3, 0.35}, {0.7});
+    a_2eNg_pattern.finalize();
+
+    {
+      const snemo::datamodel::gamma_measurement_views & the_views = a_2eNg_pattern.get_gamma_views();
+      DT_THROW_IF(the_views.get_number_of_gammas() != 2, std::logic_error, "Wrong number of gammas !");
+      DT_THROW_IF(the_views.get_charged_index("e2") != 1, std::logic_error, "Wrong index of 'e2' !");
+      DT_THROW_IF(! the_views.has_energy(1) || the_views.get_energies()[1] != 0.3 * CLHEP::MeV,
+                  std::logic_error, "Wrong energy of 'g2' !");
+      DT_THROW_IF(! the_views.has_tof(1, 0) || the_views.get_internal_probabilities(1, 0)[0] != 0.2,
+                  std::logic_error, "Wrong 'e2'-'g1' internal probability !");
+      const snemo::datamodel::gamma_measurement_views::range e1_g2 = the_views.get_internal_probabilities(0, 1);
+      DT_THROW_IF(e1_g2.size() != 2 || e1_g2[1] != 0.35, std::logic_error, "Wrong 'e1'-'g2' internal probabilities !");
+      DT_THROW_IF(the_views.get_external_probabilities(0, 1)[0] != 0.7, std::logic_error,
+                  "Wrong 'e1'-'g2' external probability !");
+      DT_THROW_IF(the_views.has_tof(1, 1) || ! the_views.get_internal_probabilities(1, 1).empty(),
+                  std::logic_error, "Unexpected 'e2'-'g2' TOF !");
+    }
+
+    // A copy builds its own views :
+    const snemo::datamodel::topology_2eNg_pattern a_copy(a_2eNg_pattern);
+
+    // Changed measurements are gathered again :
+    add_energy(a_2eNg_pattern, "g2", 0.4 * CLHEP::MeV);
+    add_tof(a_2eNg_pattern, "e2_g2", {0.6}, {0.4});
+    {
+      const snemo::datamodel::gamma_measurement_views & the_views = a_2eNg_pattern.get_gamma_views();
+      DT_THROW_IF(the_views.get_energies()[1] != 0.4 * CLHEP::MeV, std::logic_error, "Stale energy of 'g2' !");
+      DT_THROW_IF(! the_views.has_tof(1, 1) || the_views.get_internal_probabilities(1, 1)[0] != 0.6,
+                  std::logic_error, "Stale 'e2'-'g2' TOF !");
+      snemo::datamodel::topology_2eNg_pattern::energy_collection_type g_energies;
+      a_2eNg_pattern.fetch_gammas_energies(g_energies);
+      DT_THROW_IF(g_energies.size() != 2 || g_energies[1] != 0.4 * CLHEP::MeV, std::logic_error,
+                  "Wrong fetched gamma energies !");
+    }
+    DT_THROW_IF(a_copy.get_gamma_views().get_energies()[1] != 0.3 * CLHEP::MeV, std::logic_error,
+                "Wrong energy of 'g2' in the copy !");
+    DT_THROW_IF(a_copy.get_gamma_views().has_tof(1, 1), std::logic_error, "Unexpected 'e2'-'g2' TOF in the copy !");
+
+    // One electron and one gamma, built on first call :
+    snemo::datamodel::topology_1eNg_pattern a_1eNg_pattern;
+    a_1eNg_pattern.set_number_of_gammas(1);
+    add_energy(a_1eNg_pattern, "g1", 1.2 * CLHEP::MeV);
+    add_tof(a_1eNg_pattern, "e1_g1", {0.05}, {0.95});
+    DT_THROW_IF(a_1eNg_pattern.get_gamma_views().get_energies()[0] != 1.2 * CLHEP::MeV, std::logic_error,
+                "Wrong energy of 'g1' !");
+    add_energy(a_1eNg_pattern, "g1", 1.1 * CLHEP::MeV);
+    DT_THROW_IF(a_1eNg_pattern.get_gamma_views().get_energies()[0] != 1.1 * CLHEP::MeV, std::logic_error,
+                "Stale energy of 'g1' !");
+    snemo::datamodel::topology_1eNg_pattern::tof_collection_type eg_pint;
+    a_1eNg_pattern.fetch_electron_gammas_internal_probabilities(eg_pint);
+    DT_THROW_IF(eg_pint.size() != 1 || eg_pint.front().front() != 0.05, std::logic_error,
+                "Wrong fetched internal probabilities !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
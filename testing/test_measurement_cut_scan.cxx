@@ -0,0 +1,98 @@
+// test_measurement_cut_scan.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/properties.h>
+#include <bayeux/datatools/utils.h>
+
+// This project:
+#include <falaise/snemo/datamodels/energy_measurement.h>
+#include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/cuts/energy_measurement_cut.h>
+#include <falaise/snemo/cuts/measurement_cut_scan.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'measurement_cut_scan' class." << std::endl;
+
+    // Energies of the events, the last one being invalid :
+    std::vector<snemo::datamodel::energy_measurement> energies(8);
+    for (size_t i = 0; i + 1 < energies.size(); i++) {
+      energies[i].set_energy((150 + 200 * i) * CLHEP::keV);
+    }
+    energies.back().set_energy(datatools::invalid_real());
+
+    snemo::cut::measurement_cut_scan ES;
+    datatools::properties ES_config;
+    ES_config.store("measurement_label", "energy_e1");
+    ES_config.store("quantity", "energy");
+    ES_config.store_real_with_explicit_unit("min.first", 0 * CLHEP::keV);
+    ES_config.store_real_with_explicit_unit("min.last", 1000 * CLHEP::keV);
+    ES_config.store("min.points", 6);
+    ES_config.store_real_with_explicit_unit("max", 1200 * CLHEP::keV);
+    ES.initialize(ES_config);
+    for (const auto& a_energy : energies) {
+      ES.fill_measurement(&a_energy);
+    }
+    ES.fill_measurement(nullptr);
+    ES.print(std::clog);
+    DT_THROW_IF(ES.get_grid().size() != 6, std::logic_error, "Wrong number of grid points !");
+    DT_THROW_IF(ES.get_number_of_events() != energies.size() + 1, std::logic_error, "Wrong number of events !");
+
+    // Every grid point must count as the equivalent energy cut :
+    for (const auto& a_point : ES.get_grid()) {
+      snemo::cut::energy_measurement_cut EMC;
+      datatools::properties EMC_config;
+      EMC_config.store("mode.range_energy", true);
+      EMC_config.store_real_with_explicit_unit("range_energy.min", a_point.min);
+      EMC_config.store_real_with_explicit_unit("range_energy.max", a_point.max);
+      EMC.initialize_standalone(EMC_config);
+      size_t accepted = 0, rejected = 0, inapplicable = 1;
+      for (const auto& a_energy : energies) {
+        EMC.set_user_data(a_energy);
+        const int status = EMC.process();
+        if (status == cuts::SELECTION_ACCEPTED) accepted++;
+        else if (status == cuts::SELECTION_REJECTED) rejected++;
+        else inapplicable++;
+      }
+      DT_THROW_IF(accepted != a_point.accepted || rejected != a_point.rejected
+                  || inapplicable != a_point.inapplicable, std::logic_error,
+                  "Scan differs from the energy cut for min = " << a_point.min / CLHEP::keV << " keV !");
+    }
+
+    // Scan of the internal TOF probabilities :
+    snemo::datamodel::tof_measurement TM;
+    TM.get_internal_probabilities() = {2 * CLHEP::perCent, 30 * CLHEP::perCent};
+    snemo::cut::measurement_cut_scan TS;
+    datatools::properties TS_config;
+    TS_config.store("measurement_label", "tof_e1_e2");
+    TS_config.store("quantity", "internal_probability");
+    TS_config.store("min", std::vector<double>({1.0, 5.0}));
+    TS.initialize(TS_config);
+    TS.fill_measurement(&TM);
+    TS.fill_measurement(&energies.front());
+    TS.print(std::clog);
+    DT_THROW_IF(TS.get_grid()[0].accepted != 1 || TS.get_grid()[1].rejected != 1,
+                std::logic_error, "Wrong internal probability scan !");
+    DT_THROW_IF(TS.get_grid()[0].inapplicable != 1, std::logic_error,
+                "Measurement of another type must be inapplicable !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,88 @@
+// test_selection_bitmap.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/i_cut.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/selection_bitmap.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'selection_bitmap' classes." << std::endl;
+
+    // Sparse and dense chunks, over several chunks
+    const uint64_t n_records = 200000;
+    snemo::reconstruction::selection_bitmap multiples_of_2, multiples_of_3;
+    for (uint64_t i = 0; i < n_records; i += 2) multiples_of_2.add(i);
+    for (uint64_t i = n_records - n_records % 3; i > 0; i -= 3) multiples_of_3.add(i);
+    multiples_of_3.add(0);
+    DT_THROW_IF(multiples_of_2.cardinality() != n_records / 2, std::logic_error, "Wrong cardinality !");
+    DT_THROW_IF(! multiples_of_3.contains(99999) || multiples_of_3.contains(100000), std::logic_error,
+                "Wrong content !");
+
+    snemo::reconstruction::selection_bitmap both = multiples_of_2;
+    both.intersect_with(multiples_of_3);
+    snemo::reconstruction::selection_bitmap any = multiples_of_2;
+    any.unite_with(multiples_of_3);
+    snemo::reconstruction::selection_bitmap none = snemo::reconstruction::selection_bitmap::make_range(n_records);
+    none.subtract(any);
+    std::vector<uint64_t> records;
+    none.get_records(records);
+    for (const auto& a_record : records) {
+      DT_THROW_IF(a_record % 2 == 0 || a_record % 3 == 0, std::logic_error,
+                  "Record #" << a_record << " should not be selected !");
+    }
+    DT_THROW_IF(none.cardinality() + any.cardinality() != n_records, std::logic_error, "Wrong set operations !");
+    std::clog << "Multiples of 6 : " << both.cardinality() << ", of 2 or 3 : " << any.cardinality()
+              << ", others : " << none.cardinality() << std::endl;
+
+    // Sets of selections, stored and queried
+    snemo::reconstruction::selection_bitmap_set selections;
+    selections.set_names({"2e::channel_cut", "energy"});
+    for (uint64_t i = 0; i < 1000; i++) {
+      selections.add(i, 0, i % 2 == 0 ? cuts::SELECTION_ACCEPTED : cuts::SELECTION_REJECTED);
+      if (i % 3 == 0) selections.add(i, 1, cuts::SELECTION_ACCEPTED);
+      else if (i % 3 == 1) selections.add(i, 1, cuts::SELECTION_REJECTED);
+      else selections.add(i, 1, cuts::SELECTION_INAPPLICABLE);
+    }
+    const std::string filename = "test_selection_bitmap.sel";
+    selections.store(filename);
+    snemo::reconstruction::selection_bitmap_set loaded;
+    loaded.load(filename);
+    loaded.append(selections);
+    DT_THROW_IF(loaded.get_number_of_records() != 2000, std::logic_error, "Wrong number of records !");
+
+    snemo::reconstruction::selection_bitmap result;
+    loaded.evaluate("2e::channel_cut & !(energy | inapplicable(energy))", result);
+    result.get_records(records);
+    for (const auto& a_record : records) {
+      // Appended records are numbered after the 1000 loaded ones
+      const uint64_t i = a_record % 1000;
+      DT_THROW_IF(i % 2 != 0 || i % 3 != 1, std::logic_error,
+                  "Record #" << a_record << " should not be selected !");
+    }
+    DT_THROW_IF(records.size() != 2 * 166, std::logic_error, "Wrong number of selected records !");
+    loaded.evaluate("rejected(energy) | all", result);
+    DT_THROW_IF(result.cardinality() != 2000, std::logic_error, "Wrong 'all' selection !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,73 @@
+// test_spsc_queue.cxx
+//
+// A producer thread hands values off to a consumer thread through a small
+// queue: every value must come out once and in order, the producer being
+// held back while the queue is full. Meant to be run under the thread
+// sanitizer as well.
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+
+// This project:
+#include <falaise/snemo/reconstruction/spsc_queue.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'spsc_queue' class." << std::endl;
+
+    snemo::reconstruction::spsc_queue<std::unique_ptr<size_t> > queue(5);
+    DT_THROW_IF(queue.capacity() != 8, std::logic_error, "Wrong queue capacity !");
+
+    // Backpressure on a single thread :
+    for (size_t i = 0; i < queue.capacity(); i++) {
+      DT_THROW_IF(! queue.try_push(std::unique_ptr<size_t>(new size_t(i))), std::logic_error,
+                  "Queue is full too early !");
+    }
+    DT_THROW_IF(queue.try_push(std::unique_ptr<size_t>(new size_t(0))), std::logic_error,
+                "Queue must be full !");
+    std::unique_ptr<size_t> a_value;
+    for (size_t i = 0; i < queue.capacity(); i++) {
+      DT_THROW_IF(! queue.try_pop(a_value) || *a_value != i, std::logic_error, "Wrong queue order !");
+    }
+    DT_THROW_IF(queue.try_pop(a_value), std::logic_error, "Queue must be empty !");
+
+    // Hand-off between two threads :
+    const size_t nvalues = 200000;
+    size_t producer_waits = 0;
+    std::thread producer([&] {
+        for (size_t i = 1; i <= nvalues; i++) {
+          if (queue.push(std::unique_ptr<size_t>(new size_t(i)))) producer_waits++;
+        }
+        queue.push(std::unique_ptr<size_t>());
+      });
+    size_t expected = 1;
+    size_t consumer_waits = 0;
+    bool ordered = true;
+    for (;;) {
+      if (queue.pop(a_value)) consumer_waits++;
+      if (! a_value) break;
+      if (*a_value != expected) ordered = false;
+      expected++;
+    }
+    producer.join();
+    std::clog << "Producer waits : " << producer_waits << ", consumer waits : " << consumer_waits << std::endl;
+    DT_THROW_IF(! ordered, std::logic_error, "Values are not received in order !");
+    DT_THROW_IF(expected != nvalues + 1, std::logic_error, "Missing values !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
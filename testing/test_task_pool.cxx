@@ -0,0 +1,90 @@
+// test_task_pool.cxx
+//
+// Batches of tasks are run by a persistent pool of threads: every task must
+// run exactly once per batch, batches issued from a parallel section must
+// stay on the calling thread and the first failure must be reported. Meant
+// to be run under the thread sanitizer as well.
+
+// Standard library:
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/reconstruction/task_pool.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'task_pool' class." << std::endl;
+
+    snemo::reconstruction::task_pool pool(4);
+    DT_THROW_IF(pool.get_number_of_threads() != 4, std::logic_error, "Wrong number of threads !");
+
+    // Many small batches, as for the gammas of successive events :
+    const size_t ntasks = 37;
+    std::unique_ptr<std::atomic<size_t>[]> runs(new std::atomic<size_t>[ntasks]);
+    for (size_t i = 0; i < ntasks; i++) runs[i] = 0;
+    const size_t nbatches = 2000;
+    for (size_t ibatch = 0; ibatch < nbatches; ibatch++) {
+      pool.run(ntasks, [&] (size_t i_) { runs[i_]++; });
+    }
+    for (size_t i = 0; i < ntasks; i++) {
+      DT_THROW_IF(runs[i] != nbatches, std::logic_error, "Task #" << i << " has been run " << runs[i] << " times !");
+    }
+
+    // Batches from a parallel section stay on the calling thread :
+    {
+      snemo::reconstruction::task_pool::parallel_section a_section;
+      const std::thread::id caller = std::this_thread::get_id();
+      std::atomic<size_t> foreign(0);
+      pool.run(ntasks, [&] (size_t) { if (std::this_thread::get_id() != caller) foreign++; });
+      DT_THROW_IF(foreign != 0, std::logic_error, "Nested batch has left the calling thread !");
+    }
+    DT_THROW_IF(snemo::reconstruction::task_pool::in_parallel_section(), std::logic_error,
+                "Parallel section has not been closed !");
+
+    // Concurrent callers share the pool, the late ones running serially :
+    std::atomic<size_t> total(0);
+    std::vector<std::thread> callers;
+    for (size_t icaller = 0; icaller < 4; icaller++) {
+      callers.push_back(std::thread([&] {
+            for (size_t ibatch = 0; ibatch < 200; ibatch++) {
+              pool.run(ntasks, [&] (size_t) { total++; });
+            }
+          }));
+    }
+    for (auto& a_caller : callers) {
+      a_caller.join();
+    }
+    DT_THROW_IF(total != 4 * 200 * ntasks, std::logic_error, "Missing tasks from concurrent callers !");
+
+    // The first failure is reported :
+    bool failed = false;
+    try {
+      pool.run(ntasks, [&] (size_t i_) { DT_THROW_IF(i_ % 10 == 3, std::runtime_error, "Task #" << i_ << " failed"); });
+    } catch (std::runtime_error & x) {
+      std::clog << "Reported failure : " << x.what() << std::endl;
+      failed = std::string(x.what()).find("Task #3 ") != std::string::npos;
+    }
+    DT_THROW_IF(! failed, std::logic_error, "Wrong reported failure !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
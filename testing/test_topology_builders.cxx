@@ -0,0 +1,84 @@
+// test_topology_builders.cxx
+//
+// The measurements made by the topology builders must be stored in the
+// pattern handed out by the topology driver, whether they are computed
+// when the pattern is built or on first access.
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/properties.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/topology_2eNg_pattern.h>
+#include <falaise/snemo/reconstruction/topology_driver.h>
+#include "particle_track_fixtures.h"
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the topology builders." << std::endl;
+
+    // A '2e1g' event :
+    snemo::datamodel::particle_track_data ptd;
+    using snemo::testing::make_electron;
+    using snemo::testing::make_gamma;
+    using snemo::testing::make_handle;
+    ptd.add_particle(make_handle(make_electron(10 * CLHEP::cm, 0, 1.6 * CLHEP::ns, 1000 * CLHEP::keV)));
+    ptd.add_particle(make_handle(make_electron(-20 * CLHEP::cm, 0, 1.4 * CLHEP::ns, 500 * CLHEP::keV)));
+    ptd.add_particle(make_handle(make_gamma(0, 0, 2 * CLHEP::ns, 300 * CLHEP::keV)));
+    ptd.grab_auxiliaries().update(snemo::datamodel::pid_utils::electron_label(), 2);
+    ptd.grab_auxiliaries().update(snemo::datamodel::pid_utils::gamma_label(), 1);
+
+    const std::vector<std::string> expected_labels = {
+      "tof_e1_e2", "vertex_e1_e2", "angle_e1_e2", "energy_e1", "energy_e2",
+      "tof_e1_g1", "tof_e2_g1", "energy_g1", "angle_e1_g1", "angle_e2_g1"
+    };
+
+    for (const bool lazy : {false, true}) {
+      snemo::reconstruction::topology_driver TD;
+      datatools::properties TD_config;
+      TD_config.store("lazy_measurements", lazy);
+      TD.initialize(TD_config);
+      snemo::datamodel::topology_data td;
+      TD.process(ptd, td);
+      DT_THROW_IF(! td.has_pattern(), std::logic_error, "Missing pattern for a '2e1g' event !");
+      const snemo::datamodel::topology_2eNg_pattern & a_pattern
+        = dynamic_cast<const snemo::datamodel::topology_2eNg_pattern &>(td.get_pattern());
+
+      // Lazy measurements are evaluated once the driver is gone
+      TD.reset();
+      for (const auto& a_label : expected_labels) {
+        DT_THROW_IF(a_pattern.is_deferred_measurement(a_label) != lazy, std::logic_error,
+                    "Measurement '" << a_label << "' is " << (lazy ? "not " : "") << "deferred !");
+        DT_THROW_IF(a_pattern.find_measurement(a_label) == nullptr, std::logic_error,
+                    "Measurement '" << a_label << "' is not stored in the pattern !");
+      }
+      DT_THROW_IF(a_pattern.get_measurement_dictionary().size() != expected_labels.size(), std::logic_error,
+                  "Wrong number of measurements !");
+      DT_THROW_IF(! a_pattern.has_electrons_energy(), std::logic_error, "Missing electrons energy !");
+      DT_THROW_IF(a_pattern.get_minimal_energy_electron_name() != "e2", std::logic_error,
+                  "Wrong minimal energy electron !");
+      DT_THROW_IF(! a_pattern.get_gamma_views().has_energy(0), std::logic_error, "Missing gamma energy !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
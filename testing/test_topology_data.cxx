@@ -6,10 +6,38 @@
 #include <string>
 #include <exception>
 
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/things.h>
+// - Bayeux/cuts:
+#include <bayeux/cuts/cut_manager.h>
+#include <bayeux/cuts/i_cut.h>
+
 // This project:
 #include <falaise/snemo/datamodels/topology_data.h>
 #include <falaise/snemo/datamodels/topology_2e_pattern.h>
 #include <falaise/snemo/datamodels/tof_measurement.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include "cut_manager_fixtures.h"
+
+namespace {
+
+  // Two channels sharing the 'has_pattern' cut
+  const std::string cuts_definitions =
+    "#@key_label  \"name\"                                                 \n"
+    "#@meta_label \"type\"                                                 \n"
+    "[name=\"has_pattern\" type=\"snemo::cut::topology_data_cut\"]         \n"
+    "mode.has_pattern : boolean = true                                     \n"
+    "[name=\"2e::has_classification\" type=\"snemo::cut::topology_data_cut\"] \n"
+    "mode.classification : boolean = true                                  \n"
+    "classification.label : string = \"2e\"                                \n"
+    "[name=\"any\" type=\"cuts::accept_cut\"]                              \n"
+    "[name=\"A::channel_cut\" type=\"cuts::multi_and_cut\"]                \n"
+    "cuts : string[2] = \"has_pattern\" \"2e::has_classification\"         \n"
+    "[name=\"B::channel_cut\" type=\"cuts::multi_and_cut\"]                \n"
+    "cuts : string[2] = \"has_pattern\" \"any\"                            \n";
+
+}
 
 int main()
 {
@@ -37,6 +65,57 @@ int main()
     TD.get_auxiliaries().store_flag("test_td");
     TD.tree_dump(std::clog, "Topology data :");
 
+    // Memoized cut results are dropped by any change of the topology data :
+    const int a_cut = 0;
+    int status = 0;
+    TD.store_cut_result(&a_cut, nullptr, 1);
+    DT_THROW_IF(! TD.find_cut_result(&a_cut, nullptr, status) || status != 1,
+                std::logic_error, "Missing memoized cut result !");
+    DT_THROW_IF(TD.find_cut_result(&a_cut, &TD, status), std::logic_error,
+                "Unexpected memoized cut result !");
+    TD.get_auxiliaries().store_flag("test_cut_results");
+    DT_THROW_IF(TD.find_cut_result(&a_cut, nullptr, status), std::logic_error,
+                "Memoized cut result must be dropped !");
+
+    // A topology data cut shared by channels is evaluated once per event:
+    // the second channel reuses the memoized result, here overwritten with a
+    // rejection, until a non-const accessor of the topology data drops it
+    cuts::cut_manager CM;
+    snemo::testing::initialize_cut_manager(CM, cuts_definitions);
+    datatools::things ER;
+    snemo::datamodel::topology_data & eTD = ER.add<snemo::datamodel::topology_data>("TD");
+    eTD.set_pattern_handle(hP0);
+    eTD.get_auxiliaries().store(snemo::datamodel::pid_utils::classification_label_key(), std::string("2e"));
+    const snemo::datamodel::topology_data & cTD = eTD;
+    cuts::i_cut & shared_cut = CM.grab("has_pattern");
+    cuts::i_cut & channel_A = CM.grab("A::channel_cut");
+    cuts::i_cut & channel_B = CM.grab("B::channel_cut");
+
+    channel_A.set_user_data(ER);
+    DT_THROW_IF(channel_A.process() != cuts::SELECTION_ACCEPTED, std::logic_error,
+                "Channel 'A' must be accepted !");
+    channel_A.reset_user_data();
+    DT_THROW_IF(! cTD.find_cut_result(&shared_cut, &ER, status) || status != cuts::SELECTION_ACCEPTED,
+                std::logic_error, "Missing memoized result of the shared cut !");
+    cTD.store_cut_result(&shared_cut, &ER, cuts::SELECTION_REJECTED);
+
+    channel_B.set_user_data(ER);
+    DT_THROW_IF(channel_B.process() != cuts::SELECTION_REJECTED, std::logic_error,
+                "Shared cut must not be evaluated twice for the same event !");
+    channel_B.reset_user_data();
+
+    ER.grab<snemo::datamodel::topology_data>("TD").get_auxiliaries();
+    DT_THROW_IF(cTD.find_cut_result(&shared_cut, &ER, status), std::logic_error,
+                "Memoized cut results must be dropped by a non-const accessor !");
+    channel_B.set_user_data(ER);
+    DT_THROW_IF(channel_B.process() != cuts::SELECTION_ACCEPTED, std::logic_error,
+                "Shared cut must be evaluated again once its result is dropped !");
+    channel_B.reset_user_data();
+    DT_THROW_IF(! cTD.find_cut_result(&shared_cut, &ER, status) || status != cuts::SELECTION_ACCEPTED,
+                std::logic_error, "Missing memoized result of the re-evaluated shared cut !");
+
+    CM.reset();
+
   } catch (std::exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
     error_code = EXIT_FAILURE;
@@ -0,0 +1,85 @@
+// test_topology_generic_builder.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/clhep_units.h>
+#include <bayeux/datatools/properties.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track.h>
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/datamodels/topology_data.h>
+#include <falaise/snemo/datamodels/topology_generic_pattern.h>
+#include <falaise/snemo/reconstruction/topology_driver.h>
+#include "particle_track_fixtures.h"
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_generic_builder' class." << std::endl;
+
+    // A '3e1g' event :
+    snemo::datamodel::particle_track_data ptd;
+    using snemo::testing::make_electron;
+    using snemo::testing::make_gamma;
+    using snemo::testing::make_handle;
+    ptd.add_particle(make_handle(make_electron(10 * CLHEP::cm, 0, 1.6 * CLHEP::ns, 1000 * CLHEP::keV)));
+    ptd.add_particle(make_handle(make_electron(-20 * CLHEP::cm, 0, 1.4 * CLHEP::ns, 500 * CLHEP::keV)));
+    ptd.add_particle(make_handle(make_electron(30 * CLHEP::cm, 0, 1.5 * CLHEP::ns, 700 * CLHEP::keV)));
+    ptd.add_particle(make_handle(make_gamma(0, 0, 2 * CLHEP::ns, 300 * CLHEP::keV)));
+    ptd.grab_auxiliaries().update(snemo::datamodel::pid_utils::electron_label(), 3);
+    ptd.grab_auxiliaries().update(snemo::datamodel::pid_utils::gamma_label(), 1);
+
+    // Without generic topologies, only the classification is stored :
+    {
+      snemo::reconstruction::topology_driver TD;
+      TD.initialize(datatools::properties());
+      snemo::datamodel::topology_data td;
+      TD.process(ptd, td);
+      DT_THROW_IF(td.has_pattern(), std::logic_error, "Unexpected pattern for a '3e1g' event !");
+      TD.reset();
+    }
+
+    snemo::reconstruction::topology_driver TD;
+    datatools::properties TD_config;
+    TD_config.store("generic_topologies", true);
+    TD.initialize(TD_config);
+    snemo::datamodel::topology_data td;
+    TD.process(ptd, td);
+    DT_THROW_IF(! td.has_pattern(), std::logic_error, "Missing pattern for a '3e1g' event !");
+    const snemo::datamodel::topology_generic_pattern & a_pattern
+      = dynamic_cast<const snemo::datamodel::topology_generic_pattern &>(td.get_pattern());
+    a_pattern.tree_dump(std::clog, "Generic pattern:");
+
+    const std::vector<std::string> expected_labels = {"e1", "e2", "e3", "g1"};
+    DT_THROW_IF(a_pattern.get_particle_labels() != expected_labels, std::logic_error, "Wrong particle labels !");
+    DT_THROW_IF(a_pattern.get_number_of_particles('e') != 3, std::logic_error, "Wrong number of electrons !");
+    DT_THROW_IF(! a_pattern.find_energy("e3") || ! a_pattern.find_energy("g1"),
+                std::logic_error, "Missing energy measurements !");
+    DT_THROW_IF(! a_pattern.find_angle("e2"), std::logic_error, "Missing electron angle !");
+    DT_THROW_IF(a_pattern.find_angle("g1"), std::logic_error, "Unexpected gamma angle !");
+    DT_THROW_IF(! a_pattern.find_tof("e3", "e1") || ! a_pattern.find_tof("e2", "g1"),
+                std::logic_error, "Missing TOF measurements !");
+    DT_THROW_IF(! a_pattern.find_vertex("e1", "e3"), std::logic_error, "Missing vertex measurement !");
+    DT_THROW_IF(a_pattern.find_vertex("e1", "g1"), std::logic_error, "Unexpected electron-gamma vertex !");
+    DT_THROW_IF(! a_pattern.find_angle("e1", "e2") || ! a_pattern.find_angle("g1", "e3"),
+                std::logic_error, "Missing pair angles !");
+
+    TD.reset();
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
@@ -0,0 +1,114 @@
+// test_topology_scheduler.cxx
+//
+// Tasks of very skewed costs are run by the work-stealing scheduler: every
+// task must be run exactly once and the heavy tasks must not leave the
+// other workers idle. Meant to be run under the thread sanitizer as well.
+
+// Standard library:
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+
+// Third party:
+// - Bayeux/datatools:
+#include <bayeux/datatools/exception.h>
+
+// This project:
+#include <falaise/snemo/datamodels/particle_track_data.h>
+#include <falaise/snemo/datamodels/pid_utils.h>
+#include <falaise/snemo/reconstruction/topology_scheduler.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the 'topology_scheduler' class." << std::endl;
+
+    // Costs estimated from the PID counts :
+    snemo::datamodel::particle_track_data a_1e;
+    a_1e.grab_auxiliaries().update_integer(snemo::datamodel::pid_utils::electron_label(), 1);
+    snemo::datamodel::particle_track_data a_2e3g;
+    a_2e3g.grab_auxiliaries().update_integer(snemo::datamodel::pid_utils::electron_label(), 2);
+    a_2e3g.grab_auxiliaries().update_integer(snemo::datamodel::pid_utils::gamma_label(), 3);
+    const double cost_1e = snemo::reconstruction::topology_scheduler::estimate_cost(a_1e);
+    const double cost_2e3g = snemo::reconstruction::topology_scheduler::estimate_cost(a_2e3g);
+    std::clog << "Estimated costs : 1e = " << cost_1e << ", 2e3g = " << cost_2e3g << std::endl;
+    DT_THROW_IF(cost_1e != 2 || cost_2e3g != 36, std::logic_error, "Wrong estimated costs !");
+
+    // Skewed tasks, the heavy ones being gathered at the end :
+    const size_t ntasks = 400;
+    std::vector<double> costs(ntasks, cost_1e);
+    for (size_t i = ntasks - 20; i < ntasks; i++) costs[i] = cost_2e3g;
+    std::unique_ptr<std::atomic<size_t>[]> runs(new std::atomic<size_t>[ntasks]);
+    for (size_t i = 0; i < ntasks; i++) runs[i] = 0;
+
+    snemo::reconstruction::topology_scheduler scheduler;
+    scheduler.set_number_of_workers(4);
+    for (size_t ipass = 0; ipass < 3; ipass++) {
+      scheduler.run(costs, [&] (size_t i_)
+                    {
+                      runs[i_]++;
+                      std::this_thread::sleep_for(std::chrono::microseconds(int(50 * costs[i_])));
+                    });
+    }
+    scheduler.print_report(std::clog);
+
+    size_t nevents = 0;
+    for (const auto& a_report : scheduler.get_reports()) {
+      nevents += a_report.events;
+    }
+    DT_THROW_IF(nevents != 3 * ntasks, std::logic_error, "Wrong number of processed events !");
+    for (size_t i = 0; i < ntasks; i++) {
+      DT_THROW_IF(runs[i] != 3, std::logic_error, "Task #" << i << " has been run " << runs[i] << " times !");
+    }
+
+    // A batch smaller than the pool only involves some of the workers :
+    std::vector<double> wall_times;
+    for (const auto& a_report : scheduler.get_reports()) {
+      wall_times.push_back(a_report.wall_seconds);
+    }
+    scheduler.run(std::vector<double>(2, cost_1e), [&] (size_t)
+                  {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                  });
+    const std::vector<snemo::reconstruction::topology_scheduler::worker_report> & reports
+      = scheduler.get_reports();
+    DT_THROW_IF(reports.size() != 4, std::logic_error, "Wrong number of worker reports !");
+    DT_THROW_IF(reports[0].wall_seconds == wall_times[0] || reports[1].wall_seconds == wall_times[1],
+                std::logic_error, "Missing wall time of the batch workers !");
+    DT_THROW_IF(reports[2].wall_seconds != wall_times[2] || reports[3].wall_seconds != wall_times[3],
+                std::logic_error, "Idle workers must not account for the batch !");
+
+    // The first failure is reported once all the tasks are done :
+    bool failed = false;
+    for (size_t i = 0; i < ntasks; i++) runs[i] = 0;
+    try {
+      scheduler.run(costs, [&] (size_t i_)
+                    {
+                      runs[i_]++;
+                      DT_THROW_IF(i_ % 100 == 7, std::runtime_error, "Task #" << i_ << " failed");
+                    });
+    } catch (std::runtime_error & x) {
+      std::clog << "Reported failure : " << x.what() << std::endl;
+      failed = std::string(x.what()).find("Task #7 ") != std::string::npos;
+    }
+    DT_THROW_IF(! failed, std::logic_error, "Wrong reported failure !");
+    for (size_t i = 0; i < ntasks; i++) {
+      DT_THROW_IF(runs[i] != 1, std::logic_error, "Task #" << i << " has not been run !");
+    }
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
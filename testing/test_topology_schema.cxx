@@ -0,0 +1,57 @@
+// test_topology_schema.cxx
+
+// Standard library:
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+// This project:
+#include <falaise/snemo/datamodels/topology_1e1p_pattern.h>
+#include <falaise/snemo/datamodels/topology_schema.h>
+
+int main()
+{
+  int error_code = EXIT_SUCCESS;
+  try {
+    std::clog << "Test program for the topology schemas." << std::endl;
+
+    namespace sdm = snemo::datamodel;
+    typedef sdm::topology_1e1p_pattern::schema_type schema_type;
+    typedef sdm::schema::tof<sdm::schema::e1, sdm::schema::p1> tof_e1_p1;
+    typedef sdm::schema::energy<sdm::schema::p1> energy_p1;
+
+    // Labels generated from the schema :
+    DT_THROW_IF(tof_e1_p1::label() != "tof_e1_p1", std::logic_error, "Wrong label '" << tof_e1_p1::label() << "' !");
+    DT_THROW_IF(sdm::schema::angle<sdm::schema::e1>::label() != "angle_e1", std::logic_error, "Wrong angle label !");
+    DT_THROW_IF(schema_type::particles::labels().size() != 2, std::logic_error, "Wrong number of particles !");
+    static_assert(schema_type::measurements::slot<sdm::schema::angle<sdm::schema::e1> >::index == 0,
+                  "Wrong slot index");
+
+    // Slots resolved from the measurements of a pattern :
+    sdm::topology_1e1p_pattern a_pattern;
+    sdm::energy_measurement * an_energy = new sdm::energy_measurement;
+    an_energy->set_energy(1.0);
+    a_pattern.get_measurement_dictionary()[energy_p1::label()].reset(an_energy);
+    // A measurement of the wrong type is ignored
+    a_pattern.get_measurement_dictionary()[tof_e1_p1::label()].reset(new sdm::energy_measurement);
+
+    sdm::schema::measurement_slots<schema_type> the_slots;
+    the_slots.resolve(a_pattern);
+    DT_THROW_IF(! the_slots.has<energy_p1>(), std::logic_error, "Missing positron energy !");
+    DT_THROW_IF(the_slots.get<energy_p1>().get_energy() != 1.0, std::logic_error, "Wrong positron energy !");
+    DT_THROW_IF(the_slots.has<tof_e1_p1>(), std::logic_error, "Unexpected TOF measurement !");
+
+    a_pattern.finalize();
+    DT_THROW_IF(! a_pattern.has_positron_energy(), std::logic_error, "Missing positron energy !");
+    DT_THROW_IF(a_pattern.has_electron_positron_internal_probability(), std::logic_error, "Unexpected TOF measurement !");
+
+  } catch (std::exception & x) {
+    std::cerr << "error: " << x.what() << std::endl;
+    error_code = EXIT_FAILURE;
+  } catch (...) {
+    std::cerr << "error: " << "unexpected error !" << std::endl;
+    error_code = EXIT_FAILURE;
+  }
+  return error_code;
+}
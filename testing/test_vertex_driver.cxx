@@ -1,9 +1,11 @@
 // test_vertex_driver.cxx
 
 // Standard library:
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <exception>
 
 // This project:
@@ -11,6 +13,24 @@
 #include <falaise/snemo/datamodels/pid_utils.h>
 #include <falaise/snemo/datamodels/vertex_measurement.h>
 #include <falaise/snemo/reconstruction/vertex_driver.h>
+#include "particle_track_fixtures.h"
+
+namespace {
+
+  /// Make electrons with a single vertex on the source foil, one per position
+  std::vector<snemo::datamodel::particle_track> make_foil_electrons(const std::vector<geomtools::vector_3d> & positions_)
+  {
+    std::vector<snemo::datamodel::particle_track> electrons(positions_.size());
+    for (size_t i = 0; i < positions_.size(); i++) {
+      electrons[i].grab_auxiliaries().update(snemo::datamodel::pid_utils::pid_label_key(),
+                                             snemo::datamodel::pid_utils::electron_label());
+      snemo::testing::add_vertex(electrons[i], positions_[i],
+                                 snemo::datamodel::particle_track::vertex_on_source_foil_label());
+    }
+    return electrons;
+  }
+
+}
 
 int main()
 {
@@ -65,6 +85,62 @@ int main()
       std::clog << "Vertices probability = " << vertices_probability/CLHEP::perCent << "%" << std::endl;
     }
 
+    // Fake electron tracks from several vertices :
+    {
+      const std::vector<geomtools::vector_3d> positions = {
+        geomtools::vector_3d(0, 0, 0),
+        geomtools::vector_3d(0, 2*CLHEP::mm, 7*CLHEP::mm),
+        geomtools::vector_3d(0, 500*CLHEP::mm, -300*CLHEP::mm),
+        geomtools::vector_3d(0, 501*CLHEP::mm, -303*CLHEP::mm),
+        geomtools::vector_3d(0, -900*CLHEP::mm, 1000*CLHEP::mm)
+      };
+      const std::vector<snemo::datamodel::particle_track> electrons = make_foil_electrons(positions);
+      std::vector<const snemo::datamodel::particle_track *> tracks;
+      for (const auto& an_electron : electrons) {
+        tracks.push_back(&an_electron);
+      }
+
+      std::vector<snemo::datamodel::vertex_measurement> VMs;
+      VD.process(tracks, VMs);
+      for (const auto& a_vm : VMs) {
+        a_vm.tree_dump(std::clog, "Common vertex:");
+      }
+      DT_THROW_IF(VMs.size() != 2, std::logic_error,
+                  "Expected 2 common vertices, found " << VMs.size() << " !");
+      std::vector<int> tracks_0;
+      VMs[0].get_auxiliaries().fetch("tracks", tracks_0);
+      DT_THROW_IF(tracks_0 != std::vector<int>({0, 1}), std::logic_error,
+                  "First common vertex should be shared by tracks 0 and 1 !");
+    }
+
+    // Chain of vertices A-B-C where A-B and B-C are compatible but not A-C :
+    {
+      const std::vector<geomtools::vector_3d> positions = {
+        geomtools::vector_3d(0, 0, 0),
+        geomtools::vector_3d(0, 8*CLHEP::mm, 0),
+        geomtools::vector_3d(0, 16*CLHEP::mm, 0)
+      };
+      const std::vector<snemo::datamodel::particle_track> electrons = make_foil_electrons(positions);
+      std::vector<const snemo::datamodel::particle_track *> tracks;
+      for (const auto& an_electron : electrons) {
+        tracks.push_back(&an_electron);
+      }
+
+      std::vector<snemo::datamodel::vertex_measurement> VMs;
+      VD.process(tracks, VMs);
+      for (const auto& a_vm : VMs) {
+        a_vm.tree_dump(std::clog, "Common vertex:");
+      }
+      DT_THROW_IF(VMs.size() != 1, std::logic_error,
+                  "Expected 1 common vertex from the chain, found " << VMs.size() << " !");
+      std::vector<int> tracks_0;
+      VMs[0].get_auxiliaries().fetch("tracks", tracks_0);
+      DT_THROW_IF(tracks_0.size() != 2, std::logic_error,
+                  "Chained vertices A and C must not share a common vertex !");
+      DT_THROW_IF(std::find(tracks_0.begin(), tracks_0.end(), 1) == tracks_0.end(), std::logic_error,
+                  "Middle vertex B must belong to the common vertex !");
+    }
+
   } catch (std::exception & x) {
     std::cerr << "error: " << x.what() << std::endl;
     error_code = EXIT_FAILURE;